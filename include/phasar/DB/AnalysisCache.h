@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DB_ANALYSISCACHE_H_
+#define PHASAR_DB_ANALYSISCACHE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace llvm {
+class Module;
+} // namespace llvm
+
+namespace psr {
+
+class PointsToGraph;
+
+/**
+ * Results are stored in one file per module and kind of result, named after a
+ * hash of the module's content. Hence, an entry is found again as long as the
+ * module does not change and is simply not looked at anymore as soon as it
+ * does. Values are identified relative to the function they are used in,
+ * rather than by the ids annotated by the ValueAnnotationPass, as those depend
+ * on the other modules of the project.
+ *
+ * Only the intra-procedural points-to graphs are cached. The call graph
+ * depends on all modules and the entry points at once and is still
+ * constructed on every run.
+ *
+ * @brief A file-based cache for analysis results of unchanged modules, that
+ * does not need a database server.
+ */
+class AnalysisCache {
+private:
+  std::string CacheDirectory;
+  std::string Configuration;
+
+  std::string getEntryPath(const std::string &ModuleHash,
+                           const std::string &Extension) const;
+
+public:
+  /**
+   * The configuration describes everything besides a module that the cached
+   * results depend on, e.g. the alias analyses a points-to graph has been
+   * constructed with. Entries are only found by a cache of the same
+   * configuration.
+   *
+   * @brief Uses the given directory, which is created if it does not exist.
+   */
+  AnalysisCache(const std::string &CacheDirectory,
+                const std::string &Configuration);
+
+  /**
+   * As the hash covers the annotated ids as well, it has to be computed before
+   * the ValueAnnotationPass runs.
+   *
+   * @brief Returns a hash of the content of the given module, the cache's
+   * configuration and the version of the entry format, which entries of the
+   * module are stored under.
+   */
+  std::string getModuleHash(const llvm::Module &M) const;
+
+  /**
+   * Points-to graphs of functions that are not found in the entry have to be
+   * constructed by the caller.
+   *
+   * @brief Restores the intra-procedural points-to graphs of the functions
+   * defined in M into PTGs.
+   * @return False, if there is no valid entry for the given module hash.
+   */
+  bool loadPointsToGraphs(
+      const llvm::Module &M, const std::string &ModuleHash,
+      std::map<std::string, std::unique_ptr<PointsToGraph>> &PTGs) const;
+
+  /**
+   * Points-to graphs that do not belong to the function defined in M, e.g.
+   * because a linkonce function has been defined by another module first, are
+   * skipped. Failures to write the entry are logged and otherwise ignored.
+   *
+   * @brief Stores the intra-procedural points-to graphs of the functions
+   * defined in M.
+   */
+  void storePointsToGraphs(
+      const llvm::Module &M, const std::string &ModuleHash,
+      const std::map<std::string, const PointsToGraph *> &PTGs) const;
+};
+
+} // namespace psr
+
+#endif
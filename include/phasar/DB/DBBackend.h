@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DB_DBBACKEND_H_
+#define PHASAR_DB_DBBACKEND_H_
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace psr {
+
+/**
+ * @brief Thrown by a DBBackend if a statement cannot be executed.
+ */
+class DBException : public std::runtime_error {
+private:
+  int ErrorCode;
+  std::string SQLState;
+
+public:
+  DBException(const std::string &What, int ErrorCode,
+              const std::string &SQLState)
+      : std::runtime_error(What), ErrorCode(ErrorCode), SQLState(SQLState) {}
+  int getErrorCode() const { return ErrorCode; }
+  const std::string &getSQLState() const { return SQLState; }
+};
+
+/**
+ * Columns are numbered from 1 on. A result set must not outlive the
+ * statement that has produced it.
+ *
+ * @brief The rows returned by a query.
+ */
+class DBResultSet {
+public:
+  virtual ~DBResultSet() = default;
+
+  /// Advances to the next row and returns false if there is none.
+  virtual bool next() = 0;
+
+  /// Returns the index of the column with the given label.
+  virtual unsigned findColumn(const std::string &ColumnLabel) = 0;
+
+  virtual int getInt(unsigned ColumnIndex) = 0;
+  virtual bool getBoolean(unsigned ColumnIndex) = 0;
+  virtual std::string getString(unsigned ColumnIndex) = 0;
+  virtual std::string getBlob(unsigned ColumnIndex) = 0;
+
+  int getInt(const std::string &ColumnLabel) {
+    return getInt(findColumn(ColumnLabel));
+  }
+  bool getBoolean(const std::string &ColumnLabel) {
+    return getBoolean(findColumn(ColumnLabel));
+  }
+  std::string getString(const std::string &ColumnLabel) {
+    return getString(findColumn(ColumnLabel));
+  }
+  std::string getBlob(const std::string &ColumnLabel) {
+    return getBlob(findColumn(ColumnLabel));
+  }
+};
+
+/**
+ * Parameters are numbered from 1 on.
+ *
+ * @brief A prepared statement of a DBBackend.
+ */
+class DBStatement {
+public:
+  virtual ~DBStatement() = default;
+
+  virtual void setInt(unsigned ParameterIndex, int Value) = 0;
+  virtual void setBoolean(unsigned ParameterIndex, bool Value) = 0;
+  virtual void setString(unsigned ParameterIndex, const std::string &Value) = 0;
+  virtual void setBlob(unsigned ParameterIndex, const std::string &Value) = 0;
+  virtual void setNull(unsigned ParameterIndex) = 0;
+
+  /// Executes an insert, update or delete and returns the affected rows.
+  virtual int executeUpdate() = 0;
+
+  virtual std::unique_ptr<DBResultSet> executeQuery() = 0;
+};
+
+/**
+ * DBConn stores its data by means of the statements of a backend. Queries
+ * are restricted to the SQL that is understood by all backends, whereas the
+ * schema is created by each backend on its own.
+ *
+ * @brief The database DBConn is working on.
+ */
+class DBBackend {
+public:
+  virtual ~DBBackend() = default;
+
+  /// Returns the name of the database, e.g. its schema or file.
+  virtual std::string getName() const = 0;
+
+  /// @throws DBException if the statement cannot be prepared.
+  virtual std::unique_ptr<DBStatement>
+  prepareStatement(const std::string &SQL) = 0;
+
+  virtual void beginTransaction() = 0;
+  virtual void commit() = 0;
+  virtual void rollback() = 0;
+
+  virtual bool schemeExists() = 0;
+  virtual void buildScheme() = 0;
+  virtual void dropScheme() = 0;
+};
+
+} // namespace psr
+
+#endif
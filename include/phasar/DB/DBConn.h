@@ -29,12 +29,10 @@
 #include <phasar/PhasarLLVM/IfdsIde/IDESummary.h>
 #include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
 #include <phasar/PhasarLLVM/Pointer/PointsToGraph.h>
+#include <phasar/DB/DBBackend.h>
 // If ProjectIRDB is no more returned, forward declare it and remove this
 #include <phasar/DB/ProjectIRDB.h>
 
-#include <mysql_connection.h>
-#include <sqlite3.h>
-
 namespace llvm {
 class GlobalVariable;
 class LLVMContext;
@@ -49,23 +47,29 @@ enum class QueryReturnCode { DBTrue, DBFalse, DBError };
   std::cout << "# ERR: SQLException in " << __FILE__;                          \
   std::cout << "(" << __FUNCTION__ << ") on line " << __LINE__ << std::endl;   \
   std::cout << "# ERR: " << e.what();                                          \
-  std::cout << " (MySQL error code: " << e.getErrorCode();                     \
+  std::cout << " (error code: " << e.getErrorCode();                           \
   std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
 
 // forward declarations
 class VTable;
 
+/**
+ * Data is stored by means of a DBBackend. Unless another backend is set,
+ * DBConn connects to the MySQL server at db_server_address on first use.
+ *
+ * @brief Stores and loads the data of analyses to and from a database.
+ */
 class DBConn {
 private:
   DBConn();
   ~DBConn();
-  sql::Driver *driver;
-  sql::Connection *conn;
+  std::unique_ptr<DBBackend> backend;
   const static std::string db_user;
   const static std::string db_password;
   const static std::string db_schema_name;
   const static std::string db_server_address;
   // Functions for internal use only
+  DBBackend *conn();
   int getNextAvailableID(const std::string &TableName);
   int getProjectID(const std::string &Identifier);
   int getModuleID(const std::string &Identifier);
@@ -82,10 +86,10 @@ private:
   std::set<int> getAllTypeHierarchyIDs();
   std::set<int> getAllModuleIDsFromTH(const unsigned typeHierarchyID);
 
-  bool schemeExists();
-  void buildDBScheme();
   void dropDBAndRebuildScheme();
 
+  // The insert functions rethrow a DBException after reporting it, such that
+  // the transaction they are called in is rolled back
   bool insertModule(const std::string &ProjectIdentifier,
                     const llvm::Module *module);
   std::unique_ptr<llvm::Module> getModule(const std::string &mod_name,
@@ -107,6 +111,20 @@ public:
   static DBConn &getInstance();
   std::string getDBName();
 
+  /**
+   * Replaces the backend that is used from now on, e.g. by a SQLiteBackend to
+   * work without a database server:
+   *
+   *    DBConn::getInstance().setBackend(
+   *        std::make_unique<SQLiteBackend>("phasar.sqlite"));
+   *
+   * Without a backend, DBConn connects to the MySQL server again on next use.
+   *
+   * @brief Sets the backend data is stored to and loaded from.
+   * @return The backend that has been used so far, if any.
+   */
+  std::unique_ptr<DBBackend> setBackend(std::unique_ptr<DBBackend> Backend);
+
   void storeProjectIRDB(const std::string &ProjectName,
                         const ProjectIRDB &IRDB);
   // We may want to pass an empty ProjectIRDB and do not return anything in
@@ -11,12 +11,10 @@
 #define PHASAR_DB_HEXASTORE_H_
 
 #include <array>
-#include <iosfwd>
+#include <ostream>
 #include <string>
 #include <vector>
 
-#include <boost/format.hpp>
-
 #include <sqlite3.h>
 
 #include <phasar/DB/Queries.h>
@@ -68,17 +66,25 @@ struct hs_result {
 class Hexastore {
 private:
   sqlite3 *hs_internal_db;
-  static int callback(void *NotUsed, int argc, char **argv, char **azColName);
-  void doPut(std::string query, std::array<std::string, 3> edge);
+  /// Prepared statements of the six insert queries
+  std::vector<sqlite3_stmt *> insert_stmts;
+  /// Prepared statements of the eight search queries, indexed by which of the
+  /// three elements are fixed (bit 2: subject, bit 1: predicate, bit 0: object)
+  std::array<sqlite3_stmt *, 8> search_stmts{};
+  bool exec(const std::string &query);
+  void prepare(const std::string &query, std::vector<sqlite3_stmt *> &stmts);
+  bool doPut(const std::array<std::string, 3> &edge);
 
 public:
   /**
    * If the given filename matches an already created Hexastore, no
    * new Hexastore will be created. Instead the already created Hexastore
-   * will be used.
+   * will be used. All queries are prepared once when the Hexastore is
+   * constructed.
    *
    * @brief Constructs a Hexastore under the given filename.
    * @param filename Filename of the Hexastore.
+   * @throws std::runtime_error if the database cannot be opened.
    */
   Hexastore(std::string filename);
 
@@ -87,6 +93,9 @@ public:
    */
   ~Hexastore();
 
+  Hexastore(const Hexastore &) = delete;
+  Hexastore &operator=(const Hexastore &) = delete;
+
   /**
    * Adds the given tuple as a new entry to the Hexastore. It is not
    * possible to have duplicate entries in the Hexastore and
@@ -100,6 +109,16 @@ public:
    */
   void put(std::array<std::string, 3> edge);
 
+  /**
+   * All entries are inserted within a single transaction, which is
+   * considerably faster than putting them one by one. If one of them cannot
+   * be inserted, none of them is.
+   *
+   * @brief Creates a new entry in the Hexastore for each of the given tuples.
+   * @param edges New entries in the form of 3-tuples.
+   */
+  void putAll(const std::vector<std::array<std::string, 3>> &edges);
+
   /**
    * A query is always in the form of a 3-tuple (source, edge, destination)
    * where
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DB_MYSQLBACKEND_H_
+#define PHASAR_DB_MYSQLBACKEND_H_
+
+#include <string>
+
+#include <phasar/DB/DBBackend.h>
+
+namespace sql {
+class Connection;
+class Driver;
+} // namespace sql
+
+namespace psr {
+
+/**
+ * @brief A DBBackend that connects to a MySQL server.
+ */
+class MySQLBackend : public DBBackend {
+private:
+  sql::Driver *driver;
+  sql::Connection *conn;
+  std::string schema_name;
+
+public:
+  /**
+   * Connects to the given server and selects the given schema. The schema
+   * is created if it does not exist yet.
+   *
+   * @throws DBException if the connection cannot be established.
+   */
+  MySQLBackend(const std::string &server_address, const std::string &user,
+               const std::string &password, const std::string &schema_name);
+
+  ~MySQLBackend() override;
+
+  MySQLBackend(const MySQLBackend &) = delete;
+  MySQLBackend &operator=(const MySQLBackend &) = delete;
+
+  std::string getName() const override;
+
+  std::unique_ptr<DBStatement>
+  prepareStatement(const std::string &SQL) override;
+
+  void beginTransaction() override;
+  void commit() override;
+  void rollback() override;
+
+  bool schemeExists() override;
+  void buildScheme() override;
+  void dropScheme() override;
+};
+
+} // namespace psr
+
+#endif
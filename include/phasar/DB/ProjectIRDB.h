@@ -12,14 +12,18 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <clang/Tooling/CompilationDatabase.h>
 
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 
+#include <phasar/DB/AnalysisCache.h>
 #include <phasar/PhasarLLVM/Pointer/PointsToGraph.h>
 
 namespace llvm {
@@ -28,6 +32,7 @@ class Instruction;
 class Type;
 class Function;
 class GlobalVariable;
+class TargetLibraryInfo;
 } // namespace llvm
 
 namespace psr {
@@ -35,7 +40,9 @@ namespace psr {
 enum class IRDBOptions : uint32_t {
   NONE = 0,
   MEM2REG = (1 << 0),
-  WPA = (1 << 1)
+  WPA = (1 << 1),
+  PARTITION_PTG = (1 << 2),
+  LAZY_PTG = (1 << 3)
 };
 
 /**
@@ -68,23 +75,46 @@ private:
   std::map<std::string, std::string> functionToModuleMap;
   // Maps globals to the module they are !defined! in
   std::map<std::string, std::string> globals;
-  // Maps an id to its corresponding instruction
-  std::map<std::size_t, llvm::Instruction *> instructions;
+  // Maps an id to its corresponding instruction, ids that belong to global
+  // variables are mapped to nullptr
+  std::vector<llvm::Instruction *> instructions;
+  // The id of instructions[0]. Ids are unique across all IRDBs of a process,
+  // hence the ids of this IRDB do not necessarily start at zero.
+  std::size_t FirstInstructionID = 0;
+  // Maps an instruction to its id, the inverse of instructions
+  std::unordered_map<const llvm::Instruction *, std::size_t> instruction_ids;
   // Maps a function to its points-to graph
   std::map<std::string, std::unique_ptr<PointsToGraph>> ptgs;
+  // Guards ptgs, which may be filled on demand when LAZY_PTG is set
+  std::unique_ptr<std::mutex> ptgs_mtx = std::make_unique<std::mutex>();
+  // The functions whose points-to graphs have been restored from Cache,
+  // guarded by ptgs_mtx
+  std::set<std::string> restored_ptgs;
+  // Guards the data that is collected while modules are preprocessed
+  // concurrently
+  std::unique_ptr<std::mutex> preprocess_mtx = std::make_unique<std::mutex>();
   std::set<const llvm::Type *> allocated_types;
+  // Stores the points-to graphs of unchanged modules across runs, if set
+  std::unique_ptr<AnalysisCache> Cache;
 
   void buildFunctionModuleMapping(llvm::Module *M);
   void buildGlobalModuleMapping(llvm::Module *M);
   void buildIDModuleMapping(llvm::Module *M);
-  void preprocessModule(llvm::Module *M);
+  void promoteMemoryToRegister(llvm::Module *M);
+  void preprocessModule(llvm::Module *M, unsigned NumThreads,
+                        std::size_t FirstValueID, bool Concurrent);
+  PointsToGraph *constructPointsToGraph(llvm::Function *F,
+                                        const llvm::TargetLibraryInfo &TLI);
 
 public:
   /// Constructs an empty ProjectIRDB
   ProjectIRDB(enum IRDBOptions Opt);
-  /// Constructs a ProjectIRDB from a bunch of llvm IR files
+  /// Constructs a ProjectIRDB from a bunch of llvm IR files, which are parsed
+  /// by NumThreads threads. With IRDBOptions::WPA the files are parsed into a
+  /// single context, one after another, such that they can be linked in place.
   ProjectIRDB(const std::vector<std::string> &IRFiles,
-              enum IRDBOptions Opt = IRDBOptions::NONE);
+              enum IRDBOptions Opt = IRDBOptions::NONE,
+              unsigned NumThreads = 1);
   /// Constructs a ProjectIRDB from a CompilationDatabase (only for simple
   /// projects)
   ProjectIRDB(const clang::tooling::CompilationDatabase &CompileDB,
@@ -101,7 +131,17 @@ public:
 
   ~ProjectIRDB() = default;
 
-  void preprocessIR();
+  /// Runs the preprocessing passes and constructs the intra-procedural
+  /// points-to graphs. With several modules, NumThreads modules are
+  /// preprocessed concurrently, otherwise the points-to graphs of the single
+  /// module are constructed by NumThreads threads.
+  void preprocessIR(unsigned NumThreads = 1);
+
+  /// Restores the points-to graphs of modules that have not changed since the
+  /// last run from the given directory and stores the others there, when
+  /// preprocessIR() is called afterwards. Has no effect with
+  /// IRDBOptions::LAZY_PTG.
+  void useAnalysisCache(const std::string &CacheDirectory);
 
   // add WPA support by providing a fat completely linked module
   void linkForWPA();
@@ -111,6 +151,9 @@ public:
   bool empty();
   llvm::LLVMContext *getLLVMContext(const std::string &ModuleName);
   void insertModule(std::unique_ptr<llvm::Module> M);
+  /// Maps the functions that have been defined in the given module since it
+  /// has been added and forgets the ones that have been removed from it.
+  void updateFunctionModuleMapping(llvm::Module *M);
   llvm::Module *getModule(const std::string &ModuleName);
   std::set<llvm::Module *> getAllModules() const;
   std::set<const llvm::Function *> getAllFunctions();
@@ -133,7 +176,18 @@ public:
   getGlobalVariableModuleName(const std::string &GlobalVariableName);
   llvm::Instruction *getInstruction(std::size_t id);
   std::size_t getInstructionID(const llvm::Instruction *I);
+  /**
+   * If the IRDB has been created with IRDBOptions::LAZY_PTG, the points-to
+   * graph of a function is constructed on the first request and cached
+   * afterwards. Concurrent calls are safe.
+   *
+   * @brief Returns the intra-procedural points-to graph of the given function
+   * or nullptr, if the function is not defined.
+   */
   PointsToGraph *getPointsToGraph(const std::string &FunctionName);
+  /// Returns whether the points-to graph of the given function has been
+  /// restored from the analysis cache rather than constructed.
+  bool isPointsToGraphRestored(const std::string &FunctionName);
   void insertPointsToGraph(const std::string &FunctionName, PointsToGraph *ptg);
   void print();
   void exportPATBCJSON();
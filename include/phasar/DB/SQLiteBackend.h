@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DB_SQLITEBACKEND_H_
+#define PHASAR_DB_SQLITEBACKEND_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sqlite3.h>
+
+#include <phasar/DB/DBBackend.h>
+
+namespace psr {
+
+/**
+ * Used by every SQLite database of PhASAR.
+ *
+ * @brief Lets the given database use a write-ahead log.
+ * @return The result code of the first pragma that has failed or SQLITE_OK.
+ */
+int enableWriteAheadLog(sqlite3 *db);
+
+/**
+ * The database is a single file that is opened in-process, such that no
+ * database server is needed, e.g. on isolated analysis workers.
+ *
+ * Statements are prepared once and are reused by every later statement with
+ * the same SQL, which, together with a transaction around a bulk of inserts,
+ * is what makes SQLite insert fast.
+ *
+ * @brief A DBBackend that uses an embedded SQLite database.
+ */
+class SQLiteBackend : public DBBackend {
+private:
+  sqlite3 *db;
+  std::string filename;
+  /// Prepared statements that are currently not in use, by their SQL
+  std::unordered_map<std::string, std::vector<sqlite3_stmt *>> statement_pool;
+  void exec(const std::string &SQL);
+
+public:
+  /**
+   * The schema is created if it does not exist yet.
+   *
+   * @brief Opens or creates the database in the given file.
+   * @throws DBException if the database cannot be opened.
+   */
+  SQLiteBackend(const std::string &filename);
+
+  ~SQLiteBackend() override;
+
+  SQLiteBackend(const SQLiteBackend &) = delete;
+  SQLiteBackend &operator=(const SQLiteBackend &) = delete;
+
+  std::string getName() const override;
+
+  std::unique_ptr<DBStatement>
+  prepareStatement(const std::string &SQL) override;
+
+  /// Hands a statement that is no longer used back to the pool.
+  void releaseStatement(const std::string &SQL, sqlite3_stmt *stmt);
+
+  void beginTransaction() override;
+  void commit() override;
+  void rollback() override;
+
+  bool schemeExists() override;
+  void buildScheme() override;
+  void dropScheme() override;
+};
+
+} // namespace psr
+
+#endif
@@ -21,6 +21,8 @@
 #include <map>
 #include <set>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 #include <json.hpp>
 
@@ -65,6 +67,32 @@ public:
   virtual json getAsJson() = 0;
 };
 
+namespace detail {
+template <typename I, typename N, typename = void>
+struct HasCalleesOfCallAtRef : std::false_type {};
+
+template <typename I, typename N>
+struct HasCalleesOfCallAtRef<
+    I, N,
+    std::void_t<decltype(std::declval<I &>().getCalleesOfCallAtRef(
+        std::declval<N>()))>> : std::true_type {};
+} // namespace detail
+
+/**
+ * Returns the callees of the given call site. ICFGs that index their call
+ * graph, like LLVMBasedICFG, provide getCalleesOfCallAtRef(), which returns a
+ * reference to the indexed callees rather than a copy; the callees of all
+ * other ICFGs are returned by value.
+ */
+template <typename I, typename N>
+decltype(auto) calleesOfCallAt(I &icfg, N stmt) {
+  if constexpr (detail::HasCalleesOfCallAtRef<I, N>::value) {
+    return icfg.getCalleesOfCallAtRef(stmt);
+  } else {
+    return icfg.getCalleesOfCallAt(stmt);
+  }
+}
+
 } // namespace psr
 
 #endif
@@ -67,6 +67,9 @@ public:
   std::set<const llvm::Function *>
   getCalleesOfCallAt(const llvm::Instruction *n) override;
 
+  const std::set<const llvm::Function *> &
+  getCalleesOfCallAtRef(const llvm::Instruction *n) const;
+
   std::set<const llvm::Instruction *>
   getCallersOf(const llvm::Function *m) override;
 
@@ -17,11 +17,13 @@
 #ifndef PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDCFG_H_
 #define PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDCFG_H_
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
 #include <phasar/PhasarLLVM/ControlFlow/CFG.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedCFGIndex.h>
 
 namespace llvm {
 class Function;
@@ -32,6 +34,11 @@ namespace psr {
 
 class LLVMBasedCFG
     : public virtual CFG<const llvm::Instruction *, const llvm::Function *> {
+protected:
+  // shared by copies of this CFG
+  std::shared_ptr<LLVMBasedCFGIndex> CFGIndex =
+      std::make_shared<LLVMBasedCFGIndex>();
+
 public:
   LLVMBasedCFG() = default;
 
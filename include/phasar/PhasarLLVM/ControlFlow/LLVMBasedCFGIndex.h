@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDCFGINDEX_H_
+#define PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDCFGINDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/DenseMap.h>
+
+namespace llvm {
+class Function;
+class Instruction;
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * Precomputed instruction-level control-flow graphs of LLVM functions.
+ *
+ * The index of a function is built on its first query and holds the
+ * function's instructions in order as well as the successors and
+ * predecessors of every instruction as compressed sparse rows. Successors
+ * and predecessors are listed in the order in which LLVMBasedCFG has always
+ * reported them. The returned array references stay valid until the function
+ * is invalidated or the index is destroyed. All queries are thread-safe.
+ */
+class LLVMBasedCFGIndex {
+private:
+  struct FunctionIndex {
+    std::vector<const llvm::Instruction *> Instructions;
+    // the successors of the i-th instruction are
+    // Succs[SuccOffsets[i]] .. Succs[SuccOffsets[i + 1] - 1]
+    std::vector<uint32_t> SuccOffsets;
+    std::vector<const llvm::Instruction *> Succs;
+    // same layout as the successors
+    std::vector<uint32_t> PredOffsets;
+    std::vector<const llvm::Instruction *> Preds;
+  };
+
+  llvm::DenseMap<const llvm::Function *, std::unique_ptr<FunctionIndex>>
+      Functions;
+  // position of every indexed instruction within its function's index
+  llvm::DenseMap<const llvm::Instruction *,
+                 std::pair<const FunctionIndex *, uint32_t>>
+      Positions;
+  std::shared_mutex Mtx;
+
+  static std::unique_ptr<FunctionIndex> build(const llvm::Function *F);
+
+  std::pair<const FunctionIndex *, uint32_t>
+  positionOf(const llvm::Instruction *I);
+
+  const FunctionIndex *indexOf(const llvm::Function *F);
+
+public:
+  LLVMBasedCFGIndex() = default;
+
+  ~LLVMBasedCFGIndex() = default;
+
+  LLVMBasedCFGIndex(const LLVMBasedCFGIndex &) = delete;
+
+  LLVMBasedCFGIndex &operator=(const LLVMBasedCFGIndex &) = delete;
+
+  llvm::ArrayRef<const llvm::Instruction *>
+  successorsOf(const llvm::Instruction *I);
+
+  llvm::ArrayRef<const llvm::Instruction *>
+  predecessorsOf(const llvm::Instruction *I);
+
+  llvm::ArrayRef<const llvm::Instruction *>
+  instructionsOf(const llvm::Function *F);
+
+  /**
+   * Drops the index of the given function, e.g. after its IR has been
+   * changed. Invalidates all array references into it.
+   */
+  void invalidate(const llvm::Function *F);
+
+  void clear();
+};
+
+} // namespace psr
+
+#endif
@@ -20,6 +20,9 @@
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <memory>
+#include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -27,6 +30,8 @@
 
 #include <boost/graph/adjacency_list.hpp>
 
+#include <llvm/ADT/StringMap.h>
+
 #include <phasar/PhasarLLVM/ControlFlow/ICFG.h>
 #include <phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h>
 #include <phasar/PhasarLLVM/Pointer/PointsToGraph.h>
@@ -56,6 +61,15 @@ private:
   ProjectIRDB &IRDB;
   PointsToGraph WholeModulePTG;
   std::unordered_set<const llvm::Function *> VisitedFunctions;
+  /// Names of the entry points the call graph has been constructed from
+  std::vector<std::string> EntryPointNames;
+  /// Content hashes of the visited functions, recorded by
+  /// updateChangedFunctions() for the functions it does not resolve again;
+  /// empty for a function that has not been hashed yet
+  std::unordered_map<std::string, std::optional<std::size_t>> FunctionHashes;
+  /// Hash of the functions and the type hierarchy that indirect and virtual
+  /// call sites have been resolved against
+  std::size_t ResolutionStateHash = 0;
   /// Keeps track of the call-sites already resolved
   // std::vector<const llvm::Instruction *> CallStack;
 
@@ -80,7 +94,7 @@ private:
     std::string ir_code;
     size_t id = 0;
     EdgeProperties() = default;
-    EdgeProperties(const llvm::Instruction *i);
+    EdgeProperties(const llvm::Instruction *i, size_t id);
   };
 
   /// Specify the type of graph to be used.
@@ -102,8 +116,39 @@ private:
   /// Maps function names to the corresponding vertex id.
   std::unordered_map<std::string, vertex_t> function_vertex_map;
 
+  /// Maps call sites to their possible callees.
+  std::unordered_map<const llvm::Instruction *,
+                     std::set<const llvm::Function *>>
+      CalleesOfCallAt;
+
+  /// Maps function names to the call sites that may call the function. Keyed
+  /// by name, since a function that is not defined in any module is declared
+  /// once per module that calls it; a StringMap is queried without copying
+  /// the name.
+  llvm::StringMap<std::set<const llvm::Instruction *>> CallersOf;
+
+  std::unique_ptr<Resolver> makeResolver();
+
   void constructionWalker(const llvm::Function *F, Resolver *resolver);
 
+  void parallelConstructionWalker(
+      const std::vector<const llvm::Function *> &EntryFunctions,
+      Resolver *resolver, unsigned NumThreads);
+
+  std::set<const llvm::Function *> resolveCallSite(llvm::ImmutableCallSite CS,
+                                                   Resolver *resolver);
+
+  vertex_t addFunctionVertex(const llvm::Function *F);
+
+  void addCallEdges(const llvm::Function *F, const llvm::Instruction *CallSite,
+                    const std::set<const llvm::Function *> &Callees);
+
+  const llvm::Function *resolveFunction(const llvm::Function *F);
+
+  void indexCallGraph();
+
+  std::size_t computeResolutionStateHash();
+
   struct dependency_visitor;
 
 public:
@@ -111,11 +156,13 @@ public:
 
   LLVMBasedICFG(LLVMTypeHierarchy &STH, ProjectIRDB &IRDB,
                 CallGraphAnalysisType CGType,
-                const std::vector<std::string> &EntryPoints = {"main"});
+                const std::vector<std::string> &EntryPoints = {"main"},
+                unsigned NumThreads = 1);
 
   LLVMBasedICFG(LLVMTypeHierarchy &STH, ProjectIRDB &IRDB,
                 const llvm::Module &M, CallGraphAnalysisType CGType,
-                std::vector<std::string> EntryPoints = {});
+                std::vector<std::string> EntryPoints = {},
+                unsigned NumThreads = 1);
 
   ~LLVMBasedICFG() override = default;
 
@@ -128,6 +175,11 @@ public:
   std::set<const llvm::Function *>
   getCalleesOfCallAt(const llvm::Instruction *n) override;
 
+  /// Like getCalleesOfCallAt(), but returns a reference to the indexed
+  /// callees, which is valid until the call graph changes.
+  const std::set<const llvm::Function *> &
+  getCalleesOfCallAtRef(const llvm::Instruction *n) const;
+
   std::set<const llvm::Instruction *>
   getCallersOf(const llvm::Function *m) override;
 
@@ -154,6 +206,8 @@ public:
 
   void mergeWith(const LLVMBasedICFG &other);
 
+  std::set<std::string> updateChangedFunctions();
+
   bool isPrimitiveFunction(const std::string &name);
 
   void print();
@@ -170,6 +224,16 @@ public:
 
   void exportPATBCJSON();
 
+  /**
+   * Call sites are referred to by the ids of their instructions rather than
+   * their IR code, see MappedICFG for the layout.
+   *
+   * @brief Writes the call graph into a binary file, which can be
+   * memory-mapped by MappedICFG.
+   * @param filename Filename of the binary file.
+   */
+  void exportAsBinary(const std::string &filename);
+
   PointsToGraph &getWholeModulePTG();
 
   std::vector<std::string> getDependencyOrderedFunctions();
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_CONTROLFLOW_MAPPEDICFG_H_
+#define PHASAR_PHASARLLVM_CONTROLFLOW_MAPPEDICFG_H_
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <llvm/ADT/StringRef.h>
+
+#include <phasar/PhasarLLVM/ControlFlow/ICFG.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h>
+
+namespace llvm {
+class Instruction;
+class Function;
+class MemoryBuffer;
+} // namespace llvm
+
+namespace psr {
+
+class ProjectIRDB;
+
+/**
+ * A call-graph file is written by LLVMBasedICFG::exportAsBinary() and consists
+ * of the following arrays, each padded to eight bytes:
+ *
+ *   char      Magic[8]
+ *   uint64_t  Sizes[3]  (functions, call sites, string table)
+ *   uint64_t  NameOffsets[#functions + 1]
+ *   char      StringTable[#string table]
+ *   uint64_t  CallSiteIDs[#call sites]
+ *   uint64_t  CalleeOffsets[#call sites + 1]
+ *   uint32_t  Callees[CalleeOffsets[#call sites]]
+ *   uint64_t  CallerOffsets[#functions + 1]
+ *   uint32_t  Callers[CallerOffsets[#functions]]
+ *
+ * Functions are sorted by name and call sites are sorted by the ids annotated
+ * to their instructions, such that both can be found by binary search. The
+ * callees of a call site and the call sites calling a function are stored in
+ * compressed sparse row format, i.e. as slices of a single array.
+ *
+ * The file is mapped into memory and queried in place, hence several analyses
+ * and processes can share a call graph that has been constructed once. Ids
+ * are resolved by the given ProjectIRDB, which has to annotate the same ids as
+ * the one the call graph has been exported from, i.e. load and preprocess the
+ * same modules in the same order.
+ *
+ * @brief A read-only interprocedural control-flow graph whose call graph is
+ * mapped from a binary file.
+ */
+class MappedICFG
+    : public ICFG<const llvm::Instruction *, const llvm::Function *>,
+      public virtual LLVMBasedCFG {
+private:
+  ProjectIRDB &IRDB;
+  std::unique_ptr<llvm::MemoryBuffer> Buffer;
+  const uint64_t *Sizes = nullptr;
+  const uint64_t *NameOffsets = nullptr;
+  const char *StringTable = nullptr;
+  const uint64_t *CallSiteIDs = nullptr;
+  const uint64_t *CalleeOffsets = nullptr;
+  const uint32_t *Callees = nullptr;
+  const uint64_t *CallerOffsets = nullptr;
+  const uint32_t *Callers = nullptr;
+
+  llvm::StringRef getFunctionName(uint64_t Idx) const;
+
+  /// Returns the index of the given function, or the number of functions if
+  /// it is not part of the call graph.
+  uint64_t findFunction(llvm::StringRef Name) const;
+
+  /// Returns the index of the given call site, or the number of call sites if
+  /// it is not part of the call graph.
+  uint64_t findCallSite(const llvm::Instruction *I) const;
+
+public:
+  /// Magic bytes at the start of a call-graph file
+  static const char Magic[8];
+
+  /**
+   * @brief Maps the given call-graph file.
+   * @throws std::ios_base::failure if the file cannot be read.
+   * @throws std::runtime_error if the file is malformed.
+   */
+  MappedICFG(ProjectIRDB &IRDB, const std::string &filename);
+
+  ~MappedICFG() override;
+
+  MappedICFG(const MappedICFG &) = delete;
+  MappedICFG &operator=(const MappedICFG &) = delete;
+
+  std::set<const llvm::Function *> getAllMethods();
+
+  const llvm::Function *getMethod(const std::string &fun) override;
+
+  std::set<const llvm::Function *>
+  getCalleesOfCallAt(const llvm::Instruction *n) override;
+
+  std::set<const llvm::Instruction *>
+  getCallersOf(const llvm::Function *m) override;
+
+  std::set<const llvm::Instruction *>
+  getCallsFromWithin(const llvm::Function *m) override;
+
+  std::set<const llvm::Instruction *>
+  getStartPointsOf(const llvm::Function *m) override;
+
+  std::set<const llvm::Instruction *>
+  getExitPointsOf(const llvm::Function *fun) override;
+
+  std::set<const llvm::Instruction *>
+  getReturnSitesOfCallAt(const llvm::Instruction *n) override;
+
+  bool isCallStmt(const llvm::Instruction *stmt) override;
+
+  std::set<const llvm::Instruction *> allNonCallStartNodes() override;
+
+  json getAsJson() override;
+
+  unsigned getNumOfVertices();
+
+  unsigned getNumOfEdges();
+};
+
+} // namespace psr
+
+#endif
@@ -17,6 +17,7 @@
 #ifndef PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_DTARESOLVER_H_
 #define PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_DTARESOLVER_H_
 
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -39,6 +40,8 @@ public:
 
 protected:
   TypeGraph_t typegraph;
+  // Guards typegraph during parallel call-graph construction
+  std::mutex typegraph_mtx;
   std::set<const llvm::StructType *> unsound_types;
 
   /**
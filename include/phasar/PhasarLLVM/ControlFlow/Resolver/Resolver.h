@@ -31,6 +31,18 @@ namespace psr {
 class ProjectIRDB;
 class LLVMTypeHierarchy;
 
+/**
+ * Resolves the possible targets of indirect call sites during call-graph
+ * construction.
+ *
+ * When the call graph is constructed sequentially, the hooks are called while
+ * walking the reachable functions depth-first. When it is constructed in
+ * parallel, preCall() and postCall() are not called, OtherInst() and the
+ * resolve routines may be called concurrently for different functions and
+ * TreatPossibleTarget() is only called between the parallel phases. A
+ * resolver therefore has to synchronize OtherInst() with its resolve routines
+ * and must not modify shared state while resolving.
+ */
 class Resolver {
 protected:
   ProjectIRDB &IRDB;
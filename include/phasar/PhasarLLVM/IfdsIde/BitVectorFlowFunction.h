@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_BITVECTORFLOWFUNCTION_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_BITVECTORFLOWFUNCTION_H_
+
+#include <llvm/ADT/BitVector.h>
+
+#include <phasar/Utils/Interner.h>
+
+namespace psr {
+
+/**
+ * Flow functions implementing this interface in addition to FlowFunction<D>
+ * can be applied to a whole set of data-flow facts at once by the
+ * BitVectorIFDSSolver. A set of facts is a bit vector in which bit i
+ * represents the fact with id i of the given index. This allows gen/kill
+ * style flow functions to be computed by word-wise bit operations rather
+ * than by applying them to every single fact.
+ *
+ * The result must be equal to the union of FlowFunction<D>::computeTargets()
+ * for every fact in sources.
+ */
+template <typename D> class BitVectorFlowFunction {
+public:
+  virtual ~BitVectorFlowFunction() = default;
+  virtual llvm::BitVector computeTargets(const llvm::BitVector &sources,
+                                         Interner<D> &index) = 0;
+};
+
+/**
+ * Returns true if the given fact is contained in the set of facts.
+ */
+template <typename D>
+bool containsFact(const llvm::BitVector &facts, const Interner<D> &index,
+                  const D &fact) {
+  uint32_t id = index.find(fact);
+  return id != Interner<D>::None && id < facts.size() && facts.test(id);
+}
+
+/**
+ * Adds the given fact to the set of facts and interns it if required.
+ */
+template <typename D>
+void insertFact(llvm::BitVector &facts, Interner<D> &index, const D &fact) {
+  uint32_t id = index.intern(fact);
+  if (facts.size() <= id) {
+    facts.resize(id + 1);
+  }
+  facts.set(id);
+}
+
+/**
+ * Removes the given fact from the set of facts.
+ */
+template <typename D>
+void eraseFact(llvm::BitVector &facts, const Interner<D> &index,
+               const D &fact) {
+  uint32_t id = index.find(fact);
+  if (id != Interner<D>::None && id < facts.size()) {
+    facts.reset(id);
+  }
+}
+
+} // namespace psr
+
+#endif
@@ -17,10 +17,20 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTION_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTION_H_
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include <phasar/Utils/SharedPtrArena.h>
+#include <phasar/Utils/ShardedLRUCache.h>
 
 namespace psr {
 
@@ -55,6 +65,146 @@ static inline bool operator==(const EdgeFunction<V> &F,
   return F.equal_to(G);
 }
 
+/**
+ * Returns true if both edge functions are equal. Interned edge functions
+ * (see makeInternedEdgeFunction()) are equal if and only if they are the
+ * same object, in which case no virtual call is required.
+ */
+template <typename V>
+inline bool equalEdgeFunctions(const std::shared_ptr<EdgeFunction<V>> &F,
+                               const std::shared_ptr<EdgeFunction<V>> &G) {
+  return F == G || F->equal_to(G);
+}
+
+template <typename V>
+inline bool equalEdgeFunctions(const ArenaHandle<EdgeFunction<V>> &F,
+                               const ArenaHandle<EdgeFunction<V>> &G) {
+  return F == G || F->equal_to(G.shared());
+}
+
+namespace detail {
+// Edge functions are immutable, hence edge functions that are passed to the
+// constructor of an interned edge function are identified by their address.
+template <typename T> struct InternKey {
+  using type = T;
+  static const T &get(const T &t) { return t; }
+};
+
+template <typename T> struct InternKey<std::shared_ptr<T>> {
+  using type = const T *;
+  static const T *get(const std::shared_ptr<T> &t) { return t.get(); }
+};
+
+// The interned instances of an edge function type. The table is split into
+// independently locked shards, such that threads that intern different edge
+// functions of the same type rarely contend.
+template <typename KeyT, typename EF> class InternTable {
+private:
+  static constexpr size_t NumShards = 64;
+
+  struct Shard {
+    std::mutex mtx;
+    std::unordered_map<KeyT, std::weak_ptr<EF>, CacheKeyHash<KeyT>> instances;
+    // size of the shard at which released instances are removed
+    size_t sweepThreshold = 64;
+  };
+
+  std::array<Shard, NumShards> shards;
+
+public:
+  template <typename MakeEF>
+  std::shared_ptr<EF> intern(const KeyT &key, MakeEF makeEF) {
+    // the low bits select the bucket within the shard, so use the high ones
+    uint64_t mixed = static_cast<uint64_t>(CacheKeyHash<KeyT>()(key)) *
+                     0x9e3779b97f4a7c15ULL;
+    Shard &shard = shards[(mixed >> 32) % NumShards];
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    std::weak_ptr<EF> &slot = shard.instances[key];
+    if (auto ef = slot.lock()) {
+      return ef;
+    }
+    std::shared_ptr<EF> ef = makeEF();
+    slot = ef;
+    if (shard.instances.size() >= shard.sweepThreshold) {
+      for (auto it = shard.instances.begin(); it != shard.instances.end();) {
+        it = it->second.expired() ? shard.instances.erase(it) : std::next(it);
+      }
+      shard.sweepThreshold = std::max<size_t>(2 * shard.instances.size(), 64);
+    }
+    return ef;
+  }
+};
+} // namespace detail
+
+/**
+ * Hash-conses edge functions: returns the instance of EF that has been
+ * constructed from the same arguments if it is still alive and constructs a
+ * new one otherwise. Structurally equal edge functions therefore share a
+ * single instance and can be compared by address.
+ *
+ * Arguments that are shared pointers are compared by address. EF must keep
+ * such arguments alive, e.g. by storing them, like EdgeFunctionComposer does.
+ * The interned instances are only referenced weakly and are released as soon
+ * as the analysis does not use them anymore. This function is thread-safe.
+ */
+template <typename EF, typename... Args>
+std::shared_ptr<EF> makeInternedEdgeFunction(Args... args) {
+  using KeyT = std::tuple<typename detail::InternKey<Args>::type...>;
+  static detail::InternTable<KeyT, EF> table;
+  return table.intern(KeyT(detail::InternKey<Args>::get(args)...), [&]() {
+    return std::make_shared<EF>(std::move(args)...);
+  });
+}
+
+/**
+ * Memoizes the results of composeWith() and joinWith() per pair of edge
+ * functions, such that the solver does not construct a new edge function
+ * each time it composes or joins the same pair again. The memo owns the
+ * memoized pairs and results, hence a pair that is evicted (see the capacity;
+ * 0 means unbounded) is released once the solver does not use its functions
+ * anymore. Keeping the operands alive also keeps their addresses from being
+ * reused by other edge functions while the pair is memoized.
+ */
+template <typename V> class EdgeFunctionMemo {
+private:
+  using EFPair = std::tuple<std::shared_ptr<EdgeFunction<V>>,
+                            std::shared_ptr<EdgeFunction<V>>>;
+  ShardedLRUCache<EFPair, std::shared_ptr<EdgeFunction<V>>> composed;
+  ShardedLRUCache<EFPair, std::shared_ptr<EdgeFunction<V>>> joined;
+
+public:
+  EdgeFunctionMemo(size_t numShards = 1, size_t capacity = 0)
+      : composed(numShards, capacity), joined(numShards, capacity) {}
+
+  std::shared_ptr<EdgeFunction<V>>
+  compose(const std::shared_ptr<EdgeFunction<V>> &F,
+          const std::shared_ptr<EdgeFunction<V>> &G) {
+    EFPair key(F, G);
+    if (auto cached = composed.lookup(key)) {
+      return *cached;
+    }
+    return composed.insert(key, F->composeWith(G));
+  }
+
+  std::shared_ptr<EdgeFunction<V>>
+  join(const std::shared_ptr<EdgeFunction<V>> &F,
+       const std::shared_ptr<EdgeFunction<V>> &G) {
+    if (F == G) {
+      return F;
+    }
+    EFPair key(F, G);
+    if (auto cached = joined.lookup(key)) {
+      return *cached;
+    }
+    return joined.insert(key, F->joinWith(G));
+  }
+
+  void clear() {
+    composed.clear();
+    joined.clear();
+  }
+};
+
 template <typename V>
 static inline std::ostream &operator<<(std::ostream &OS,
                                        const EdgeFunction<V> &F) {
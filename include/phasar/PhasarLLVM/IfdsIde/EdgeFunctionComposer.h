@@ -11,6 +11,7 @@
 #define PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTIONCOMPOSER_H
 
 #include <gtest/gtest_prod.h>
+#include <atomic>
 #include <memory>
 #include <phasar/PhasarLLVM/IfdsIde/EdgeFunction.h>
 #include <phasar/PhasarLLVM/IfdsIde/EdgeFunctions/AllBottom.h>
@@ -39,7 +40,7 @@ class EdgeFunctionComposer
 private:
   // For debug purpose only
   const unsigned EFComposer_Id;
-  static unsigned CurrEFComposer_Id;
+  static std::atomic<unsigned> CurrEFComposer_Id;
 
 protected:
   /// First edge function
@@ -91,7 +92,8 @@ public:
   }
 };
 
-template <typename V> unsigned EdgeFunctionComposer<V>::CurrEFComposer_Id = 0;
+template <typename V>
+std::atomic<unsigned> EdgeFunctionComposer<V>::CurrEFComposer_Id(0);
 
 } // namespace psr
 
@@ -53,15 +53,9 @@ public:
 
   virtual std::shared_ptr<EdgeFunction<V>>
   joinWith(std::shared_ptr<EdgeFunction<V>> otherFunction) override {
-    if (otherFunction.get() == this ||
-        otherFunction->equal_to(this->shared_from_this()))
-      return this->shared_from_this();
-    if (AllTop<V> *alltop = dynamic_cast<AllTop<V> *>(otherFunction.get()))
-      return this->shared_from_this();
-    if (EdgeIdentity<V> *ei =
-            dynamic_cast<EdgeIdentity<V> *>(otherFunction.get()))
-      return this->shared_from_this();
-    throw std::runtime_error("UNEXPECTED EDGE FUNCTION");
+    // bottom absorbs every other function; which functions are joined with
+    // bottom depends on the order in which the solver processes path edges
+    return this->shared_from_this();
   }
 
   virtual bool equal_to(std::shared_ptr<EdgeFunction<V>> other) const override {
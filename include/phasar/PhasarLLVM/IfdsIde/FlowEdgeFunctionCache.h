@@ -10,7 +10,6 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_FLOWEDGEFUNCTIONCACHE_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_FLOWEDGEFUNCTIONCACHE_H_
 
-#include <map>
 #include <memory>
 #include <set>
 #include <tuple>
@@ -21,6 +20,7 @@
 #include <phasar/PhasarLLVM/IfdsIde/ZeroedFlowFunction.h>
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/PAMMMacros.h>
+#include <phasar/Utils/ShardedLRUCache.h>
 
 namespace psr {
 
@@ -28,7 +28,8 @@ namespace psr {
  * This class caches flow and edge functions to avoid their reconstruction.
  * When a flow or edge function must be applied to multiple times, a cached
  * version is used if existend, otherwise a new one is created and inserted
- * into the cache.
+ * into the cache. The caches own the functions they hold, hence a function
+ * that is evicted is released once the solver does not use it anymore.
  */
 template <typename N, typename D, typename M, typename V, typename I>
 struct FlowEdgeFunctionCache {
@@ -37,31 +38,52 @@ struct FlowEdgeFunctionCache {
   bool autoAddZero;
   D zeroValue;
   // Caches for the flow functions
-  std::map<std::tuple<N, N>, std::shared_ptr<FlowFunction<D>>>
+  ShardedLRUCache<std::tuple<N, N>, std::shared_ptr<FlowFunction<D>>>
       NormalFlowFunctionCache;
-  std::map<std::tuple<N, M>, std::shared_ptr<FlowFunction<D>>>
+  ShardedLRUCache<std::tuple<N, M>, std::shared_ptr<FlowFunction<D>>>
       CallFlowFunctionCache;
-  std::map<std::tuple<N, M, N, N>, std::shared_ptr<FlowFunction<D>>>
+  ShardedLRUCache<std::tuple<N, M, N, N>, std::shared_ptr<FlowFunction<D>>>
       ReturnFlowFunctionCache;
-  std::map<std::tuple<N, N, std::set<M>>, std::shared_ptr<FlowFunction<D>>>
+  ShardedLRUCache<std::tuple<N, N, std::set<M>>,
+                  std::shared_ptr<FlowFunction<D>>>
       CallToRetFlowFunctionCache;
+  ShardedLRUCache<std::tuple<N, M>, std::shared_ptr<FlowFunction<D>>>
+      SummaryFlowFunctionCache;
   // Caches for the edge functions
-  std::map<std::tuple<N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
+  ShardedLRUCache<std::tuple<N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
       NormalEdgeFunctionCache;
-  std::map<std::tuple<N, D, M, D>, std::shared_ptr<EdgeFunction<V>>>
+  ShardedLRUCache<std::tuple<N, D, M, D>, std::shared_ptr<EdgeFunction<V>>>
       CallEdgeFunctionCache;
-  std::map<std::tuple<N, M, N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
+  ShardedLRUCache<std::tuple<N, M, N, D, N, D>,
+                  std::shared_ptr<EdgeFunction<V>>>
       ReturnEdgeFunctionCache;
-  std::map<std::tuple<N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
+  ShardedLRUCache<std::tuple<N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
       CallToRetEdgeFunctionCache;
-  std::map<std::tuple<N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
+  ShardedLRUCache<std::tuple<N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
       SummaryEdgeFunctionCache;
 
   // Ctor allows access to the IDEProblem in order to get access to flow and
-  // edge function factory functions.
-  FlowEdgeFunctionCache(IDETabulationProblem<N, D, M, V, I> &problem)
+  // edge function factory functions. If the solver runs on multiple threads,
+  // every cache should be split into several shards that are locked
+  // independently.
+  FlowEdgeFunctionCache(IDETabulationProblem<N, D, M, V, I> &problem,
+                        size_t numShards = 1)
       : problem(problem), autoAddZero(problem.solver_config.autoAddZero),
-        zeroValue(problem.zeroValue()) {
+        zeroValue(problem.zeroValue()),
+        NormalFlowFunctionCache(numShards, problem.solver_config.cacheCapacity),
+        CallFlowFunctionCache(numShards, problem.solver_config.cacheCapacity),
+        ReturnFlowFunctionCache(numShards, problem.solver_config.cacheCapacity),
+        CallToRetFlowFunctionCache(numShards,
+                                   problem.solver_config.cacheCapacity),
+        SummaryFlowFunctionCache(numShards,
+                                 problem.solver_config.cacheCapacity),
+        NormalEdgeFunctionCache(numShards, problem.solver_config.cacheCapacity),
+        CallEdgeFunctionCache(numShards, problem.solver_config.cacheCapacity),
+        ReturnEdgeFunctionCache(numShards, problem.solver_config.cacheCapacity),
+        CallToRetEdgeFunctionCache(numShards,
+                                   problem.solver_config.cacheCapacity),
+        SummaryEdgeFunctionCache(numShards,
+                                 problem.solver_config.cacheCapacity) {
     PAMM_GET_INSTANCE;
     REG_COUNTER("Normal-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Normal-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
@@ -96,118 +118,109 @@ struct FlowEdgeFunctionCache {
 
   std::shared_ptr<FlowFunction<D>> getNormalFlowFunction(N curr, N succ) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(curr, succ);
-    if (NormalFlowFunctionCache.count(key)) {
+    auto key = std::make_tuple(curr, succ);
+    if (auto cached = NormalFlowFunctionCache.lookup(key)) {
       INC_COUNTER("Normal-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return NormalFlowFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Normal-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ff = (autoAddZero)
-                    ? std::make_shared<ZeroedFlowFunction<D>>(
-                          problem.getNormalFlowFunction(curr, succ), zeroValue)
-                    : problem.getNormalFlowFunction(curr, succ);
-      NormalFlowFunctionCache.insert(make_pair(key, ff));
-      return ff;
+      return *cached;
     }
+    INC_COUNTER("Normal-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ff = (autoAddZero)
+                  ? std::make_shared<ZeroedFlowFunction<D>>(
+                        problem.getNormalFlowFunction(curr, succ), zeroValue)
+                  : problem.getNormalFlowFunction(curr, succ);
+    return NormalFlowFunctionCache.insert(key, std::move(ff));
   }
 
   std::shared_ptr<FlowFunction<D>> getCallFlowFunction(N callStmt, M destMthd) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(callStmt, destMthd);
-    if (CallFlowFunctionCache.count(key)) {
+    auto key = std::make_tuple(callStmt, destMthd);
+    if (auto cached = CallFlowFunctionCache.lookup(key)) {
       INC_COUNTER("Call-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return CallFlowFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Call-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ff =
-          (autoAddZero)
-              ? std::make_shared<ZeroedFlowFunction<D>>(
-                    problem.getCallFlowFunction(callStmt, destMthd), zeroValue)
-              : problem.getCallFlowFunction(callStmt, destMthd);
-      CallFlowFunctionCache.insert(std::make_pair(key, ff));
-      return ff;
+      return *cached;
     }
+    INC_COUNTER("Call-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ff =
+        (autoAddZero)
+            ? std::make_shared<ZeroedFlowFunction<D>>(
+                  problem.getCallFlowFunction(callStmt, destMthd), zeroValue)
+            : problem.getCallFlowFunction(callStmt, destMthd);
+    return CallFlowFunctionCache.insert(key, std::move(ff));
   }
 
   std::shared_ptr<FlowFunction<D>> getRetFlowFunction(N callSite, M calleeMthd,
                                                       N exitStmt, N retSite) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(callSite, calleeMthd, exitStmt, retSite);
-    if (ReturnFlowFunctionCache.count(key)) {
+    auto key = std::make_tuple(callSite, calleeMthd, exitStmt, retSite);
+    if (auto cached = ReturnFlowFunctionCache.lookup(key)) {
       INC_COUNTER("Return-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return ReturnFlowFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Return-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ff = (autoAddZero)
-                    ? std::make_shared<ZeroedFlowFunction<D>>(
-                          problem.getRetFlowFunction(callSite, calleeMthd,
-                                                     exitStmt, retSite),
-                          zeroValue)
-                    : problem.getRetFlowFunction(callSite, calleeMthd, exitStmt,
-                                                 retSite);
-      ReturnFlowFunctionCache.insert(std::make_pair(key, ff));
-      return ff;
+      return *cached;
     }
+    INC_COUNTER("Return-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ff = (autoAddZero)
+                  ? std::make_shared<ZeroedFlowFunction<D>>(
+                        problem.getRetFlowFunction(callSite, calleeMthd,
+                                                   exitStmt, retSite),
+                        zeroValue)
+                  : problem.getRetFlowFunction(callSite, calleeMthd, exitStmt,
+                                               retSite);
+    return ReturnFlowFunctionCache.insert(key, std::move(ff));
   }
 
   std::shared_ptr<FlowFunction<D>>
-  getCallToRetFlowFunction(N callSite, N retSite, std::set<M> callees) {
+  getCallToRetFlowFunction(N callSite, N retSite, const std::set<M> &callees) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(callSite, retSite, callees);
-    if (CallToRetFlowFunctionCache.count(key)) {
+    auto key = std::make_tuple(callSite, retSite, callees);
+    if (auto cached = CallToRetFlowFunctionCache.lookup(key)) {
       INC_COUNTER("CallToRet-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return CallToRetFlowFunctionCache.at(key);
-    } else {
-      INC_COUNTER("CallToRet-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ff =
-          (autoAddZero)
-              ? std::make_shared<ZeroedFlowFunction<D>>(
-                    problem.getCallToRetFlowFunction(callSite, retSite,
-                                                     callees),
-                    zeroValue)
-              : problem.getCallToRetFlowFunction(callSite, retSite, callees);
-      CallToRetFlowFunctionCache.insert(std::make_pair(key, ff));
-      return ff;
+      return *cached;
     }
+    INC_COUNTER("CallToRet-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ff =
+        (autoAddZero)
+            ? std::make_shared<ZeroedFlowFunction<D>>(
+                  problem.getCallToRetFlowFunction(callSite, retSite, callees),
+                  zeroValue)
+            : problem.getCallToRetFlowFunction(callSite, retSite, callees);
+    return CallToRetFlowFunctionCache.insert(key, std::move(ff));
   }
 
   std::shared_ptr<FlowFunction<D>> getSummaryFlowFunction(N callStmt,
                                                           M destMthd) {
     // PAMM_GET_INSTANCE;
     // INC_COUNTER("Summary-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto key = std::make_tuple(callStmt, destMthd);
+    if (auto cached = SummaryFlowFunctionCache.lookup(key)) {
+      return *cached;
+    }
     auto ff = problem.getSummaryFlowFunction(callStmt, destMthd);
-    return ff;
+    return SummaryFlowFunctionCache.insert(key, std::move(ff));
   }
 
   std::shared_ptr<EdgeFunction<V>> getNormalEdgeFunction(N curr, D currNode,
                                                          N succ, D succNode) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(curr, currNode, succ, succNode);
-    if (NormalEdgeFunctionCache.count(key)) {
+    auto key = std::make_tuple(curr, currNode, succ, succNode);
+    if (auto cached = NormalEdgeFunctionCache.lookup(key)) {
       INC_COUNTER("Normal-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return NormalEdgeFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getNormalEdgeFunction(curr, currNode, succ, succNode);
-      NormalEdgeFunctionCache.insert(std::make_pair(key, ef));
-      return ef;
+      return *cached;
     }
+    INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ef = problem.getNormalEdgeFunction(curr, currNode, succ, succNode);
+    return NormalEdgeFunctionCache.insert(key, std::move(ef));
   }
 
   std::shared_ptr<EdgeFunction<V>>
   getCallEdgeFunction(N callStmt, D srcNode, M destiantionMethod, D destNode) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(callStmt, srcNode, destiantionMethod, destNode);
-    if (CallEdgeFunctionCache.count(key)) {
+    auto key = std::make_tuple(callStmt, srcNode, destiantionMethod, destNode);
+    if (auto cached = CallEdgeFunctionCache.lookup(key)) {
       INC_COUNTER("Call-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return CallEdgeFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Call-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getCallEdgeFunction(callStmt, srcNode,
-                                            destiantionMethod, destNode);
-      CallEdgeFunctionCache.insert(std::make_pair(key, ef));
-      return ef;
+      return *cached;
     }
+    INC_COUNTER("Call-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ef = problem.getCallEdgeFunction(callStmt, srcNode, destiantionMethod,
+                                          destNode);
+    return CallEdgeFunctionCache.insert(key, std::move(ef));
   }
 
   std::shared_ptr<EdgeFunction<V>> getReturnEdgeFunction(N callSite,
@@ -215,51 +228,61 @@ struct FlowEdgeFunctionCache {
                                                          N exitStmt, D exitNode,
                                                          N reSite, D retNode) {
     PAMM_GET_INSTANCE;
-    auto key =
-        std::tie(callSite, calleeMethod, exitStmt, exitNode, reSite, retNode);
-    if (ReturnEdgeFunctionCache.count(key)) {
+    auto key = std::make_tuple(callSite, calleeMethod, exitStmt, exitNode,
+                               reSite, retNode);
+    if (auto cached = ReturnEdgeFunctionCache.lookup(key)) {
       INC_COUNTER("Return-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return ReturnEdgeFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Return-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getReturnEdgeFunction(callSite, calleeMethod, exitStmt,
-                                              exitNode, reSite, retNode);
-      ReturnEdgeFunctionCache.insert(std::make_pair(key, ef));
-      return ef;
+      return *cached;
     }
+    INC_COUNTER("Return-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ef = problem.getReturnEdgeFunction(callSite, calleeMethod, exitStmt,
+                                            exitNode, reSite, retNode);
+    return ReturnEdgeFunctionCache.insert(key, std::move(ef));
   }
 
   std::shared_ptr<EdgeFunction<V>>
   getCallToRetEdgeFunction(N callSite, D callNode, N retSite, D retSiteNode,
-                           std::set<M> callees) {
+                           const std::set<M> &callees) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(callSite, callNode, retSite, retSiteNode);
-    if (CallToRetEdgeFunctionCache.count(key)) {
+    auto key = std::make_tuple(callSite, callNode, retSite, retSiteNode);
+    if (auto cached = CallToRetEdgeFunctionCache.lookup(key)) {
       INC_COUNTER("CallToRet-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return CallToRetEdgeFunctionCache.at(key);
-    } else {
-      INC_COUNTER("CallToRet-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getCallToRetEdgeFunction(callSite, callNode, retSite,
-                                                 retSiteNode, callees);
-      CallToRetEdgeFunctionCache.insert(std::make_pair(key, ef));
-      return ef;
+      return *cached;
     }
+    INC_COUNTER("CallToRet-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ef = problem.getCallToRetEdgeFunction(callSite, callNode, retSite,
+                                               retSiteNode, callees);
+    return CallToRetEdgeFunctionCache.insert(key, std::move(ef));
   }
 
   std::shared_ptr<EdgeFunction<V>>
   getSummaryEdgeFunction(N callSite, D callNode, N retSite, D retSiteNode) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(callSite, callNode, retSite, retSiteNode);
-    if (SummaryEdgeFunctionCache.count(key)) {
+    auto key = std::make_tuple(callSite, callNode, retSite, retSiteNode);
+    if (auto cached = SummaryEdgeFunctionCache.lookup(key)) {
       INC_COUNTER("Summary-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return SummaryEdgeFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Summary-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getSummaryEdgeFunction(callSite, callNode, retSite,
-                                               retSiteNode);
-      SummaryEdgeFunctionCache.insert(std::make_pair(key, ef));
-      return ef;
+      return *cached;
     }
+    INC_COUNTER("Summary-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ef = problem.getSummaryEdgeFunction(callSite, callNode, retSite,
+                                             retSiteNode);
+    return SummaryEdgeFunctionCache.insert(key, std::move(ef));
+  }
+
+  /**
+   * Drops all cached functions.
+   */
+  void clear() {
+    NormalFlowFunctionCache.clear();
+    CallFlowFunctionCache.clear();
+    ReturnFlowFunctionCache.clear();
+    CallToRetFlowFunctionCache.clear();
+    SummaryFlowFunctionCache.clear();
+    NormalEdgeFunctionCache.clear();
+    CallEdgeFunctionCache.clear();
+    ReturnEdgeFunctionCache.clear();
+    CallToRetEdgeFunctionCache.clear();
+    SummaryEdgeFunctionCache.clear();
   }
 
   void print() {
@@ -19,11 +19,13 @@
 
 #include <set>
 
+#include <phasar/PhasarLLVM/IfdsIde/BitVectorFlowFunction.h>
 #include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
 
 namespace psr {
 
-template <typename D> class Gen : public FlowFunction<D> {
+template <typename D>
+class Gen : public FlowFunction<D>, public BitVectorFlowFunction<D> {
 protected:
   D genValue;
   D zeroValue;
@@ -37,6 +39,13 @@ public:
     else
       return {source};
   }
+  llvm::BitVector computeTargets(const llvm::BitVector &sources,
+                                 Interner<D> &index) override {
+    llvm::BitVector targets(sources);
+    if (containsFact(sources, index, zeroValue))
+      insertFact(targets, index, genValue);
+    return targets;
+  }
 };
 
 } // namespace psr
@@ -19,11 +19,13 @@
 
 #include <set>
 
+#include <phasar/PhasarLLVM/IfdsIde/BitVectorFlowFunction.h>
 #include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
 
 namespace psr {
 
-template <typename D> class GenAll : public FlowFunction<D> {
+template <typename D>
+class GenAll : public FlowFunction<D>, public BitVectorFlowFunction<D> {
 protected:
   std::set<D> genValues;
   D zeroValue;
@@ -40,6 +42,15 @@ public:
       return {source};
     }
   }
+  llvm::BitVector computeTargets(const llvm::BitVector &sources,
+                                 Interner<D> &index) override {
+    llvm::BitVector targets(sources);
+    if (containsFact(sources, index, zeroValue)) {
+      for (const D &genValue : genValues)
+        insertFact(targets, index, genValue);
+    }
+    return targets;
+  }
 };
 
 } // namespace psr
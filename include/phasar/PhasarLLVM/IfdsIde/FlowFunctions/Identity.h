@@ -20,11 +20,13 @@
 #include <memory>
 #include <set>
 
+#include <phasar/PhasarLLVM/IfdsIde/BitVectorFlowFunction.h>
 #include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
 
 namespace psr {
 
-template <typename D> class Identity : public FlowFunction<D> {
+template <typename D>
+class Identity : public FlowFunction<D>, public BitVectorFlowFunction<D> {
 private:
   Identity() = default;
 
@@ -34,6 +36,10 @@ public:
   Identity &operator=(const Identity &i) = delete;
   // simply return what the user provides
   std::set<D> computeTargets(D source) override { return {source}; }
+  llvm::BitVector computeTargets(const llvm::BitVector &sources,
+                                 Interner<D> &index) override {
+    return sources;
+  }
   static std::shared_ptr<Identity> getInstance() {
     static std::shared_ptr<Identity> instance =
         std::shared_ptr<Identity>(new Identity);
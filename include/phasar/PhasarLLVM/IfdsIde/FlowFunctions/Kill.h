@@ -19,12 +19,14 @@
 
 #include <set>
 
+#include <phasar/PhasarLLVM/IfdsIde/BitVectorFlowFunction.h>
 #include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
 #include <set>
 
 namespace psr {
 
-template <typename D> class Kill : public FlowFunction<D> {
+template <typename D>
+class Kill : public FlowFunction<D>, public BitVectorFlowFunction<D> {
 protected:
   D killValue;
 
@@ -37,6 +39,12 @@ public:
     else
       return {source};
   }
+  llvm::BitVector computeTargets(const llvm::BitVector &sources,
+                                 Interner<D> &index) override {
+    llvm::BitVector targets(sources);
+    eraseFact(targets, index, killValue);
+    return targets;
+  }
 };
 
 } // namespace psr
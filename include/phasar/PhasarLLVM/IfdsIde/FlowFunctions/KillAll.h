@@ -20,11 +20,13 @@
 #include <memory>
 #include <set>
 
+#include <phasar/PhasarLLVM/IfdsIde/BitVectorFlowFunction.h>
 #include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
 
 namespace psr {
 
-template <typename D> class KillAll : public FlowFunction<D> {
+template <typename D>
+class KillAll : public FlowFunction<D>, public BitVectorFlowFunction<D> {
 private:
   KillAll() = default;
 
@@ -33,6 +35,10 @@ public:
   KillAll(const KillAll &k) = delete;
   KillAll &operator=(const KillAll &k) = delete;
   std::set<D> computeTargets(D source) override { return std::set<D>(); }
+  llvm::BitVector computeTargets(const llvm::BitVector &sources,
+                                 Interner<D> &index) override {
+    return llvm::BitVector(sources.size());
+  }
   static std::shared_ptr<KillAll<D>> getInstance() {
     static std::shared_ptr<KillAll> instance =
         std::shared_ptr<KillAll>(new KillAll);
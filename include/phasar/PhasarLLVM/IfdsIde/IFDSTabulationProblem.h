@@ -44,6 +44,10 @@ public:
     solver_config = conf;
   }
   SolverConfiguration getSolverConfiguration() { return solver_config; }
+  /// Returns true if the flow and edge functions of the problem can be
+  /// queried and applied concurrently. Otherwise the problem is solved by a
+  /// single thread regardless of solver_config.numThreads.
+  virtual bool isThreadSafe() const { return false; }
   virtual void printIFDSReport(std::ostream &os,
                                SolverResults<N, D, BinaryDomain> &SR) {
     os << "No IFDS report available!";
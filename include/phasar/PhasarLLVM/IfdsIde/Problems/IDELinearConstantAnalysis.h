@@ -10,6 +10,7 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_PROBLEMS_IDELINEARCONSTANTANALYSIS_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_PROBLEMS_IDELINEARCONSTANTANALYSIS_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -36,10 +37,11 @@ class IDELinearConstantAnalysis
 private:
   std::vector<std::string> EntryPoints;
 
-  // For debug purpose only
-  static unsigned CurrGenConstant_Id;
-  static unsigned CurrLCAID_Id;
-  static unsigned CurrBinary_Id;
+  // For debug purpose only, atomic as edge functions may be created by
+  // several threads of the solver
+  static std::atomic<unsigned> CurrGenConstant_Id;
+  static std::atomic<unsigned> CurrLCAID_Id;
+  static std::atomic<unsigned> CurrBinary_Id;
 
 public:
   typedef const llvm::Value *d_t;
@@ -83,6 +85,8 @@ public:
 
   bool isZeroValue(d_t d) const override;
 
+  bool isThreadSafe() const override;
+
   // in addition provide specifications for the IDE parts
 
   std::shared_ptr<EdgeFunction<v_t>>
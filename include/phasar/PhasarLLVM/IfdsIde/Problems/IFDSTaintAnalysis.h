@@ -13,6 +13,7 @@
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -52,6 +53,9 @@ public:
 private:
   TaintSensitiveFunctions SourceSinkFunctions;
   std::vector<std::string> EntryPoints;
+  // Guards Leaks, which is extended by the sink flow functions that may be
+  // applied concurrently
+  std::mutex LeaksMtx;
 
 public:
   /// Holds all leaks found during the analysis
@@ -92,6 +96,8 @@ public:
 
   bool isZeroValue(d_t d) const override;
 
+  bool isThreadSafe() const override;
+
   void printNode(std::ostream &os, n_t n) const override;
 
   void printDataFlowFact(std::ostream &os, d_t d) const override;
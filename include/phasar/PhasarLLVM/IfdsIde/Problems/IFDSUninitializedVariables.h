@@ -12,6 +12,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -38,6 +39,9 @@ public:
 
 private:
   std::map<n_t, std::set<d_t>> UndefValueUses;
+  // Guards UndefValueUses, which is extended by flow functions that may be
+  // applied concurrently
+  std::mutex UndefValueUsesMtx;
   std::vector<std::string> EntryPoints;
 
 public:
@@ -70,6 +74,8 @@ public:
 
   bool isZeroValue(d_t d) const override;
 
+  bool isThreadSafe() const override;
+
   void printNode(std::ostream &os, n_t n) const override;
 
   void printDataFlowFact(std::ostream &os, d_t d) const override;
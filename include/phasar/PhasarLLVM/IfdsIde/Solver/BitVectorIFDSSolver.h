@@ -0,0 +1,413 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BITVECTORIFDSSOLVER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BITVECTORIFDSSOLVER_H_
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include <llvm/ADT/BitVector.h>
+
+#include <phasar/PhasarLLVM/ControlFlow/ICFG.h>
+#include <phasar/PhasarLLVM/IfdsIde/BitVectorFlowFunction.h>
+#include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
+#include <phasar/PhasarLLVM/IfdsIde/IFDSTabulationProblem.h>
+#include <phasar/PhasarLLVM/Utils/BinaryDomain.h>
+#include <phasar/Utils/Interner.h>
+#include <phasar/Utils/Logger.h>
+#include <phasar/Utils/PAMMMacros.h>
+
+namespace psr {
+
+/**
+ * Solves the given IFDSTabulationProblem like the IFDSSolver, but processes
+ * sets of data-flow facts rather than single facts.
+ *
+ * The facts of every method are interned into a dense index of their own,
+ * such that a set of facts is a bit vector. For every node and fact at the
+ * start point of the node's method, the solver stores the set of facts
+ * reaching the node and only propagates the facts that have been newly
+ * added to it. Flow functions that implement BitVectorFlowFunction are
+ * applied to the whole set at once, all other flow functions are applied
+ * fact by fact.
+ */
+template <typename N, typename D, typename M, typename I>
+class BitVectorIFDSSolver {
+public:
+  BitVectorIFDSSolver(IFDSTabulationProblem<N, D, M, I> &ifdsProblem)
+      : ifdsProblem(ifdsProblem), icfg(ifdsProblem.interproceduralCFG()),
+        zeroValue(ifdsProblem.zeroValue()),
+        autoAddZero(ifdsProblem.solver_config.autoAddZero),
+        followReturnsPastSeeds(
+            ifdsProblem.solver_config.followReturnsPastSeeds) {}
+
+  virtual ~BitVectorIFDSSolver() = default;
+
+  /**
+   * @brief Runs the solver on the configured problem. This can take some time.
+   */
+  virtual void solve() {
+    PAMM_GET_INSTANCE;
+    REG_COUNTER("BitVector Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
+    auto &lg = lg::get();
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                  << "Bit-vector IFDS solver is solving the specified problem");
+    START_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    submitInitialSeeds();
+    while (!worklist.empty()) {
+      std::pair<N, uint32_t> nodeAndSource = worklist.front();
+      worklist.pop_front();
+      processPathEdges(nodeAndSource.first, nodeAndSource.second);
+    }
+    STOP_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Problem solved");
+  }
+
+  /**
+   * Returns the data-flow facts that hold at the given statement, including
+   * the zero value.
+   */
+  std::set<D> ifdsResultsAt(N stmt) {
+    std::set<D> results;
+    auto search = pathEdges.find(stmt);
+    if (search == pathEdges.end()) {
+      return results;
+    }
+    llvm::BitVector facts;
+    for (const auto &sourceAndFacts : search->second) {
+      facts |= sourceAndFacts.second;
+    }
+    const Interner<D> &index = indexOf(icfg.getMethodOf(stmt));
+    for (int id = facts.find_first(); id != -1; id = facts.find_next(id)) {
+      results.insert(index.get(id));
+    }
+    return results;
+  }
+
+  /**
+   * Returns the data-flow facts that hold at the given statement in the
+   * format of the IFDSSolver. The artificial zero value can be stripped.
+   */
+  std::unordered_map<D, BinaryDomain> resultsAt(N stmt,
+                                                bool stripZero = false) {
+    std::unordered_map<D, BinaryDomain> results;
+    for (const D &fact : ifdsResultsAt(stmt)) {
+      if (!stripZero || !ifdsProblem.isZeroValue(fact)) {
+        results[fact] = BinaryDomain::BOTTOM;
+      }
+    }
+    return results;
+  }
+
+protected:
+  IFDSTabulationProblem<N, D, M, I> &ifdsProblem;
+  I icfg;
+  D zeroValue;
+  bool autoAddZero;
+  bool followReturnsPastSeeds;
+
+  // dense index of the data-flow facts of every method; the zero value
+  // always has id 0
+  std::unordered_map<M, Interner<D>> factIndices;
+
+  // facts reaching a node, for every fact id at the start point of the
+  // node's method
+  std::unordered_map<N, std::unordered_map<uint32_t, llvm::BitVector>>
+      pathEdges;
+
+  // facts that have been added to pathEdges but not been propagated yet
+  std::unordered_map<N, std::unordered_map<uint32_t, llvm::BitVector>>
+      pendingFacts;
+
+  // nodes and source fact ids that have pending facts
+  std::deque<std::pair<N, uint32_t>> worklist;
+
+  // (start point, fact id) -> exit node -> facts reaching the exit node
+  std::map<std::pair<N, uint32_t>, std::unordered_map<N, llvm::BitVector>>
+      endSummaries;
+
+  // (start point, fact id) -> call sites and the caller's source fact ids
+  std::map<std::pair<N, uint32_t>, std::set<std::pair<N, uint32_t>>>
+      incoming;
+
+  // flow functions that have already been queried from the problem, such
+  // that every node is only asked for its flow functions once; the callees
+  // of a call-to-return flow function are determined by the call site
+  std::map<std::pair<N, N>, std::shared_ptr<FlowFunction<D>>>
+      normalFlowFunctions;
+  std::map<std::pair<N, M>, std::shared_ptr<FlowFunction<D>>>
+      callFlowFunctions;
+  std::map<std::tuple<N, M, N, N>, std::shared_ptr<FlowFunction<D>>>
+      retFlowFunctions;
+  std::map<std::pair<N, N>, std::shared_ptr<FlowFunction<D>>>
+      callToRetFlowFunctions;
+  std::map<std::pair<N, M>, std::shared_ptr<FlowFunction<D>>>
+      summaryFlowFunctions;
+
+  Interner<D> &indexOf(M method) {
+    Interner<D> &index = factIndices[method];
+    if (index.empty()) {
+      index.intern(zeroValue);
+    }
+    return index;
+  }
+
+  /**
+   * Returns the flow function cached for the key and constructs it by the
+   * given factory if there is none yet.
+   */
+  template <typename Key, typename Factory>
+  const std::shared_ptr<FlowFunction<D>> &
+  cached(std::map<Key, std::shared_ptr<FlowFunction<D>>> &cache,
+         const Key &key, Factory factory) {
+    auto search = cache.find(key);
+    if (search == cache.end()) {
+      search = cache.emplace(key, factory()).first;
+    }
+    return search->second;
+  }
+
+  const std::shared_ptr<FlowFunction<D>> &getNormalFlowFunction(N curr,
+                                                                N succ) {
+    return cached(normalFlowFunctions, std::make_pair(curr, succ), [&]() {
+      return ifdsProblem.getNormalFlowFunction(curr, succ);
+    });
+  }
+
+  const std::shared_ptr<FlowFunction<D>> &getCallFlowFunction(N callStmt,
+                                                              M destMthd) {
+    return cached(callFlowFunctions, std::make_pair(callStmt, destMthd), [&]() {
+      return ifdsProblem.getCallFlowFunction(callStmt, destMthd);
+    });
+  }
+
+  const std::shared_ptr<FlowFunction<D>> &
+  getRetFlowFunction(N callSite, M calleeMthd, N exitStmt, N retSite) {
+    return cached(retFlowFunctions,
+                  std::make_tuple(callSite, calleeMthd, exitStmt, retSite),
+                  [&]() {
+                    return ifdsProblem.getRetFlowFunction(callSite, calleeMthd,
+                                                          exitStmt, retSite);
+                  });
+  }
+
+  const std::shared_ptr<FlowFunction<D>> &
+  getCallToRetFlowFunction(N callSite, N retSite, const std::set<M> &callees) {
+    return cached(callToRetFlowFunctions, std::make_pair(callSite, retSite),
+                  [&]() {
+                    return ifdsProblem.getCallToRetFlowFunction(
+                        callSite, retSite, callees);
+                  });
+  }
+
+  // the cached summary is null if the callee has to be analyzed
+  const std::shared_ptr<FlowFunction<D>> &getSummaryFlowFunction(N callStmt,
+                                                                 M destMthd) {
+    return cached(summaryFlowFunctions, std::make_pair(callStmt, destMthd),
+                  [&]() {
+                    return ifdsProblem.getSummaryFlowFunction(callStmt,
+                                                              destMthd);
+                  });
+  }
+
+  /**
+   * Applies the flow function to the facts, which are given with respect to
+   * the index from, and returns the resulting facts with respect to the
+   * index to.
+   */
+  llvm::BitVector apply(const std::shared_ptr<FlowFunction<D>> &flowFunction,
+                        const llvm::BitVector &sources, Interner<D> &from,
+                        Interner<D> &to) {
+    llvm::BitVector targets;
+    auto *bitVectorFlowFunction =
+        dynamic_cast<BitVectorFlowFunction<D> *>(flowFunction.get());
+    if (bitVectorFlowFunction && &from == &to) {
+      targets = bitVectorFlowFunction->computeTargets(sources, to);
+    } else {
+      for (int id = sources.find_first(); id != -1;
+           id = sources.find_next(id)) {
+        for (const D &target : flowFunction->computeTargets(from.get(id))) {
+          insertFact(targets, to, target);
+        }
+      }
+    }
+    // the zero value has id 0 in every index
+    if (autoAddZero && !sources.empty() && sources.test(0)) {
+      insertFact(targets, to, zeroValue);
+    }
+    return targets;
+  }
+
+  /**
+   * Adds the facts to the facts reaching target for the given source fact
+   * and schedules the ones that are new.
+   */
+  void propagate(N target, uint32_t source, const llvm::BitVector &facts) {
+    PAMM_GET_INSTANCE;
+    llvm::BitVector &reached = pathEdges[target][source];
+    llvm::BitVector newFacts(facts);
+    newFacts.reset(reached);
+    if (newFacts.none()) {
+      return;
+    }
+    INC_COUNTER("BitVector Path Edges", newFacts.count(),
+                PAMM_SEVERITY_LEVEL::Core);
+    reached |= newFacts;
+    llvm::BitVector &pending = pendingFacts[target][source];
+    if (pending.none()) {
+      worklist.emplace_back(target, source);
+    }
+    pending |= newFacts;
+  }
+
+  void submitInitialSeeds() {
+    for (const auto &seed : ifdsProblem.initialSeeds()) {
+      N startPoint = seed.first;
+      Interner<D> &index = indexOf(icfg.getMethodOf(startPoint));
+      llvm::BitVector facts;
+      insertFact(facts, index, zeroValue);
+      for (const D &fact : seed.second) {
+        insertFact(facts, index, fact);
+      }
+      propagate(startPoint, 0, facts);
+    }
+  }
+
+  void processPathEdges(N n, uint32_t source) {
+    llvm::BitVector facts;
+    std::swap(facts, pendingFacts[n][source]);
+    if (icfg.isCallStmt(n)) {
+      processCall(n, source, facts);
+    } else {
+      if (icfg.isExitStmt(n)) {
+        processExit(n, source, facts);
+      }
+      if (!icfg.getSuccsOf(n).empty()) {
+        processNormalFlow(n, source, facts);
+      }
+    }
+  }
+
+  void processNormalFlow(N n, uint32_t source, const llvm::BitVector &facts) {
+    Interner<D> &index = indexOf(icfg.getMethodOf(n));
+    for (N succ : icfg.getSuccsOf(n)) {
+      propagate(succ, source,
+                apply(getNormalFlowFunction(n, succ), facts, index, index));
+    }
+  }
+
+  void processCall(N n, uint32_t source, const llvm::BitVector &facts) {
+    Interner<D> &callerIndex = indexOf(icfg.getMethodOf(n));
+    std::set<N> returnSites = icfg.getReturnSitesOfCallAt(n);
+    const std::set<M> &callees = calleesOfCallAt(icfg, n);
+    for (M callee : callees) {
+      // a special summary replaces the analysis of the callee
+      const std::shared_ptr<FlowFunction<D>> &summary =
+          getSummaryFlowFunction(n, callee);
+      if (summary) {
+        llvm::BitVector targets =
+            apply(summary, facts, callerIndex, callerIndex);
+        for (N returnSite : returnSites) {
+          propagate(returnSite, source, targets);
+        }
+        continue;
+      }
+      Interner<D> &calleeIndex = indexOf(callee);
+      llvm::BitVector calleeFacts =
+          apply(getCallFlowFunction(n, callee), facts, callerIndex,
+                calleeIndex);
+      for (N startPoint : icfg.getStartPointsOf(callee)) {
+        for (int calleeSource = calleeFacts.find_first(); calleeSource != -1;
+             calleeSource = calleeFacts.find_next(calleeSource)) {
+          // create initial self-loop
+          llvm::BitVector self(calleeSource + 1);
+          self.set(calleeSource);
+          propagate(startPoint, calleeSource, self);
+          auto key = std::make_pair(startPoint, uint32_t(calleeSource));
+          incoming[key].insert(std::make_pair(n, source));
+          // apply the summaries that have already been computed
+          auto summaries = endSummaries.find(key);
+          if (summaries == endSummaries.end()) {
+            continue;
+          }
+          for (const auto &exitAndFacts : summaries->second) {
+            for (N returnSite : returnSites) {
+              propagate(returnSite, source,
+                        apply(getRetFlowFunction(n, callee, exitAndFacts.first,
+                                                 returnSite),
+                              exitAndFacts.second, calleeIndex, callerIndex));
+            }
+          }
+        }
+      }
+    }
+    for (N returnSite : returnSites) {
+      propagate(returnSite, source,
+                apply(getCallToRetFlowFunction(n, returnSite, callees), facts,
+                      callerIndex, callerIndex));
+    }
+  }
+
+  void processExit(N n, uint32_t source, const llvm::BitVector &facts) {
+    M callee = icfg.getMethodOf(n);
+    Interner<D> &calleeIndex = indexOf(callee);
+    std::set<std::pair<N, uint32_t>> callSites;
+    for (N startPoint : icfg.getStartPointsOf(callee)) {
+      auto key = std::make_pair(startPoint, source);
+      endSummaries[key][n] |= facts;
+      auto search = incoming.find(key);
+      if (search != incoming.end()) {
+        callSites.insert(search->second.begin(), search->second.end());
+      }
+    }
+    for (const auto &callSiteAndSource : callSites) {
+      N callSite = callSiteAndSource.first;
+      Interner<D> &callerIndex = indexOf(icfg.getMethodOf(callSite));
+      for (N returnSite : icfg.getReturnSitesOfCallAt(callSite)) {
+        propagate(returnSite, callSiteAndSource.second,
+                  apply(getRetFlowFunction(callSite, callee, n, returnSite),
+                        facts, calleeIndex, callerIndex));
+      }
+    }
+    // handling for unbalanced problems where we return out of a method with a
+    // fact for which we have no incoming flow, only for facts that originate
+    // from zero
+    if (followReturnsPastSeeds && callSites.empty() && source == 0) {
+      std::set<N> callers = icfg.getCallersOf(callee);
+      for (N callSite : callers) {
+        Interner<D> &callerIndex = indexOf(icfg.getMethodOf(callSite));
+        for (N returnSite : icfg.getReturnSitesOfCallAt(callSite)) {
+          propagate(returnSite, 0,
+                    apply(getRetFlowFunction(callSite, callee, n, returnSite),
+                          facts, calleeIndex, callerIndex));
+        }
+      }
+      // call the return flow function with a null caller for its side
+      // effects, see IDESolver::processExit()
+      if (callers.empty()) {
+        std::shared_ptr<FlowFunction<D>> retFunction =
+            ifdsProblem.getRetFlowFunction(nullptr, callee, n, nullptr);
+        for (int id = facts.find_first(); id != -1; id = facts.find_next(id)) {
+          retFunction->computeTargets(calleeIndex.get(id));
+        }
+      }
+    }
+  }
+};
+
+} // namespace psr
+
+#endif
@@ -17,15 +17,22 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDESOLVER_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDESOLVER_H_
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <type_traits>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <curl/curl.h>
 #include <json.hpp>
@@ -34,6 +41,7 @@
 
 #include <llvm/Support/raw_ostream.h>
 
+#include <phasar/PhasarLLVM/ControlFlow/ICFG.h>
 #include <phasar/PhasarLLVM/IfdsIde/EdgeFunction.h>
 #include <phasar/PhasarLLVM/IfdsIde/EdgeFunctions.h>
 #include <phasar/PhasarLLVM/IfdsIde/EdgeFunctions/EdgeIdentity.h>
@@ -46,12 +54,15 @@
 #include <phasar/PhasarLLVM/IfdsIde/Solver/JumpFunctions.h>
 #include <phasar/PhasarLLVM/IfdsIde/Solver/LinkedNode.h>
 #include <phasar/PhasarLLVM/IfdsIde/Solver/PathEdge.h>
+#include <phasar/PhasarLLVM/IfdsIde/Solver/PathEdgeWorklist.h>
 #include <phasar/PhasarLLVM/IfdsIde/ZeroedFlowFunction.h>
 
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/PAMMMacros.h>
+#include <phasar/Utils/SharedPtrArena.h>
 #include <phasar/Utils/Table.h>
+#include <phasar/Utils/WorkStealingScheduler.h>
 
 namespace psr {
 
@@ -75,9 +86,16 @@ class IFDSToIDETabulationProblem;
 template <typename N, typename D, typename M, typename V, typename I>
 class IDESolver {
 public:
+  using EFHandle = ArenaHandle<EdgeFunction<V>>;
+
   IDESolver(IDETabulationProblem<N, D, M, V, I> &tabulationProblem)
       : ideTabulationProblem(tabulationProblem),
-        cachedFlowEdgeFunctions(tabulationProblem),
+        edgeFunctionArena(numThreadsFor(tabulationProblem) > 1,
+                          numShardsFor(tabulationProblem)),
+        cachedFlowEdgeFunctions(tabulationProblem,
+                                numShardsFor(tabulationProblem)),
+        edgeFunctionMemo(numShardsFor(tabulationProblem),
+                         tabulationProblem.solver_config.cacheCapacity),
         recordEdges(tabulationProblem.solver_config.recordEdges),
         zeroValue(tabulationProblem.zeroValue()),
         icfg(tabulationProblem.interproceduralCFG()),
@@ -87,10 +105,35 @@ public:
             tabulationProblem.solver_config.followReturnsPastSeeds),
         computePersistedSummaries(
             tabulationProblem.solver_config.computePersistedSummaries),
-        PathEdgeCount(0), allTop(tabulationProblem.allTopFunction()),
+        numThreads(numThreadsFor(tabulationProblem)),
+        PathEdgeCount(0),
+        allTop(edgeFunctionArena.adopt(tabulationProblem.allTopFunction())),
+        edgeIdentity(edgeFunctionArena.adopt(EdgeIdentity<V>::getInstance())),
         jumpFn(std::make_shared<JumpFunctions<N, D, M, V, I>>(
             allTop, ideTabulationProblem)),
+        worklist(makePathEdgeWorklist<N, D>(
+            tabulationProblem.solver_config.worklistOrder,
+            [this](N n) { return reversePostOrderIndexOf(n); })),
         initialSeeds(tabulationProblem.initialSeeds()) {
+    if (numThreads < ideTabulationProblem.solver_config.numThreads) {
+      auto &lg = lg::get();
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, WARNING)
+                    << "The problem is not thread-safe and is solved by a "
+                       "single thread");
+    }
+    if (numThreads > 1) {
+      scheduler = std::make_unique<WorkStealingScheduler<PathEdge<N, D>>>(
+          numThreads,
+          [this](PathEdge<N, D> edge) { pathEdgeProcessingTask(edge); });
+      if (ideTabulationProblem.solver_config.worklistOrder ==
+          WorklistOrder::priority) {
+        auto &lg = lg::get();
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, WARNING)
+                      << "The priority worklist order is ignored, since path "
+                         "edges are processed by "
+                      << numThreads << " threads");
+      }
+    }
     // std::cout << "called IDESolver::IDESolver() ctor with IDEProblem"
     //           << std::endl;
   }
@@ -327,6 +370,7 @@ public:
     REG_COUNTER("Process Normal", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Process Exit", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("[Calls] getPointsToSet", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("EF Arena Objects", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_HISTOGRAM("Data-flow facts", PAMM_SEVERITY_LEVEL::Full);
     REG_HISTOGRAM("Points-to", PAMM_SEVERITY_LEVEL::Full);
 
@@ -350,9 +394,12 @@ public:
       STOP_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
     }
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Problem solved");
+    INC_COUNTER("EF Arena Objects", edgeFunctionArena.size(),
+                PAMM_SEVERITY_LEVEL::Full);
     if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
       computeAndPrintStatistics();
     }
+    releaseFunctions();
   }
 
   /**
@@ -383,13 +430,20 @@ public:
 private:
   std::unique_ptr<IFDSToIDETabulationProblem<N, D, M, I>> transformedProblem;
   IDETabulationProblem<N, D, M, V, I> &ideTabulationProblem;
+  // owns the edge functions that are kept by the jump functions and end
+  // summaries of a run, which only store handles to them; they are released
+  // in bulk at the end of solve(). The caches and the memo own the functions
+  // they hold themselves, so that evicted functions are released.
+  SharedPtrArena<EdgeFunction<V>> edgeFunctionArena;
   FlowEdgeFunctionCache<N, D, M, V, I> cachedFlowEdgeFunctions;
+  EdgeFunctionMemo<V> edgeFunctionMemo;
   bool recordEdges;
 
   void saveEdges(N sourceNode, N sinkStmt, D sourceVal, std::set<D> destVals,
                  bool interP) {
     if (!recordEdges)
       return;
+    auto lock = lockIfConcurrent(recordedEdgesMtx);
     Table<N, N, std::map<D, std::set<D>>> &tgtMap =
         (interP) ? computedInterPathEdges : computedIntraPathEdges;
     tgtMap.get(sourceNode, sinkStmt)[sourceVal].insert(destVals.begin(),
@@ -424,9 +478,9 @@ private:
     D d1 = edge.factAtSource();
     N n = edge.getTarget(); // a call node; line 14...
     D d2 = edge.factAtTarget();
-    std::shared_ptr<EdgeFunction<V>> f = jumpFunction(edge);
+    EFHandle f = jumpFunction(edge);
     std::set<N> returnSiteNs = icfg.getReturnSitesOfCallAt(n);
-    std::set<M> callees = icfg.getCalleesOfCallAt(n);
+    const std::set<M> &callees = calleesOfCallAt(icfg, n);
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Possible callees:");
     for (auto callee : callees) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
@@ -464,7 +518,9 @@ private:
                           << "Compose: " << sumEdgFnE->str() << " * "
                           << f->str());
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
-            propagate(d1, returnSiteN, d3, f->composeWith(sumEdgFnE), n, false);
+            propagate(d1, returnSiteN, d3,
+                      edgeFunctionMemo.compose(f.shared(), sumEdgFnE), n,
+                      false);
           }
         }
       } else {
@@ -489,18 +545,20 @@ private:
           // for each result node of the call-flow function
           for (D d3 : res) {
             // create initial self-loop
-            propagate(d3, sP, d3, EdgeIdentity<V>::getInstance(), n,
-                      false); // line 15
+            propagate(d3, sP, d3, edgeIdentity.shared(), n, false); // line 15
             // register the fact that <sp,d3> has an incoming edge from <n,d2>
             // line 15.1 of Naeem/Lhotak/Rodriguez
-            addIncoming(sP, d3, n, d2);
             // line 15.2, copy to avoid concurrent modification exceptions by
             // other threads
-            std::set<
-                typename Table<N, D, std::shared_ptr<EdgeFunction<V>>>::Cell>
-                endSumm = std::set<typename Table<
-                    N, D, std::shared_ptr<EdgeFunction<V>>>::Cell>(
-                    endSummary(sP, d3));
+            std::set<typename Table<N, D, EFHandle>::Cell> endSumm;
+            {
+              // registering the incoming edge and reading the end summaries
+              // must happen atomically, otherwise a summary that is added by
+              // processExit() in between would be missed by both threads
+              auto lock = lockIfConcurrent(summaryMtx);
+              addIncoming(sP, d3, n, d2);
+              endSumm = endSummary(sP, d3);
+            }
             // std::cout << "ENDSUMM" << std::endl;
             // std::cout << "Size: " << endSumm.size() << std::endl;
             // std::cout << "sP: " << ideTabulationProblem.NtoString(sP)
@@ -512,12 +570,10 @@ private:
             // <sP,d3>, create new caller-side jump functions to the return
             // sites because we have observed a potentially new incoming
             // edge into <sP,d3>
-            for (typename Table<N, D, std::shared_ptr<EdgeFunction<V>>>::Cell
-                     entry : endSumm) {
+            for (typename Table<N, D, EFHandle>::Cell entry : endSumm) {
               N eP = entry.getRowKey();
               D d4 = entry.getColumnKey();
-              std::shared_ptr<EdgeFunction<V>> fCalleeSummary =
-                  entry.getValue();
+              EFHandle fCalleeSummary = entry.getValue();
               // for each return site
               for (N retSiteN : returnSiteNs) {
                 // compute return-flow function
@@ -549,7 +605,10 @@ private:
                   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
                                 << "         (return * calleeSummary * call)");
                   std::shared_ptr<EdgeFunction<V>> fPrime =
-                      f4->composeWith(fCalleeSummary)->composeWith(f5);
+                      edgeFunctionMemo.compose(
+                          edgeFunctionMemo.compose(f4,
+                                                   fCalleeSummary.shared()),
+                          f5);
                   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
                                 << "       = " << fPrime->str());
                   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
@@ -560,7 +619,8 @@ private:
                                 << f->str());
                   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
                   propagate(d1, retSiteN, d5_restoredCtx,
-                            f->composeWith(fPrime), n, false);
+                            edgeFunctionMemo.compose(f.shared(), fPrime), n,
+                            false);
                 }
               }
             }
@@ -587,7 +647,8 @@ private:
           LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
                         << "Compose: " << edgeFnE->str() << " * " << f->str());
           LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
-          propagate(d1, returnSiteN, d3, f->composeWith(edgeFnE), n, false);
+          propagate(d1, returnSiteN, d3,
+                    edgeFunctionMemo.compose(f.shared(), edgeFnE), n, false);
         }
       }
     }
@@ -608,7 +669,7 @@ private:
     D d1 = edge.factAtSource();
     N n = edge.getTarget();
     D d2 = edge.factAtTarget();
-    std::shared_ptr<EdgeFunction<V>> f = jumpFunction(edge);
+    EFHandle f = jumpFunction(edge);
     auto successorInst = icfg.getSuccsOf(n);
     for (auto m : successorInst) {
       std::shared_ptr<FlowFunction<D>> flowFunction =
@@ -621,7 +682,8 @@ private:
       for (D d3 : res) {
         std::shared_ptr<EdgeFunction<V>> g =
             cachedFlowEdgeFunctions.getNormalEdgeFunction(n, d2, m, d3);
-        std::shared_ptr<EdgeFunction<V>> fprime = f->composeWith(g);
+        std::shared_ptr<EdgeFunction<V>> fprime =
+            edgeFunctionMemo.compose(f.shared(), g);
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
                       << "Compose: " << g->str() << " * " << f->str());
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
@@ -631,14 +693,32 @@ private:
     }
   }
 
+  /**
+   * Releases all edge and flow functions of the run at once. The computed
+   * values are kept, the jump functions and end summaries are dropped as they
+   * refer to the released functions.
+   */
+  void releaseFunctions() {
+    jumpFn->clear();
+    endsummarytab.clear();
+    edgeFunctionMemo.clear();
+    cachedFlowEdgeFunctions.clear();
+    edgeFunctionArena.clear();
+    // keep the solver's own functions valid
+    allTop = edgeFunctionArena.adopt(ideTabulationProblem.allTopFunction());
+    edgeIdentity = edgeFunctionArena.adopt(EdgeIdentity<V>::getInstance());
+    jumpFn = std::make_shared<JumpFunctions<N, D, M, V, I>>(
+        allTop, ideTabulationProblem);
+  }
+
   void propagateValueAtStart(std::pair<N, D> nAndD, N n) {
     PAMM_GET_INSTANCE;
     D d = nAndD.second;
     M p = icfg.getMethodOf(n);
     for (N c : icfg.getCallsFromWithin(p)) {
-      for (auto entry : jumpFn->forwardLookup(d, c)) {
-        D dPrime = entry.first;
-        std::shared_ptr<EdgeFunction<V>> fPrime = entry.second;
+      for (const auto &record : jumpFn->forwardLookup(d, c)) {
+        D dPrime = record.targetVal;
+        const EFHandle &fPrime = record.function;
         N sP = n;
         V value = val(sP, d);
         INC_COUNTER("Value Propagation", 1, PAMM_SEVERITY_LEVEL::Full);
@@ -650,7 +730,7 @@ private:
   void propagateValueAtCall(std::pair<N, D> nAndD, N n) {
     PAMM_GET_INSTANCE;
     D d = nAndD.second;
-    for (M q : icfg.getCalleesOfCallAt(n)) {
+    for (M q : calleesOfCallAt(icfg, n)) {
       std::shared_ptr<FlowFunction<D>> callFlowFunction =
           cachedFlowEdgeFunctions.getCallFlowFunction(n, q);
       INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
@@ -671,13 +751,22 @@ private:
     V vPrime = joinValueAt(nHashN, nHashD, valNHash, v);
     if (!(vPrime == valNHash)) {
       setVal(nHashN, nHashD, vPrime);
-      valuePropagationTask(std::pair<N, D>(nHashN, nHashD));
+      valuePropagationWorklist.push_back(std::pair<N, D>(nHashN, nHashD));
+    }
+  }
+
+  void processValuePropagationWorklist() {
+    while (!valuePropagationWorklist.empty()) {
+      std::pair<N, D> nAndD = valuePropagationWorklist.front();
+      valuePropagationWorklist.pop_front();
+      valuePropagationTask(nAndD);
     }
   }
 
   V val(N nHashN, D nHashD) {
+    // only read valtab, phase II(ii) calls this concurrently
     if (valtab.contains(nHashN, nHashD)) {
-      return valtab.get(nHashN, nHashD);
+      return std::as_const(valtab).get(nHashN, nHashD);
     } else {
       // implicitly initialized to top; see line [1] of Fig. 7 in SRH96 paper
       return ideTabulationProblem.topElement();
@@ -705,18 +794,15 @@ private:
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
   }
 
-  std::shared_ptr<EdgeFunction<V>> jumpFunction(PathEdge<N, D> edge) {
-    if (!jumpFn->forwardLookup(edge.factAtSource(), edge.getTarget())
-             .count(edge.factAtTarget())) {
-      // JumpFn initialized to all-top, see line [2] in SRH96 paper
-      return allTop;
-    }
-    return jumpFn->forwardLookup(edge.factAtSource(),
-                                 edge.getTarget())[edge.factAtTarget()];
+  EFHandle jumpFunction(PathEdge<N, D> edge) {
+    auto lock = lockIfConcurrent(jumpFnMtx);
+    EFHandle f = jumpFn->lookup(edge.factAtSource(), edge.getTarget(),
+                                edge.factAtTarget());
+    // JumpFn initialized to all-top, see line [2] in SRH96 paper
+    return f ? f : allTop;
   }
 
-  void addEndSummary(N sP, D d1, N eP, D d2,
-                     std::shared_ptr<EdgeFunction<V>> f) {
+  void addEndSummary(N sP, D d1, N eP, D d2, EFHandle f) {
     // note: at this point we don't need to join with a potential previous f
     // because f is a jump function, which is already properly joined
     // within propagate(..)
@@ -776,23 +862,24 @@ private:
     }
   }
 
-  // should be made a callable at some point
-  void valueComputationTask(std::vector<N> values) {
+  /**
+   * Computes the values at the given nodes. The results are joined into the
+   * given table rather than valtab, such that multiple tasks working on
+   * disjoint sets of nodes can run concurrently.
+   */
+  void valueComputationTask(std::vector<N> values, Table<N, D, V> &results) {
     PAMM_GET_INSTANCE;
     for (N n : values) {
+      auto lookupByTarget = jumpFn->lookupByTarget(n);
       for (N sP : icfg.getStartPointsOf(icfg.getMethodOf(n))) {
-        Table<D, D, std::shared_ptr<EdgeFunction<V>>> lookupByTarget;
-        lookupByTarget = jumpFn->lookupByTarget(n);
-        for (typename Table<D, D, std::shared_ptr<EdgeFunction<V>>>::Cell
-                 sourceValTargetValAndFunction : lookupByTarget.cellSet()) {
-          D dPrime = sourceValTargetValAndFunction.getRowKey();
-          D d = sourceValTargetValAndFunction.getColumnKey();
-          std::shared_ptr<EdgeFunction<V>> fPrime =
-              sourceValTargetValAndFunction.getValue();
+        for (const auto &record : lookupByTarget) {
+          D dPrime = record.sourceVal;
+          D d = record.targetVal;
           V targetVal = val(sP, dPrime);
-          setVal(n, d,
-                 ideTabulationProblem.join(val(n, d),
-                                           fPrime->computeTarget(targetVal)));
+          V curr = results.contains(n, d) ? results.get(n, d) : val(n, d);
+          results.insert(n, d,
+                         ideTabulationProblem.join(
+                             curr, record.function->computeTarget(targetVal)));
           INC_COUNTER("Value Computation", 1, PAMM_SEVERITY_LEVEL::Full);
         }
       }
@@ -806,19 +893,44 @@ protected:
   bool autoAddZero;
   bool followReturnPastSeeds;
   bool computePersistedSummaries;
-  unsigned PathEdgeCount;
+  unsigned numThreads;
+  std::atomic<unsigned> PathEdgeCount;
 
   Table<N, N, std::map<D, std::set<D>>> computedIntraPathEdges;
 
   Table<N, N, std::map<D, std::set<D>>> computedInterPathEdges;
 
-  std::shared_ptr<EdgeFunction<V>> allTop;
+  EFHandle allTop;
+
+  EFHandle edgeIdentity;
 
   std::shared_ptr<JumpFunctions<N, D, M, V, I>> jumpFn;
 
+  // path edges that have been discovered by propagate(..) but are not yet
+  // processed; replaces the recursion of the original algorithm
+  std::unique_ptr<PathEdgeWorklist<N, D>> worklist;
+
+  // replaces the worklist if phase I runs on multiple threads, i.e. if
+  // SolverConfiguration::numThreads is greater than one
+  std::unique_ptr<WorkStealingScheduler<PathEdge<N, D>>> scheduler;
+
+  // guard the tables that are shared among the threads of phase I; a thread
+  // never holds more than one of them at a time
+  std::mutex jumpFnMtx;
+  std::mutex summaryMtx;
+  std::mutex recordedEdgesMtx;
+
+  // (n, d) pairs whose value has changed during phase II(i) and must be
+  // propagated further
+  std::deque<std::pair<N, D>> valuePropagationWorklist;
+
+  // position of a node in the reverse post-order of its method, computed
+  // lazily for WorklistOrder::priority
+  std::unordered_map<N, size_t> reversePostOrderIndex;
+
   // stores summaries that were queried before they were computed
   // see CC 2010 paper by Naeem, Lhotak and Rodriguez
-  Table<N, D, Table<N, D, std::shared_ptr<EdgeFunction<V>>>> endsummarytab;
+  Table<N, D, Table<N, D, EFHandle>> endsummarytab;
 
   // edges going along calls
   // see CC 2010 paper by Naeem, Lhotak and Rodriguez
@@ -845,7 +957,12 @@ protected:
             std::make_unique<IFDSToIDETabulationProblem<N, D, M, I>>(
                 tabulationProblem)),
         ideTabulationProblem(*transformedProblem),
-        cachedFlowEdgeFunctions(ideTabulationProblem),
+        edgeFunctionArena(numThreadsFor(ideTabulationProblem) > 1,
+                          numShardsFor(ideTabulationProblem)),
+        cachedFlowEdgeFunctions(ideTabulationProblem,
+                                numShardsFor(ideTabulationProblem)),
+        edgeFunctionMemo(numShardsFor(ideTabulationProblem),
+                         ideTabulationProblem.solver_config.cacheCapacity),
         recordEdges(ideTabulationProblem.solver_config.recordEdges),
         zeroValue(ideTabulationProblem.zeroValue()),
         icfg(ideTabulationProblem.interproceduralCFG()),
@@ -855,10 +972,35 @@ protected:
             ideTabulationProblem.solver_config.followReturnsPastSeeds),
         computePersistedSummaries(
             ideTabulationProblem.solver_config.computePersistedSummaries),
-        PathEdgeCount(0), allTop(ideTabulationProblem.allTopFunction()),
+        numThreads(numThreadsFor(ideTabulationProblem)),
+        PathEdgeCount(0),
+        allTop(edgeFunctionArena.adopt(ideTabulationProblem.allTopFunction())),
+        edgeIdentity(edgeFunctionArena.adopt(EdgeIdentity<V>::getInstance())),
         jumpFn(std::make_shared<JumpFunctions<N, D, M, V, I>>(
             allTop, ideTabulationProblem)),
+        worklist(makePathEdgeWorklist<N, D>(
+            ideTabulationProblem.solver_config.worklistOrder,
+            [this](N n) { return reversePostOrderIndexOf(n); })),
         initialSeeds(ideTabulationProblem.initialSeeds()) {
+    if (numThreads < ideTabulationProblem.solver_config.numThreads) {
+      auto &lg = lg::get();
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, WARNING)
+                    << "The problem is not thread-safe and is solved by a "
+                       "single thread");
+    }
+    if (numThreads > 1) {
+      scheduler = std::make_unique<WorkStealingScheduler<PathEdge<N, D>>>(
+          numThreads,
+          [this](PathEdge<N, D> edge) { pathEdgeProcessingTask(edge); });
+      if (ideTabulationProblem.solver_config.worklistOrder ==
+          WorklistOrder::priority) {
+        auto &lg = lg::get();
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, WARNING)
+                      << "The priority worklist order is ignored, since path "
+                         "edges are processed by "
+                      << numThreads << " threads");
+      }
+    }
     // std::cout << "called IDESolver::IDESolver() ctor with IFDSProblem" <<
     // std::endl;
   }
@@ -883,19 +1025,39 @@ protected:
         setVal(startPoint, val, ideTabulationProblem.bottomElement());
         std::pair<N, D> superGraphNode(startPoint, val);
         valuePropagationTask(superGraphNode);
+        processValuePropagationWorklist();
       }
     }
     // Phase II(ii)
     // we create an array of all nodes and then dispatch fractions of this array
-    // to multiple threads
+    // to multiple threads; valtab is only read while the threads are running,
+    // each of them writes its results to a partition of its own
     std::set<N> allNonCallStartNodes = icfg.allNonCallStartNodes();
-    std::vector<N> nonCallStartNodesArray(allNonCallStartNodes.size());
+    size_t numShards = std::max<size_t>(
+        std::min<size_t>(numThreads, allNonCallStartNodes.size()), 1);
+    std::vector<std::vector<N>> shards(numShards);
     size_t i = 0;
     for (N n : allNonCallStartNodes) {
-      nonCallStartNodesArray[i] = n;
+      // distribute round-robin as neighbouring nodes tend to be equally costly
+      shards[i % numShards].push_back(n);
       i++;
     }
-    valueComputationTask(nonCallStartNodesArray);
+    std::vector<Table<N, D, V>> partitions(numShards);
+    std::vector<std::future<void>> tasks;
+    for (size_t shard = 1; shard < numShards; ++shard) {
+      tasks.push_back(std::async(std::launch::async, [&, shard]() {
+        valueComputationTask(shards[shard], partitions[shard]);
+      }));
+    }
+    valueComputationTask(shards[0], partitions[0]);
+    for (auto &task : tasks) {
+      task.get();
+    }
+    for (auto &partition : partitions) {
+      for (auto &cell : partition.cellVec()) {
+        setVal(cell.r, cell.c, cell.v);
+      }
+    }
   }
 
   /**
@@ -919,11 +1081,71 @@ protected:
         if (!ideTabulationProblem.isZeroValue(value)) {
           INC_COUNTER("Gen facts", 1, PAMM_SEVERITY_LEVEL::Core);
         }
-        propagate(zeroValue, startPoint, value, EdgeIdentity<V>::getInstance(),
-                  nullptr, false);
+        propagate(zeroValue, startPoint, value, edgeIdentity.shared(), nullptr,
+                  false);
       }
-      jumpFn->addFunction(zeroValue, startPoint, zeroValue,
-                          EdgeIdentity<V>::getInstance());
+      jumpFn->addFunction(zeroValue, startPoint, zeroValue, edgeIdentity);
+    }
+    processWorklist();
+  }
+
+  /**
+   * Processes the pending path edges until no new jump functions are
+   * discovered, i.e. until the exploded super-graph is fully constructed.
+   */
+  void processWorklist() {
+    if (scheduler) {
+      scheduler->run();
+      return;
+    }
+    while (!worklist->empty()) {
+      pathEdgeProcessingTask(worklist->pop());
+    }
+  }
+
+  /**
+   * Returns the position of the given node in the reverse post-order of the
+   * control-flow graph of its method. Nodes that are not reachable from the
+   * method's start points are ordered last.
+   */
+  size_t reversePostOrderIndexOf(N n) {
+    auto search = reversePostOrderIndex.find(n);
+    if (search != reversePostOrderIndex.end()) {
+      return search->second;
+    }
+    computeReversePostOrder(icfg.getMethodOf(n));
+    return reversePostOrderIndex
+        .insert(std::make_pair(n, std::numeric_limits<size_t>::max()))
+        .first->second;
+  }
+
+  void computeReversePostOrder(M m) {
+    std::vector<N> postOrder;
+    std::unordered_set<N> visited;
+    // iterative depth-first search, each stack entry holds a node and its
+    // successors that still have to be visited
+    std::vector<std::pair<N, std::vector<N>>> stack;
+    for (N sP : icfg.getStartPointsOf(m)) {
+      if (!visited.insert(sP).second) {
+        continue;
+      }
+      stack.emplace_back(sP, icfg.getSuccsOf(sP));
+      while (!stack.empty()) {
+        if (stack.back().second.empty()) {
+          postOrder.push_back(stack.back().first);
+          stack.pop_back();
+        } else {
+          N succ = stack.back().second.back();
+          stack.back().second.pop_back();
+          if (visited.insert(succ).second) {
+            stack.emplace_back(succ, icfg.getSuccsOf(succ));
+          }
+        }
+      }
+    }
+    size_t idx = 0;
+    for (auto it = postOrder.rbegin(); it != postOrder.rend(); ++it) {
+      reversePostOrderIndex[*it] = idx++;
     }
   }
 
@@ -944,23 +1166,27 @@ protected:
                   << "Process exit at target: "
                   << ideTabulationProblem.NtoString(edge.getTarget()));
     N n = edge.getTarget(); // an exit node; line 21...
-    std::shared_ptr<EdgeFunction<V>> f = jumpFunction(edge);
+    EFHandle f = jumpFunction(edge);
     M methodThatNeedsSummary = icfg.getMethodOf(n);
     D d1 = edge.factAtSource();
     D d2 = edge.factAtTarget();
     // for each of the method's start points, determine incoming calls
     std::set<N> startPointsOf = icfg.getStartPointsOf(methodThatNeedsSummary);
     std::map<N, std::set<D>> inc;
-    for (N sP : startPointsOf) {
-      // line 21.1 of Naeem/Lhotak/Rodriguez
-      // register end-summary
-      addEndSummary(sP, d1, n, d2, f);
-      for (auto entry : incoming(d1, sP)) {
-        inc[entry.first] = std::set<D>{entry.second};
+    {
+      // counterpart of the critical section in processCall()
+      auto lock = lockIfConcurrent(summaryMtx);
+      for (N sP : startPointsOf) {
+        // line 21.1 of Naeem/Lhotak/Rodriguez
+        // register end-summary
+        addEndSummary(sP, d1, n, d2, f);
+        for (auto entry : incoming(d1, sP)) {
+          inc[entry.first] = std::set<D>{entry.second};
+        }
       }
+      printEndSummaryTab();
+      printIncomingTab();
     }
-    printEndSummaryTab();
-    printIncomingTab();
     // for each incoming call edge already processed
     //(see processCall(..))
     for (auto entry : inc) {
@@ -999,24 +1225,34 @@ protected:
                           << " * " << f4->str());
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
                           << "         (return * function * call)");
-            std::shared_ptr<EdgeFunction<V>> fPrime =
-                f4->composeWith(f)->composeWith(f5);
+            std::shared_ptr<EdgeFunction<V>> fPrime = edgeFunctionMemo.compose(
+                edgeFunctionMemo.compose(f4, f.shared()), f5);
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
                           << "       = " << fPrime->str());
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
             // for each jump function coming into the call, propagate to return
             // site using the composed function
-            for (auto valAndFunc : jumpFn->reverseLookup(c, d4)) {
-              std::shared_ptr<EdgeFunction<V>> f3 = valAndFunc.second;
-              if (!f3->equal_to(allTop)) {
-                D d3 = valAndFunc.first;
+            // copy, as propagate() adds jump functions, which invalidates the
+            // range returned by the lookup
+            std::vector<typename JumpFunctions<N, D, M, V, I>::Record>
+                callerJumpFns;
+            {
+              auto lock = lockIfConcurrent(jumpFnMtx);
+              auto range = jumpFn->reverseLookup(c, d4);
+              callerJumpFns.assign(range.begin(), range.end());
+            }
+            for (const auto &record : callerJumpFns) {
+              const EFHandle &f3 = record.function;
+              if (!equalEdgeFunctions(f3, allTop)) {
+                D d3 = record.sourceVal;
                 D d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
                 LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
                               << "Compose: " << fPrime->str() << " * "
                               << f3->str());
                 LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
-                propagate(d3, retSiteC, d5_restoredCtx, f3->composeWith(fPrime),
-                          c, false);
+                propagate(d3, retSiteC, d5_restoredCtx,
+                          edgeFunctionMemo.compose(f3.shared(), fPrime), c,
+                          false);
               }
             }
           }
@@ -1050,8 +1286,10 @@ protected:
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
                           << "Compose: " << f5->str() << " * " << f->str());
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
-            propagteUnbalancedReturnFlow(retSiteC, d5, f->composeWith(f5), c);
+            propagteUnbalancedReturnFlow(
+                retSiteC, d5, edgeFunctionMemo.compose(f.shared(), f5), c);
             // register for value processing (2nd IDE phase)
+            auto lock = lockIfConcurrent(summaryMtx);
             unbalancedRetSites.insert(retSiteC);
           }
         }
@@ -1111,8 +1349,8 @@ protected:
    * @return The set of abstractions at the successor node
    */
   std::set<D>
-  computeNormalFlowFunction(std::shared_ptr<FlowFunction<D>> flowFunction, D d1,
-                            D d2) {
+  computeNormalFlowFunction(std::shared_ptr<FlowFunction<D>> flowFunction,
+                            D d1, D d2) {
     return flowFunction->computeTargets(d2);
   }
 
@@ -1201,31 +1439,54 @@ protected:
                   << "Target value  : "
                   << ideTabulationProblem.DtoString(targetVal));
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Edge function : " << f.get()->str()
+                  << "Edge function : " << f->str()
                   << " (result of previous compose)");
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
-    std::shared_ptr<EdgeFunction<V>> jumpFnE = nullptr;
-    std::shared_ptr<EdgeFunction<V>> fPrime;
-    if (!jumpFn->reverseLookup(target, targetVal).empty()) {
-      jumpFnE = jumpFn->reverseLookup(target, targetVal)[sourceVal];
+    // The join is computed without holding jumpFnMtx. It is committed only
+    // if the jump function has not been replaced in the meantime, otherwise
+    // it is computed again against the jump function of the other thread.
+    EFHandle jumpFnE;
+    {
+      auto lock = lockIfConcurrent(jumpFnMtx);
+      jumpFnE = jumpFn->lookup(sourceVal, target, targetVal);
     }
-    if (jumpFnE == nullptr) {
-      jumpFnE = allTop; // jump function is initialized to all-top
+    std::shared_ptr<EdgeFunction<V>> fPrime;
+    bool newFunction;
+    while (true) {
+      // jump function is initialized to all-top
+      EFHandle current = jumpFnE ? jumpFnE : allTop;
+      fPrime = edgeFunctionMemo.join(current.shared(), f);
+      newFunction = !equalEdgeFunctions(fPrime, current.shared());
+      if (!newFunction) {
+        jumpFnE = current;
+        break;
+      }
+      auto lock = lockIfConcurrent(jumpFnMtx);
+      EFHandle latest = jumpFn->lookup(sourceVal, target, targetVal);
+      if (latest == jumpFnE) {
+        // only the functions that are kept by a jump function are adopted
+        jumpFn->addFunction(sourceVal, target, targetVal,
+                            edgeFunctionArena.adopt(fPrime));
+        jumpFnE = current;
+        break;
+      }
+      jumpFnE = latest;
     }
-    fPrime = jumpFnE->joinWith(f);
-    bool newFunction = !(fPrime->equal_to(jumpFnE));
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Join: " << jumpFnE->str() << " & " << f.get()->str()
+                  << "Join: " << jumpFnE->str() << " & " << f->str()
                   << (jumpFnE->equal_to(f) ? " (EF's are equal)" : " "));
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
                   << "    = " << fPrime->str()
                   << (newFunction ? " (new jump func)" : " "));
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
     if (newFunction) {
-      jumpFn->addFunction(sourceVal, target, targetVal, fPrime);
       PathEdge<N, D> edge(sourceVal, target, targetVal);
       PathEdgeCount++;
-      pathEdgeProcessingTask(edge);
+      if (scheduler) {
+        scheduler->push(edge);
+      } else {
+        worklist->push(edge);
+      }
       if (!ideTabulationProblem.isZeroValue(targetVal)) {
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
                       << "EDGE: <F: " << target->getFunction()->getName().str()
@@ -1248,8 +1509,36 @@ protected:
     return ideTabulationProblem.join(curr, newVal);
   }
 
-  std::set<typename Table<N, D, std::shared_ptr<EdgeFunction<V>>>::Cell>
-  endSummary(N sP, D d3) {
+  /**
+   * Returns the number of threads the given problem is solved with. Problems
+   * that do not declare themselves thread-safe are solved by a single thread.
+   */
+  static unsigned numThreadsFor(IDETabulationProblem<N, D, M, V, I> &problem) {
+    if (!problem.isThreadSafe()) {
+      return 1;
+    }
+    return std::max(problem.solver_config.numThreads, 1u);
+  }
+
+  // number of shards of the solver's caches, such that the threads of phase I
+  // rarely contend for the same shard
+  static size_t numShardsFor(IDETabulationProblem<N, D, M, V, I> &problem) {
+    unsigned threads = numThreadsFor(problem);
+    return threads > 1 ? 4 * threads : 1;
+  }
+
+  /**
+   * Locks the given mutex if phase I runs on multiple threads and returns a
+   * lock that does not own any mutex otherwise.
+   */
+  std::unique_lock<std::mutex> lockIfConcurrent(std::mutex &mtx) {
+    if (scheduler) {
+      return std::unique_lock<std::mutex>(mtx);
+    }
+    return std::unique_lock<std::mutex>();
+  }
+
+  std::set<typename Table<N, D, EFHandle>::Cell> endSummary(N sP, D d3) {
     if (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
       auto key = std::make_pair(sP, d3);
       auto findND = fSummaryReuse.find(key);
@@ -1530,6 +1819,9 @@ protected:
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
                     << "Jump function construciton count: "
                     << GET_COUNTER("JumpFn Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                    << "Edge functions owned by the arena: "
+                    << GET_COUNTER("EF Arena Objects"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
                     << "Phase I duration: " << PRINT_TIMER("DFA Phase I"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
@@ -70,6 +70,8 @@ public:
     return problem.getSummaryFlowFunction(callStmt, destMthd);
   }
 
+  bool isThreadSafe() const override { return problem.isThreadSafe(); }
+
   I interproceduralCFG() override { return problem.interproceduralCFG(); }
 
   std::map<N, std::set<D>> initialSeeds() override {
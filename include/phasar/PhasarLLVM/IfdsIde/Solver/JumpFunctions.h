@@ -17,16 +17,23 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_JUMPFUNCTIONS_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_JUMPFUNCTIONS_H_
 
-#include <map>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <memory>
-#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <llvm/ADT/DenseMap.h>
 
 #include <boost/log/sources/record_ostream.hpp>
 
 #include <phasar/PhasarLLVM/IfdsIde/EdgeFunction.h>
+#include <phasar/Utils/Interner.h>
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
-#include <phasar/Utils/Table.h>
+#include <phasar/Utils/SharedPtrArena.h>
 
 namespace psr {
 
@@ -35,31 +42,142 @@ namespace psr {
 template <typename N, typename D, typename M, typename V, typename I>
 class IDETabulationProblem;
 
+/**
+ * Stores the jump functions computed by the IDESolver.
+ *
+ * Nodes and data-flow facts are interned into dense 32-bit ids. Every jump
+ * function is stored exactly once in a flat vector of records; the three
+ * lookup indexes (by source value and target, by target and target value and
+ * by target) only hold 32-bit record indices. Composite keys are packed into
+ * 64-bit integers and kept in open-addressing hash maps. Edge functions are
+ * referred to by handles into the solver's edge function arena.
+ */
 template <typename N, typename D, typename M, typename L, typename I>
 class JumpFunctions {
+public:
+  struct Record {
+    D sourceVal;
+    N target;
+    D targetVal;
+    ArenaHandle<EdgeFunction<L>> function;
+  };
+
+  /**
+   * A view on the records that match a lookup. The view is invalidated by
+   * addFunction() and removeFunction(), hence callers that change the jump
+   * functions while iterating must copy the records first.
+   */
+  class RecordRange {
+  private:
+    const std::vector<Record> *records = nullptr;
+    const uint32_t *first = nullptr;
+    const uint32_t *last = nullptr;
+
+  public:
+    class iterator {
+    private:
+      const std::vector<Record> *records;
+      const uint32_t *pos;
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = Record;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const Record *;
+      using reference = const Record &;
+
+      iterator(const std::vector<Record> *records, const uint32_t *pos)
+          : records(records), pos(pos) {}
+      reference operator*() const { return (*records)[*pos]; }
+      pointer operator->() const { return &(*records)[*pos]; }
+      iterator &operator++() {
+        ++pos;
+        return *this;
+      }
+      iterator operator++(int) {
+        iterator tmp = *this;
+        ++pos;
+        return tmp;
+      }
+      friend bool operator==(const iterator &lhs, const iterator &rhs) {
+        return lhs.pos == rhs.pos;
+      }
+      friend bool operator!=(const iterator &lhs, const iterator &rhs) {
+        return lhs.pos != rhs.pos;
+      }
+    };
+
+    RecordRange() = default;
+    RecordRange(const std::vector<Record> &records,
+                const std::vector<uint32_t> &indices)
+        : records(&records), first(indices.data()),
+          last(indices.data() + indices.size()) {}
+    iterator begin() const { return iterator(records, first); }
+    iterator end() const { return iterator(records, last); }
+    bool empty() const { return first == last; }
+    size_t size() const { return last - first; }
+  };
+
 private:
-  std::shared_ptr<EdgeFunction<L>> allTop;
+  ArenaHandle<EdgeFunction<L>> allTop;
   const IDETabulationProblem<N, D, M, L, I> &problem;
 
 protected:
-  // mapping from target node and value to a list of all source values and
-  // associated functions where the list is implemented as a mapping from
-  // the source value to the function we exclude empty default functions
-  Table<N, D, std::map<D, std::shared_ptr<EdgeFunction<L>>>>
-      nonEmptyReverseLookup;
-  // mapping from source value and target node to a list of all target values
-  // and associated functions where the list is implemented as a mapping from
-  // the source value to the function we exclude empty default functions
-  Table<D, N, std::map<D, std::shared_ptr<EdgeFunction<L>>>>
-      nonEmptyForwardLookup;
-  // a mapping from target node to a list of triples consisting of source value,
-  // target value and associated function; the triple is implemented by a table
-  // we exclude empty default functions
-  std::unordered_map<N, Table<D, D, std::shared_ptr<EdgeFunction<L>>>>
-      nonEmptyLookupByTargetNode;
+  Interner<N> nodeIds;
+  Interner<D> factIds;
+  // every non-empty jump function, we exclude empty default functions
+  std::vector<Record> records;
+  // mapping from (source value, target node, target value) to the record
+  llvm::DenseMap<std::pair<uint64_t, uint32_t>, uint32_t> recordIndex;
+  // mapping from (source value, target node) to the records of all target
+  // values and associated functions
+  llvm::DenseMap<uint64_t, uint32_t> forwardIndex;
+  std::vector<std::vector<uint32_t>> forwardRecords;
+  // mapping from (target node, target value) to the records of all source
+  // values and associated functions
+  llvm::DenseMap<uint64_t, uint32_t> reverseIndex;
+  std::vector<std::vector<uint32_t>> reverseRecords;
+  // records of all jump functions per target node, indexed by the node's id
+  std::vector<std::vector<uint32_t>> targetRecords;
+
+  static uint64_t pack(uint32_t hi, uint32_t lo) {
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+  }
+
+  RecordRange lookupIn(const llvm::DenseMap<uint64_t, uint32_t> &index,
+                       const std::vector<std::vector<uint32_t>> &buckets,
+                       uint32_t hi, uint32_t lo) const {
+    if (hi == Interner<D>::None || lo == Interner<D>::None) {
+      return RecordRange();
+    }
+    auto search = index.find(pack(hi, lo));
+    if (search == index.end()) {
+      return RecordRange();
+    }
+    return RecordRange(records, buckets[search->second]);
+  }
+
+  static void addTo(llvm::DenseMap<uint64_t, uint32_t> &index,
+                    std::vector<std::vector<uint32_t>> &buckets, uint64_t key,
+                    uint32_t record) {
+    auto inserted = index.try_emplace(key, buckets.size());
+    if (inserted.second) {
+      buckets.emplace_back();
+    }
+    buckets[inserted.first->second].push_back(record);
+  }
+
+  static void replaceIn(std::vector<uint32_t> &bucket, uint32_t from,
+                        uint32_t to) {
+    *std::find(bucket.begin(), bucket.end(), from) = to;
+  }
+
+  static void removeFrom(std::vector<uint32_t> &bucket, uint32_t record) {
+    bucket.erase(std::find(bucket.begin(), bucket.end(), record));
+  }
 
 public:
-  JumpFunctions(std::shared_ptr<EdgeFunction<L>> allTop,
+  JumpFunctions(ArenaHandle<EdgeFunction<L>> allTop,
                 const IDETabulationProblem<N, D, M, L, I> &p)
       : allTop(allTop), problem(p) {}
 
@@ -70,7 +188,7 @@ public:
    * @see PathEdge
    */
   void addFunction(D sourceVal, N target, D targetVal,
-                   std::shared_ptr<EdgeFunction<L>> function) {
+                   ArenaHandle<EdgeFunction<L>> function) {
     auto &lg = lg::get();
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Start adding new jump function");
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
@@ -82,59 +200,78 @@ public:
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
                   << "Edge Function  : " << function->str());
     // we do not store the default function (all-top)
-    if (function->equal_to(allTop))
+    if (equalEdgeFunctions(function, allTop))
       return;
-    std::map<D, std::shared_ptr<EdgeFunction<L>>> &sourceValToFunc =
-        nonEmptyReverseLookup.get(target, targetVal);
-    sourceValToFunc.insert({sourceVal, function});
-    //	printNonEmptyReverseLookup();
-    std::map<D, std::shared_ptr<EdgeFunction<L>>> &targetValToFunc =
-        nonEmptyForwardLookup.get(sourceVal, target);
-    targetValToFunc.insert({targetVal, function});
-    //	printNonEmptyForwardLookup();
-    nonEmptyLookupByTargetNode[target].insert(sourceVal, targetVal, function);
-    //	printNonEmptyLookupByTargetNode();
+    uint32_t sourceId = factIds.intern(sourceVal);
+    uint32_t targetId = nodeIds.intern(target);
+    uint32_t targetValId = factIds.intern(targetVal);
+    auto inserted = recordIndex.try_emplace(
+        std::make_pair(pack(sourceId, targetId), targetValId), records.size());
+    if (!inserted.second) {
+      // an already existing jump function must be replaced by the new one,
+      // since the new function is the join of the old one and a newly found
+      // function
+      records[inserted.first->second].function = function;
+    } else {
+      uint32_t record = records.size();
+      records.push_back(Record{sourceVal, target, targetVal, function});
+      addTo(forwardIndex, forwardRecords, pack(sourceId, targetId), record);
+      addTo(reverseIndex, reverseRecords, pack(targetId, targetValId), record);
+      if (targetRecords.size() <= targetId) {
+        targetRecords.resize(targetId + 1);
+      }
+      targetRecords[targetId].push_back(record);
+    }
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "End adding new jump function");
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
   }
 
+  /**
+   * Returns the jump function from sourceVal to targetVal at target, or a
+   * null handle if there is none, i.e. if the jump function is all-top.
+   */
+  ArenaHandle<EdgeFunction<L>> lookup(D sourceVal, N target,
+                                      D targetVal) const {
+    uint32_t sourceId = factIds.find(sourceVal);
+    uint32_t targetId = nodeIds.find(target);
+    uint32_t targetValId = factIds.find(targetVal);
+    if (sourceId == Interner<D>::None || targetId == Interner<N>::None ||
+        targetValId == Interner<D>::None)
+      return ArenaHandle<EdgeFunction<L>>();
+    auto search =
+        recordIndex.find(std::make_pair(pack(sourceId, targetId), targetValId));
+    if (search == recordIndex.end())
+      return ArenaHandle<EdgeFunction<L>>();
+    return records[search->second].function;
+  }
+
   /**
    * Returns, for a given target statement and value all associated
    * source values, and for each the associated edge function.
-   * The return value is a mapping from source value to function.
    */
-  std::map<D, std::shared_ptr<EdgeFunction<L>>> reverseLookup(N target,
-                                                              D targetVal) {
-    if (!nonEmptyReverseLookup.contains(target, targetVal))
-      return std::map<D, std::shared_ptr<EdgeFunction<L>>>{};
-    else
-      return nonEmptyReverseLookup.get(target, targetVal);
+  RecordRange reverseLookup(N target, D targetVal) const {
+    return lookupIn(reverseIndex, reverseRecords, nodeIds.find(target),
+                    factIds.find(targetVal));
   }
 
   /**
    * Returns, for a given source value and target statement all
    * associated target values, and for each the associated edge function.
-   * The return value is a mapping from target value to function.
    */
-  std::map<D, std::shared_ptr<EdgeFunction<L>>> forwardLookup(D sourceVal,
-                                                              N target) {
-    if (!nonEmptyForwardLookup.contains(sourceVal, target))
-      return std::map<D, std::shared_ptr<EdgeFunction<L>>>{};
-    else
-      return nonEmptyForwardLookup.get(sourceVal, target);
+  RecordRange forwardLookup(D sourceVal, N target) const {
+    return lookupIn(forwardIndex, forwardRecords, factIds.find(sourceVal),
+                    nodeIds.find(target));
   }
 
   /**
    * Returns for a given target statement all jump function records with this
    * target.
-   * The return value is a set of records of the form
-   * (sourceVal,targetVal,edgeFunction).
    */
-  Table<D, D, std::shared_ptr<EdgeFunction<L>>> lookupByTarget(N target) {
-    // if (nonEmptyLookupByTargetNode.count(target))
-    //	return Table<D, D, std::shared_ptr<EdgeFunction<L>>>{};
-    // else
-    return nonEmptyLookupByTargetNode[target];
+  RecordRange lookupByTarget(N target) const {
+    uint32_t targetId = nodeIds.find(target);
+    if (targetId == Interner<N>::None || targetId >= targetRecords.size())
+      return RecordRange();
+    return RecordRange(records, targetRecords[targetId]);
   }
 
   /**
@@ -144,113 +281,83 @@ public:
    * there anyway.
    */
   bool removeFunction(D sourceVal, N target, D targetVal) {
-    //			Map<D,EdgeFunction<L>> sourceValToFunc =
-    // nonEmptyReverseLookup.get(target, targetVal);
-    //			if (sourceValToFunc == null)
-    //				return false;
-    //			if (sourceValToFunc.remove(sourceVal) == null)
-    //				return false;
-    //			if (sourceValToFunc.empty())
-    //				nonEmptyReverseLookup.remove(targetVal,
-    // targetVal);
-    //
-    //			Map<D, EdgeFunction<L>> targetValToFunc =
-    // nonEmptyForwardLookup.get(sourceVal, target);
-    //			if (targetValToFunc == null)
-    //				return false;
-    //			if (targetValToFunc.remove(targetVal) == null)
-    //				return false;
-    //			if (targetValToFunc.empty())
-    //				nonEmptyForwardLookup.remove(sourceVal, target);
-    //
-    //			Table<D,D,EdgeFunction<L>> table =
-    // nonEmptyLookupByTargetNode.get(target);
-    //			if (table == null)
-    //				return false;
-    //			if (table.remove(sourceVal, targetVal) == null)
-    //				return false;
-    //			if (table.empty())
-    //				nonEmptyLookupByTargetNode.remove(target);
-    //
-    //			return true;
-    return false;
+    uint32_t sourceId = factIds.find(sourceVal);
+    uint32_t targetId = nodeIds.find(target);
+    uint32_t targetValId = factIds.find(targetVal);
+    if (sourceId == Interner<D>::None || targetId == Interner<N>::None ||
+        targetValId == Interner<D>::None)
+      return false;
+    auto search =
+        recordIndex.find(std::make_pair(pack(sourceId, targetId), targetValId));
+    if (search == recordIndex.end())
+      return false;
+    uint32_t record = search->second;
+    recordIndex.erase(search);
+    removeFrom(forwardRecords[forwardIndex[pack(sourceId, targetId)]], record);
+    removeFrom(reverseRecords[reverseIndex[pack(targetId, targetValId)]],
+               record);
+    removeFrom(targetRecords[targetId], record);
+    // keep the records dense by moving the last record into the gap
+    uint32_t last = records.size() - 1;
+    if (record != last) {
+      const Record &moved = records[last];
+      uint32_t movedSourceId = factIds.find(moved.sourceVal);
+      uint32_t movedTargetId = nodeIds.find(moved.target);
+      uint32_t movedTargetValId = factIds.find(moved.targetVal);
+      recordIndex[std::make_pair(pack(movedSourceId, movedTargetId),
+                                 movedTargetValId)] = record;
+      replaceIn(forwardRecords[forwardIndex[pack(movedSourceId,
+                                                 movedTargetId)]],
+                last, record);
+      replaceIn(reverseRecords[reverseIndex[pack(movedTargetId,
+                                                 movedTargetValId)]],
+                last, record);
+      replaceIn(targetRecords[movedTargetId], last, record);
+      records[record] = moved;
+    }
+    records.pop_back();
+    return true;
   }
 
+  /**
+   * Returns the number of non-empty jump functions.
+   */
+  size_t size() const { return records.size(); }
+
   /**
    * Removes all jump functions
    */
   void clear() {
-    nonEmptyReverseLookup.clear();
-    nonEmptyForwardLookup.clear();
-    nonEmptyLookupByTargetNode.clear();
+    nodeIds.clear();
+    factIds.clear();
+    records.clear();
+    recordIndex.clear();
+    forwardIndex.clear();
+    forwardRecords.clear();
+    reverseIndex.clear();
+    reverseRecords.clear();
+    targetRecords.clear();
   }
 
   void printJumpFunctions() {
     auto &lg = lg::get();
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Jump Functions:");
-    for (auto &entry : nonEmptyLookupByTargetNode) {
+    for (const auto &targetAndRecords : targetRecords) {
+      if (targetAndRecords.empty())
+        continue;
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "Node: " << problem.NtoString(entry.first));
-      for (auto cell : entry.second.cellSet()) {
+                    << "Node: "
+                    << problem.NtoString(
+                           records[targetAndRecords.front()].target));
+      for (uint32_t record : targetAndRecords) {
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "fact at src: " << problem.DtoString(cell.r));
+                      << "fact at src: "
+                      << problem.DtoString(records[record].sourceVal));
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "fact at dst: " << problem.DtoString(cell.c));
+                      << "fact at dst: "
+                      << problem.DtoString(records[record].targetVal));
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "edge fnct: " << cell.v->str());
-      }
-    }
-  }
-
-  void printNonEmptyReverseLookup() {
-    auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "DUMP nonEmptyReverseLookup");
-    LOG_IF_ENABLE(
-        BOOST_LOG_SEV(lg, DEBUG)
-        << "Table<N, D, std::map<D, std::shared_ptr<EdgeFunction<L>>>>");
-    auto cellset = nonEmptyReverseLookup.cellSet();
-    for (auto cell : cellset) {
-      cell.r->dump();
-      cell.c->dump();
-      for (auto edgefunction : cell.v) {
-        edgefunction.first->dump();
-        edgefunction.second->dump();
-      }
-    }
-  }
-
-  void printNonEmptyForwardLookup() {
-    auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "DUMP nonEmptyForwardLookup");
-    LOG_IF_ENABLE(
-        BOOST_LOG_SEV(lg, DEBUG)
-        << "Table<D, N, std::map<D, std::shared_ptr<EdgeFunction<L>>>>");
-    auto cellset = nonEmptyForwardLookup.cellSet();
-    for (auto cell : cellset) {
-      cell.r->dump();
-      cell.c->dump();
-      for (auto edgefunction : cell.v) {
-        edgefunction.first->dump();
-        edgefunction.second->dump();
-      }
-    }
-  }
-
-  void printNonEmptyLookupByTargetNode() {
-    auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "DUMP nonEmptyLookupByTargetNode");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "std::unordered_map<N, Table<D, D, "
-                     "std::shared_ptr<EdgeFunction<L>>>>");
-    for (auto node : nonEmptyLookupByTargetNode) {
-      node.first->dump();
-      auto table = nonEmptyLookupByTargetNode[node.first];
-      auto cellset = table.cellSet();
-      for (auto cell : cellset) {
-        cell.r->dump();
-        cell.c->dump();
-        cell.v->dump();
+                      << "edge fnct: " << records[record].function->str());
       }
     }
   }
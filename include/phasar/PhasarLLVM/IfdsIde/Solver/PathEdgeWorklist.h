@@ -0,0 +1,144 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_PATHEDGEWORKLIST_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_PATHEDGEWORKLIST_H_
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <phasar/PhasarLLVM/IfdsIde/Solver/PathEdge.h>
+#include <phasar/PhasarLLVM/IfdsIde/SolverConfiguration.h>
+
+namespace psr {
+
+/**
+ * Holds the path edges that still have to be processed by the IDESolver.
+ * Using an explicit worklist rather than recursion keeps the stack usage of
+ * the solver bounded, no matter how large the exploded super-graph is.
+ */
+template <typename N, typename D> class PathEdgeWorklist {
+public:
+  virtual ~PathEdgeWorklist() = default;
+
+  virtual void push(PathEdge<N, D> edge) = 0;
+
+  virtual PathEdge<N, D> pop() = 0;
+
+  virtual bool empty() const = 0;
+
+  virtual size_t size() const = 0;
+};
+
+template <typename N, typename D>
+class FIFOPathEdgeWorklist : public PathEdgeWorklist<N, D> {
+private:
+  std::deque<PathEdge<N, D>> edges;
+
+public:
+  void push(PathEdge<N, D> edge) override { edges.push_back(edge); }
+
+  PathEdge<N, D> pop() override {
+    PathEdge<N, D> edge = edges.front();
+    edges.pop_front();
+    return edge;
+  }
+
+  bool empty() const override { return edges.empty(); }
+
+  size_t size() const override { return edges.size(); }
+};
+
+template <typename N, typename D>
+class LIFOPathEdgeWorklist : public PathEdgeWorklist<N, D> {
+private:
+  std::vector<PathEdge<N, D>> edges;
+
+public:
+  void push(PathEdge<N, D> edge) override { edges.push_back(edge); }
+
+  PathEdge<N, D> pop() override {
+    PathEdge<N, D> edge = edges.back();
+    edges.pop_back();
+    return edge;
+  }
+
+  bool empty() const override { return edges.empty(); }
+
+  size_t size() const override { return edges.size(); }
+};
+
+/**
+ * Processes the path edge with the smallest priority first. Path edges of
+ * equal priority are processed in insertion order.
+ */
+template <typename N, typename D>
+class PriorityPathEdgeWorklist : public PathEdgeWorklist<N, D> {
+private:
+  struct Entry {
+    size_t priority;
+    size_t timestamp;
+    PathEdge<N, D> edge;
+    friend bool operator<(const Entry &lhs, const Entry &rhs) {
+      // std::priority_queue is a max-heap, hence invert the comparison
+      return std::tie(lhs.priority, lhs.timestamp) >
+             std::tie(rhs.priority, rhs.timestamp);
+    }
+  };
+  std::priority_queue<Entry> edges;
+  std::function<size_t(N)> priorityOf;
+  size_t timestamp = 0;
+
+public:
+  PriorityPathEdgeWorklist(std::function<size_t(N)> priorityOf)
+      : priorityOf(priorityOf) {}
+
+  void push(PathEdge<N, D> edge) override {
+    edges.push(Entry{priorityOf(edge.getTarget()), timestamp++, edge});
+  }
+
+  PathEdge<N, D> pop() override {
+    PathEdge<N, D> edge = edges.top().edge;
+    edges.pop();
+    return edge;
+  }
+
+  bool empty() const override { return edges.empty(); }
+
+  size_t size() const override { return edges.size(); }
+};
+
+/**
+ * Creates a worklist that hands out path edges in the given order. The
+ * priority function is only used for WorklistOrder::priority.
+ */
+template <typename N, typename D>
+std::unique_ptr<PathEdgeWorklist<N, D>>
+makePathEdgeWorklist(WorklistOrder order,
+                     std::function<size_t(N)> priorityOf = nullptr) {
+  switch (order) {
+  case WorklistOrder::fifo:
+    return std::make_unique<FIFOPathEdgeWorklist<N, D>>();
+  case WorklistOrder::priority:
+    return std::make_unique<PriorityPathEdgeWorklist<N, D>>(priorityOf);
+  case WorklistOrder::lifo:
+  default:
+    return std::make_unique<LIFOPathEdgeWorklist<N, D>>();
+  }
+}
+
+} // namespace psr
+
+#endif
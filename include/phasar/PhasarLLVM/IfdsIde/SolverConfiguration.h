@@ -17,10 +17,31 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVERCONFIGURATION_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVERCONFIGURATION_H_
 
+#include <cstddef>
 #include <iosfwd>
+#include <map>
+#include <string>
 
 namespace psr {
 
+/**
+ * Determines the order in which the IDESolver processes the path edges that
+ * are pending on its worklist during phase I.
+ *
+ *   fifo     - breadth-first exploration of the exploded super-graph
+ *   lifo     - depth-first exploration (the order of the former recursive
+ *              implementation)
+ *   priority - path edges whose target comes first in the reverse post-order
+ *              of its function are processed first
+ */
+enum class WorklistOrder { fifo = 0, lifo, priority };
+
+extern const std::map<WorklistOrder, std::string> WorklistOrderToString;
+
+extern const std::map<std::string, WorklistOrder> StringToWorklistOrder;
+
+std::ostream &operator<<(std::ostream &os, const WorklistOrder &w);
+
 struct SolverConfiguration {
   SolverConfiguration() = default;
   SolverConfiguration(bool followReturnsPastSeeds, bool autoAddZero,
@@ -40,6 +61,18 @@ struct SolverConfiguration {
   bool computeValues = false;
   bool recordEdges = false;
   bool computePersistedSummaries = false;
+  WorklistOrder worklistOrder = WorklistOrder::lifo;
+  // Number of threads used to construct the exploded super-graph (phase I)
+  // and to compute the values at the non-call, non-start nodes (phase II).
+  // More than one thread is only used for tabulation problems that declare
+  // their flow and edge functions safe to be queried concurrently, see
+  // isThreadSafe(), and phase I then processes the path edges in
+  // work-stealing order instead of worklistOrder.
+  unsigned numThreads = 1;
+  // Maximal number of entries kept by each of the solver's flow and edge
+  // function caches. Least recently used entries are evicted and constructed
+  // again when needed. 0 means unbounded.
+  size_t cacheCapacity = 0;
   friend std::ostream &operator<<(std::ostream &os,
                                   const SolverConfiguration &sc);
 };
@@ -17,6 +17,10 @@
 #ifndef PHASAR_PHASARLLVM_PASSES_VALUEANNOTATIONPASS_H_
 #define PHASAR_PHASARLLVM_PASSES_VALUEANNOTATIONPASS_H_
 
+#include <atomic>
+#include <cstddef>
+#include <limits>
+
 #include <llvm/Pass.h>
 
 namespace llvm {
@@ -38,13 +42,22 @@ namespace psr {
  */
 class ValueAnnotationPass : public llvm::ModulePass {
 private:
-  static size_t unique_value_id;
+  static std::atomic<size_t> unique_value_id;
+  static constexpr size_t ReserveOnRun = std::numeric_limits<size_t>::max();
   llvm::LLVMContext &context;
+  size_t first_value_id;
 
 public:
   static char ID;
-  ValueAnnotationPass(llvm::LLVMContext &context)
-      : llvm::ModulePass(ID), context(context) {}
+  /**
+   * If no first ID is given, the IDs for the module are reserved when the
+   * pass is run. Otherwise, they must have been reserved with
+   * reserveValueIDs() beforehand.
+   */
+  ValueAnnotationPass(llvm::LLVMContext &context,
+                      size_t first_value_id = ReserveOnRun)
+      : llvm::ModulePass(ID), context(context),
+        first_value_id(first_value_id) {}
 
   /**
    * @brief Does the annotation.
@@ -79,6 +92,20 @@ public:
    */
   void releaseMemory() override;
 
+  /**
+   * @brief Returns the number of IDs that are needed to annotate M.
+   */
+  static size_t countAnnotatedValues(const llvm::Module &M);
+
+  /**
+   * Reserving the IDs of several modules one after another in a fixed order
+   * and annotating the modules afterwards in parallel yields the same IDs as
+   * annotating them one after another. May be called concurrently.
+   *
+   * @brief Reserves Count consecutive IDs and returns the first one.
+   */
+  static size_t reserveValueIDs(size_t Count);
+
   /**
    * @brief Resets the global ID - only used for unit testing!
    */
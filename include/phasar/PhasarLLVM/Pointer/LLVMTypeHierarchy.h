@@ -204,6 +204,13 @@ public:
 
   void mergeWith(LLVMTypeHierarchy &Other);
 
+  /**
+   * 	@brief Returns a hash of the types, their sub-type relations and their
+   * 	       vtables, which changes whenever virtual calls may resolve
+   * 	       differently.
+   */
+  std::size_t computeHash() const;
+
   /**
    * 	@brief Prints the transitive closure of the class hierarchy graph.
    */
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_POINTER_MAPPEDPOINTSTOGRAPH_H_
+#define PHASAR_PHASARLLVM_POINTER_MAPPEDPOINTSTOGRAPH_H_
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace llvm {
+class MemoryBuffer;
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+class ProjectIRDB;
+
+/// How a vertex of a points-to graph file refers to its value
+enum class MappedValueKind : uint32_t {
+  Instruction,
+  Argument,
+  Global,
+  Operand
+};
+
+/**
+ * An instruction is referred to by its id, an argument by the name of its
+ * function and its number, a global by its name and any other value by the
+ * id of an instruction using it and the operand number. Names are offsets
+ * into the string table.
+ *
+ * @brief Layout of a vertex of a points-to graph file.
+ */
+struct MappedPTGVertex {
+  uint64_t ID;
+  uint32_t Kind;
+  uint32_t Index;
+};
+
+/**
+ * A points-to graph file is written by PointsToGraph::exportAsBinary() and
+ * consists of the following arrays, each padded to eight bytes:
+ *
+ *   char              Magic[8]
+ *   uint64_t          Sizes[5]  (vertices, edges, components, string table,
+ *                                adjacencies)
+ *   MappedPTGVertex   Vertices[#vertices]
+ *   char              StringTable[#string table]
+ *   uint64_t          AdjacencyOffsets[#vertices + 1]
+ *   uint32_t          Adjacencies[#adjacencies]
+ *   uint32_t          ComponentOf[#vertices]
+ *   uint64_t          ComponentOffsets[#components + 1]
+ *   uint32_t          ComponentMembers[#vertices]
+ *
+ * The file is mapped into memory and the graph is read in place. Only the
+ * values the vertices refer to are resolved when the file is opened, which
+ * requires the ProjectIRDB the graph has been exported from, or one that has
+ * annotated the same ids. Points-to sets are stored as the components of the
+ * graph and are handed out without traversing it.
+ *
+ * @brief A read-only points-to graph that is mapped from a binary file.
+ */
+class MappedPointsToGraph {
+private:
+  std::unique_ptr<llvm::MemoryBuffer> Buffer;
+  const uint64_t *Sizes = nullptr;
+  const MappedPTGVertex *Vertices = nullptr;
+  const char *StringTable = nullptr;
+  const uint64_t *AdjacencyOffsets = nullptr;
+  const uint32_t *Adjacencies = nullptr;
+  const uint32_t *ComponentOf = nullptr;
+  const uint64_t *ComponentOffsets = nullptr;
+  const uint32_t *ComponentMembers = nullptr;
+  /// The values of the vertices
+  std::vector<const llvm::Value *> Values;
+  std::unordered_map<const llvm::Value *, uint32_t> ValueVertexMap;
+
+public:
+  /// Magic bytes at the start of a points-to graph file
+  static const char Magic[8];
+
+  /**
+   * @brief Maps the given file and resolves its values in the given IRDB.
+   * @throws std::ios_base::failure if the file cannot be read.
+   * @throws std::runtime_error if the file is malformed or refers to values
+   * that do not exist in the IRDB.
+   */
+  MappedPointsToGraph(ProjectIRDB &IRDB, const std::string &filename);
+
+  ~MappedPointsToGraph();
+
+  MappedPointsToGraph(const MappedPointsToGraph &) = delete;
+  MappedPointsToGraph &operator=(const MappedPointsToGraph &) = delete;
+
+  bool containsValue(const llvm::Value *V) const;
+
+  /**
+   * @brief Returns the values adjacent to the given pointer.
+   */
+  std::vector<const llvm::Value *>
+  getAdjacentValues(const llvm::Value *V) const;
+
+  /**
+   * @brief Computes the Points-to set for a given pointer.
+   */
+  std::set<const llvm::Value *> getPointsToSet(const llvm::Value *V) const;
+
+  unsigned getNumOfVertices() const;
+
+  unsigned getNumOfEdges() const;
+};
+
+} // namespace psr
+
+#endif
@@ -17,6 +17,10 @@
 #ifndef PHASAR_PHASARLLVM_POINTER_POINTSTOGRAPH_H_
 #define PHASAR_PHASARLLVM_POINTER_POINTSTOGRAPH_H_
 
+#include <memory>
+#include <shared_mutex>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/graph/adjacency_list.hpp>
@@ -95,6 +99,8 @@ class PointsToGraph {
 public:
   // Call-graph firends
   friend class LLVMBasedICFG;
+  // Restores points-to graphs from disk
+  friend class AnalysisCache;
   /**
    * 	@brief Holds the information of a vertex in the points-to graph.
    */
@@ -171,6 +177,39 @@ private:
   /// Keep track of what has already been merged into this points-to graph.
   std::set<std::string> ContainedFunctions;
 
+  /// Union-find forest over the vertices of ptg. Two vertices are in the same
+  /// set iff they are connected, i.e. iff they have the same points-to set.
+  std::vector<vertex_t> ComponentParents;
+  /// Number of vertices of a set, only valid for the sets' representatives.
+  std::vector<std::size_t> ComponentSizes;
+
+  /// Caches the points-to sets of the components that have been queried since
+  /// the graph has been changed the last time. Copies start with an empty
+  /// cache. Queries that hit the cache only share its lock.
+  struct PointsToSetCache {
+    std::shared_mutex mtx;
+    /// The vertices of each component, keyed by the component's
+    /// representative.
+    std::unordered_map<vertex_t, std::vector<vertex_t>> Members;
+    std::unordered_map<vertex_t,
+                       std::shared_ptr<const std::set<const llvm::Value *>>>
+        Sets;
+    PointsToSetCache() = default;
+    PointsToSetCache(const PointsToSetCache &) {}
+    PointsToSetCache &operator=(const PointsToSetCache &);
+    void clear();
+  };
+  PointsToSetCache PTSCache;
+
+  vertex_t findComponent(vertex_t V) const;
+  vertex_t compressComponent(vertex_t V);
+  void uniteComponents(vertex_t V, vertex_t U);
+  void rebuildComponents();
+  void appendComponents(const PointsToGraph &Other, std::size_t Offset);
+  void indexVertices(vertex_t From);
+  static std::vector<const llvm::Value *>
+  getReturnedValues(const llvm::Function *F);
+
 public:
   /**
    * Creates a points-to graph based on the computed Alias results.
@@ -182,9 +221,13 @@ public:
    * considered.
    *                              False, if May and Must Aliases should be
    * considered.
+   * @param partitionPointers True, if pointers should be partitioned by their
+   * underlying object before querying the alias analysis, avoiding the
+   * quadratic number of queries on functions with many pointers.
    */
   PointsToGraph(llvm::AAResults &AA, llvm::Function *F,
-                bool onlyConsiderMustAlias = false);
+                bool onlyConsiderMustAlias = false,
+                bool partitionPointers = false);
 
   /**
    * It is used when a points-to graph is restored from the database.
@@ -268,6 +311,16 @@ public:
    */
   std::set<const llvm::Value *> getPointsToSet(const llvm::Value *V);
 
+  /**
+   * Pointers that are connected in the points-to graph share a single set,
+   * which is cached until the graph is changed by one of the mergeWith()
+   * functions. May be called concurrently as long as the graph is not changed.
+   *
+   * @brief Returns the Points-to set for a given pointer without copying it.
+   */
+  std::shared_ptr<const std::set<const llvm::Value *>>
+  getSharedPointsToSet(const llvm::Value *V);
+
   // TODO add more detailed description
   inline bool representsSingleFunction();
   void mergeWith(const PointsToGraph &Other, const llvm::Function *F);
@@ -308,6 +361,16 @@ public:
    * @brief NOT YET IMPLEMENTED
    */
   json getAsJson();
+
+  /**
+   * Instructions are referred to by their annotated ids rather than their IR
+   * code, see MappedPointsToGraph for the layout.
+   *
+   * @brief Writes the points-to graph into a binary file, which can be
+   * memory-mapped by MappedPointsToGraph.
+   * @param filename Filename of the binary file.
+   */
+  void exportAsBinary(const std::string &filename) const;
 };
 
 } // namespace psr
@@ -17,6 +17,8 @@
 #ifndef PHASAR_UTILS_IO_H_
 #define PHASAR_UTILS_IO_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace psr {
@@ -25,6 +27,63 @@ std::string readFile(const std::string &path);
 
 void writeFile(const std::string &path, const std::string &content);
 
+/**
+ * Pads the buffer to a multiple of eight bytes afterwards, such that every
+ * array of a file that is memory-mapped as a whole is suitably aligned.
+ *
+ * @brief Appends an array of Size trivially copyable objects to Buffer.
+ */
+template <typename T>
+void appendAligned(std::string &Buffer, const T *Data, std::size_t Size) {
+  Buffer.append(reinterpret_cast<const char *>(Data), Size * sizeof(T));
+  Buffer.append((8 - Buffer.size() % 8) % 8, '\0');
+}
+
+/**
+ * Counterpart of appendAligned(). Buffer has to be aligned to eight bytes,
+ * which memory-mapped files are.
+ *
+ * @brief Returns the array of Size objects at Offset of Buffer without copying
+ * it and moves Offset behind it, or returns nullptr if the array exceeds the
+ * buffer.
+ */
+template <typename T>
+const T *getAligned(const char *Buffer, std::size_t BufferSize,
+                    std::size_t &Offset, std::size_t Size) {
+  std::size_t Bytes = Size * sizeof(T);
+  if (Offset > BufferSize || Size > BufferSize / sizeof(T) ||
+      Bytes > BufferSize - Offset) {
+    return nullptr;
+  }
+  const T *Array = reinterpret_cast<const T *>(Buffer + Offset);
+  Offset += Bytes + (8 - Bytes % 8) % 8;
+  return Array;
+}
+
+/**
+ * @brief Checks that the NumRows + 1 offsets of an array in compressed sparse
+ * row format read from a file cover exactly its NumEntries entries, and that
+ * every entry is less than NumTargets.
+ */
+inline bool isValidCSR(const uint64_t *Offsets, uint64_t NumRows,
+                       const uint32_t *Entries, uint64_t NumEntries,
+                       uint64_t NumTargets) {
+  if (Offsets[0] != 0 || Offsets[NumRows] != NumEntries) {
+    return false;
+  }
+  for (uint64_t Row = 0; Row < NumRows; ++Row) {
+    if (Offsets[Row] > Offsets[Row + 1]) {
+      return false;
+    }
+  }
+  for (uint64_t Idx = 0; Idx < NumEntries; ++Idx) {
+    if (Entries[Idx] >= NumTargets) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace psr
 
 #endif
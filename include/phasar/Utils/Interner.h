@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_INTERNER_H_
+#define PHASAR_UTILS_INTERNER_H_
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace psr {
+
+/**
+ * Assigns dense 32-bit ids to values of type T. The first value that is
+ * interned gets id 0, the next new value id 1, and so on. Ids can thus be
+ * used to index into vectors or be packed into compact keys.
+ */
+template <typename T> class Interner {
+private:
+  std::unordered_map<T, uint32_t> ids;
+  std::vector<T> values;
+
+public:
+  // returned by find() for values that have not been interned
+  static constexpr uint32_t None = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * Returns the id of the given value and assigns a new one if the value
+   * has not been interned before.
+   */
+  uint32_t intern(const T &value) {
+    auto search = ids.find(value);
+    if (search != ids.end()) {
+      return search->second;
+    }
+    uint32_t id = values.size();
+    ids.emplace(value, id);
+    values.push_back(value);
+    return id;
+  }
+
+  /**
+   * Returns the id of the given value or None if it has not been interned.
+   * Does not modify the interner and hence is safe to be called concurrently.
+   */
+  uint32_t find(const T &value) const {
+    auto search = ids.find(value);
+    return search != ids.end() ? search->second : None;
+  }
+
+  const T &get(uint32_t id) const { return values[id]; }
+
+  size_t size() const { return values.size(); }
+
+  bool empty() const { return values.empty(); }
+
+  void clear() {
+    ids.clear();
+    values.clear();
+  }
+};
+
+} // namespace psr
+
+#endif
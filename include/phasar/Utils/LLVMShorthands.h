@@ -189,6 +189,19 @@ std::size_t computeModuleHash(llvm::Module *M, bool considerIdentifier);
  */
 std::size_t computeModuleHash(const llvm::Module *M);
 
+/**
+ * @brief Computes a hash value for the code of a given LLVM Function.
+ * @note The code is hashed structurally, including the flags of instructions
+ * and the attributes of calls. Local values are identified by their position
+ * within the function, globals by their names, and metadata is ignored, such
+ * that the hash value neither depends on the addresses nor on the names of the
+ * function's values and does not change when the function's module is
+ * reloaded.
+ * @param F LLVM Function.
+ * @return Hash value.
+ */
+std::size_t computeFunctionHash(const llvm::Function *F);
+
 } // namespace psr
 
 #endif
@@ -55,9 +55,11 @@ std::ostream &operator<<(std::ostream &os, enum severity_level l);
   }
 
 // Register the logger and use it a singleton then, get the logger with:
-// bl::sources::severity_logger<severity_level>& lg = lg::get();
+// bl::sources::severity_logger_mt<severity_level>& lg = lg::get();
+// The thread-safe logger is required, since the solvers and the IR
+// preprocessing log from several threads at once.
 BOOST_LOG_INLINE_GLOBAL_LOGGER_DEFAULT(
-    lg, bl::sources::severity_logger<severity_level>)
+    lg, bl::sources::severity_logger_mt<severity_level>)
 // The logger can also be used as a global variable, which is not recommended.
 // In such a case a global variable would be created like in the following
 // bl::sources::severity_logger<int> lg;
@@ -0,0 +1,204 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_SHARDEDLRUCACHE_H_
+#define PHASAR_UTILS_SHARDEDLRUCACHE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+inline size_t hashCombine(size_t seed, size_t h) {
+  return seed ^ (h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+/**
+ * Hashes cache keys that are composed of std::tuple and std::set from the
+ * std::hash values of their elements.
+ */
+template <typename T> struct CacheKeyHash {
+  size_t operator()(const T &t) const { return std::hash<T>()(t); }
+};
+
+template <typename T> struct CacheKeyHash<std::set<T>> {
+  size_t operator()(const std::set<T> &s) const {
+    size_t seed = s.size();
+    for (const auto &e : s) {
+      seed = hashCombine(seed, CacheKeyHash<T>()(e));
+    }
+    return seed;
+  }
+};
+
+template <typename... Ts> struct CacheKeyHash<std::tuple<Ts...>> {
+  size_t operator()(const std::tuple<Ts...> &t) const {
+    return std::apply(
+        [](const Ts &... es) {
+          size_t seed = 0;
+          ((seed = hashCombine(seed, CacheKeyHash<Ts>()(es))), ...);
+          return seed;
+        },
+        t);
+  }
+};
+
+/**
+ * A thread-safe key-value cache that is split into a number of independently
+ * locked shards, such that threads that query different keys rarely contend.
+ * The hash of a key is computed once per query and is used both to select the
+ * shard and to probe the shard's hash table.
+ *
+ * If a capacity is given, every shard holds at most capacity / #shards
+ * entries (but at least one) and evicts its least recently used entry when a
+ * new one is inserted into a full shard. A capacity of 0 means unbounded.
+ */
+template <typename K, typename V, typename Hash = CacheKeyHash<K>>
+class ShardedLRUCache {
+private:
+  struct HashedKey {
+    size_t hash;
+    K key;
+    bool operator==(const HashedKey &other) const {
+      return hash == other.hash && key == other.key;
+    }
+  };
+
+  struct HashedKeyHash {
+    size_t operator()(const HashedKey &k) const { return k.hash; }
+  };
+
+  // entries are kept in recency order, the most recently used one first
+  using EntryList = std::list<std::pair<HashedKey, V>>;
+
+  struct Shard {
+    std::mutex mtx;
+    EntryList entries;
+    std::unordered_map<HashedKey, typename EntryList::iterator, HashedKeyHash>
+        index;
+  };
+
+  std::vector<std::unique_ptr<Shard>> shards;
+  size_t shardCapacity;
+
+  HashedKey makeKey(const K &key) const { return {Hash()(key), key}; }
+
+  Shard &shardFor(const HashedKey &k) const {
+    // the low bits select the bucket within the shard, so use the high ones
+    uint64_t mixed = static_cast<uint64_t>(k.hash) * 0x9e3779b97f4a7c15ULL;
+    return *shards[(mixed >> 32) % shards.size()];
+  }
+
+public:
+  ShardedLRUCache(size_t numShards = 1, size_t capacity = 0) {
+    numShards = std::max<size_t>(numShards, 1);
+    for (size_t i = 0; i < numShards; ++i) {
+      shards.push_back(std::make_unique<Shard>());
+    }
+    shardCapacity =
+        (capacity == 0) ? 0 : std::max<size_t>(capacity / numShards, 1);
+  }
+
+  ~ShardedLRUCache() = default;
+
+  ShardedLRUCache(const ShardedLRUCache &) = delete;
+
+  ShardedLRUCache &operator=(const ShardedLRUCache &) = delete;
+
+  /**
+   * Returns the value cached for the given key, if any, and marks it as the
+   * most recently used entry of its shard.
+   */
+  std::optional<V> lookup(const K &key) {
+    HashedKey k = makeKey(key);
+    Shard &shard = shardFor(k);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    auto search = shard.index.find(k);
+    if (search == shard.index.end()) {
+      return std::nullopt;
+    }
+    shard.entries.splice(shard.entries.begin(), shard.entries,
+                         search->second);
+    return search->second->second;
+  }
+
+  /**
+   * Caches the value for the given key unless some value has been cached for
+   * it in the meantime. Returns the value that is cached for the key, so that
+   * all threads that race on constructing a value use the same one.
+   */
+  V insert(const K &key, V value) {
+    return insertWith(key, [&value]() { return std::move(value); });
+  }
+
+  /**
+   * Like insert(), but obtains the value from makeValue() only if no value
+   * is cached for the key yet, e.g. if the value must not be registered
+   * anywhere unless it is actually cached. makeValue() is called while the
+   * key's shard is locked, hence it must be cheap and must not use the cache.
+   */
+  template <typename MakeValue>
+  V insertWith(const K &key, MakeValue makeValue) {
+    HashedKey k = makeKey(key);
+    Shard &shard = shardFor(k);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    auto search = shard.index.find(k);
+    if (search != shard.index.end()) {
+      return search->second->second;
+    }
+    if (shardCapacity != 0 && shard.index.size() >= shardCapacity) {
+      shard.index.erase(shard.entries.back().first);
+      shard.entries.pop_back();
+    }
+    shard.entries.emplace_front(std::move(k), makeValue());
+    shard.index.emplace(shard.entries.front().first, shard.entries.begin());
+    return shard.entries.front().second;
+  }
+
+  bool contains(const K &key) const {
+    HashedKey k = makeKey(key);
+    Shard &shard = shardFor(k);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    return shard.index.count(k);
+  }
+
+  size_t size() const {
+    size_t result = 0;
+    for (auto &shard : shards) {
+      std::lock_guard<std::mutex> lock(shard->mtx);
+      result += shard->index.size();
+    }
+    return result;
+  }
+
+  void clear() {
+    for (auto &shard : shards) {
+      std::lock_guard<std::mutex> lock(shard->mtx);
+      shard->index.clear();
+      shard->entries.clear();
+    }
+  }
+
+  size_t getNumShards() const { return shards.size(); }
+};
+
+} // namespace psr
+
+#endif
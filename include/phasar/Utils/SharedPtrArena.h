@@ -0,0 +1,175 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_SHAREDPTRARENA_H_
+#define PHASAR_UTILS_SHAREDPTRARENA_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace psr {
+
+/**
+ * A non-owning reference to an object that is owned by a SharedPtrArena.
+ * Copying a handle copies a single pointer and, unlike copying a
+ * std::shared_ptr, does not touch an atomic reference count. A handle is
+ * valid until its arena is cleared or destroyed. Handles compare equal if
+ * they refer to the same object.
+ */
+template <typename T> class ArenaHandle {
+private:
+  const std::shared_ptr<T> *slot = nullptr;
+
+public:
+  ArenaHandle() = default;
+  explicit ArenaHandle(const std::shared_ptr<T> *slot) : slot(slot) {}
+
+  T *get() const { return slot ? slot->get() : nullptr; }
+  T *operator->() const { return slot->get(); }
+  T &operator*() const { return **slot; }
+  explicit operator bool() const { return get() != nullptr; }
+
+  /**
+   * Returns the owning pointer, e.g. to pass the object to an interface that
+   * expects a std::shared_ptr.
+   */
+  const std::shared_ptr<T> &shared() const { return *slot; }
+
+  friend bool operator==(const ArenaHandle &lhs, const ArenaHandle &rhs) {
+    return lhs.get() == rhs.get();
+  }
+  friend bool operator!=(const ArenaHandle &lhs, const ArenaHandle &rhs) {
+    return lhs.get() != rhs.get();
+  }
+  friend bool operator<(const ArenaHandle &lhs, const ArenaHandle &rhs) {
+    return std::less<T *>()(lhs.get(), rhs.get());
+  }
+};
+
+/**
+ * Keeps objects that are handed out as std::shared_ptr alive for the lifetime
+ * of the arena and gives out ArenaHandles to them. The owning pointers are
+ * bump-allocated in chunks and released in bulk by clear() or when the arena
+ * is destroyed. An object that is adopted again is not stored a second time,
+ * such that objects that are shared or interned by their producer occupy a
+ * single slot no matter how often they are adopted.
+ *
+ * A concurrent arena is split into a number of independently locked shards
+ * and an object is stored by the shard its address maps to, such that threads
+ * that adopt different objects rarely contend.
+ */
+template <typename T> class SharedPtrArena {
+private:
+  static constexpr size_t ChunkSize = 4096;
+
+  struct Shard {
+    std::mutex mtx;
+    std::vector<std::unique_ptr<std::shared_ptr<T>[]>> chunks;
+    // index of the next free slot in the last chunk
+    size_t next = ChunkSize;
+    // slot of every object adopted by the shard
+    std::unordered_map<const T *, const std::shared_ptr<T> *> slots;
+  };
+
+  std::vector<std::unique_ptr<Shard>> shards;
+  bool concurrent;
+  // the (only) slot holding a null pointer
+  const std::shared_ptr<T> nullSlot;
+
+  Shard &shardFor(const T *object) {
+    // the low bits of an address are mostly zero, so use the high ones
+    uint64_t mixed =
+        static_cast<uint64_t>(reinterpret_cast<uintptr_t>(object)) *
+        0x9e3779b97f4a7c15ULL;
+    return *shards[(mixed >> 32) % shards.size()];
+  }
+
+public:
+  SharedPtrArena(bool concurrent = false, size_t numShards = 1)
+      : concurrent(concurrent) {
+    numShards = concurrent ? std::max<size_t>(numShards, 1) : 1;
+    for (size_t i = 0; i < numShards; ++i) {
+      shards.push_back(std::make_unique<Shard>());
+    }
+  }
+
+  ~SharedPtrArena() = default;
+
+  SharedPtrArena(const SharedPtrArena &) = delete;
+
+  SharedPtrArena &operator=(const SharedPtrArena &) = delete;
+
+  /**
+   * Takes (shared) ownership of the given object and returns a handle to it.
+   * Thread-safe if the arena has been created as concurrent.
+   */
+  ArenaHandle<T> adopt(std::shared_ptr<T> object) {
+    if (!object) {
+      return ArenaHandle<T>(&nullSlot);
+    }
+    Shard &shard = shardFor(object.get());
+    std::unique_lock<std::mutex> lock;
+    if (concurrent) {
+      lock = std::unique_lock<std::mutex>(shard.mtx);
+    }
+    auto inserted = shard.slots.try_emplace(object.get(), nullptr);
+    if (!inserted.second) {
+      return ArenaHandle<T>(inserted.first->second);
+    }
+    if (shard.next == ChunkSize) {
+      shard.chunks.push_back(std::make_unique<std::shared_ptr<T>[]>(ChunkSize));
+      shard.next = 0;
+    }
+    std::shared_ptr<T> *slot = &shard.chunks.back()[shard.next++];
+    *slot = std::move(object);
+    inserted.first->second = slot;
+    return ArenaHandle<T>(slot);
+  }
+
+  /**
+   * Returns the number of distinct objects that have been adopted. Must not
+   * be called while other threads adopt objects.
+   */
+  size_t size() const {
+    size_t result = 0;
+    for (const auto &shard : shards) {
+      result += shard->slots.size();
+    }
+    return result;
+  }
+
+  /**
+   * Releases all objects at once. All handles become invalid.
+   */
+  void clear() {
+    for (auto &shard : shards) {
+      shard->slots.clear();
+      shard->chunks.clear();
+      shard->next = ChunkSize;
+    }
+  }
+};
+
+} // namespace psr
+
+namespace std {
+template <typename T> struct hash<psr::ArenaHandle<T>> {
+  size_t operator()(const psr::ArenaHandle<T> &h) const {
+    return std::hash<T *>()(h.get());
+  }
+};
+} // namespace std
+
+#endif
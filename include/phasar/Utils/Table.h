@@ -134,11 +134,12 @@ public:
     return columnmap;
   }
 
-  bool contains(R rowKey, C columnKey) {
+  bool contains(R rowKey, C columnKey) const {
     // Returns true if the table contains a mapping with the specified row and
     // column keys.
-    if (table.count(rowKey))
-      return table[rowKey].count(columnKey);
+    auto search = table.find(rowKey);
+    if (search != table.end())
+      return search->second.count(columnKey);
     return false;
   }
 
@@ -170,6 +171,13 @@ public:
     return table[rowKey][columnKey];
   }
 
+  const V &get(R rowKey, C columnKey) const {
+    // Returns the value corresponding to the given row and column keys. Does
+    // not modify the table and hence is safe to be called concurrently; the
+    // mapping must exist.
+    return table.at(rowKey).at(columnKey);
+  }
+
   V remove(R rowKey, C columnKey) {
     // Removes the mapping, if any, associated with the given keys.
     V v = table[rowKey][columnKey];
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_WORKSTEALINGSCHEDULER_H_
+#define PHASAR_UTILS_WORKSTEALINGSCHEDULER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace psr {
+
+/**
+ * Processes work items on a fixed number of threads until no work is left.
+ *
+ * Every worker owns a deque of pending items. Items that are pushed by a
+ * worker (i.e. from within the task) are added to the worker's own deque,
+ * which it processes in LIFO order to keep its working set small. A worker
+ * that runs out of work steals the oldest item of another worker's deque.
+ * Items that are pushed from outside of run() are distributed round-robin.
+ *
+ * run() returns as soon as all deques are empty and no task is executing
+ * anymore. If a task throws, the remaining work is abandoned and the first
+ * exception is rethrown by run().
+ */
+template <typename T> class WorkStealingScheduler {
+private:
+  struct WorkerQueue {
+    std::mutex mtx;
+    std::deque<T> items;
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  std::function<void(T)> task;
+  // number of items that have been pushed but not yet completely processed
+  std::atomic<size_t> pending{0};
+  std::atomic<bool> aborted{false};
+  std::atomic<size_t> nextQueue{0};
+  std::exception_ptr error;
+  std::mutex errorMtx;
+
+  // the scheduler and worker id of the current thread
+  static thread_local WorkStealingScheduler *currentScheduler;
+  static thread_local size_t currentWorker;
+
+  std::optional<T> popLocal(size_t id) {
+    std::lock_guard<std::mutex> lock(queues[id]->mtx);
+    if (queues[id]->items.empty()) {
+      return std::nullopt;
+    }
+    std::optional<T> item(std::move(queues[id]->items.back()));
+    queues[id]->items.pop_back();
+    return item;
+  }
+
+  std::optional<T> steal(size_t id) {
+    for (size_t i = 1; i < queues.size(); ++i) {
+      WorkerQueue &victim = *queues[(id + i) % queues.size()];
+      std::lock_guard<std::mutex> lock(victim.mtx);
+      if (!victim.items.empty()) {
+        std::optional<T> item(std::move(victim.items.front()));
+        victim.items.pop_front();
+        return item;
+      }
+    }
+    return std::nullopt;
+  }
+
+  void work(size_t id) {
+    WorkStealingScheduler *prevScheduler = currentScheduler;
+    size_t prevWorker = currentWorker;
+    currentScheduler = this;
+    currentWorker = id;
+    while (!aborted) {
+      std::optional<T> item = popLocal(id);
+      if (!item) {
+        item = steal(id);
+      }
+      if (item) {
+        try {
+          task(std::move(*item));
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(errorMtx);
+          if (!error) {
+            error = std::current_exception();
+          }
+          aborted = true;
+        }
+        --pending;
+      } else if (pending == 0) {
+        break;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    currentScheduler = prevScheduler;
+    currentWorker = prevWorker;
+  }
+
+public:
+  WorkStealingScheduler(unsigned numThreads, std::function<void(T)> task)
+      : task(task) {
+    for (unsigned i = 0; i < std::max(numThreads, 1u); ++i) {
+      queues.push_back(std::make_unique<WorkerQueue>());
+    }
+  }
+
+  ~WorkStealingScheduler() = default;
+
+  WorkStealingScheduler(const WorkStealingScheduler &) = delete;
+
+  WorkStealingScheduler &operator=(const WorkStealingScheduler &) = delete;
+
+  /**
+   * Adds an item that has to be processed. May be called concurrently from
+   * any thread, in particular from within the task.
+   */
+  void push(T item) {
+    size_t id = (currentScheduler == this)
+                    ? currentWorker
+                    : nextQueue.fetch_add(1) % queues.size();
+    ++pending;
+    std::lock_guard<std::mutex> lock(queues[id]->mtx);
+    queues[id]->items.push_back(std::move(item));
+  }
+
+  /**
+   * Processes all pushed items, including the ones pushed while processing,
+   * and blocks until no work is left.
+   */
+  void run() {
+    aborted = false;
+    std::vector<std::thread> threads;
+    for (size_t id = 1; id < queues.size(); ++id) {
+      threads.emplace_back(&WorkStealingScheduler::work, this, id);
+    }
+    work(0);
+    for (auto &t : threads) {
+      t.join();
+    }
+    if (error) {
+      for (auto &q : queues) {
+        q->items.clear();
+      }
+      pending = 0;
+      std::exception_ptr e = error;
+      error = nullptr;
+      std::rethrow_exception(e);
+    }
+  }
+
+  size_t getNumThreads() const { return queues.size(); }
+};
+
+template <typename T>
+thread_local WorkStealingScheduler<T>
+    *WorkStealingScheduler<T>::currentScheduler = nullptr;
+
+template <typename T>
+thread_local size_t WorkStealingScheduler<T>::currentWorker = 0;
+
+} // namespace psr
+
+#endif
@@ -37,6 +37,7 @@
 #include <phasar/PhasarLLVM/IfdsIde/Problems/IFDSUninitializedVariables.h>
 #include <phasar/PhasarLLVM/IfdsIde/Solver/LLVMIDESolver.h>
 #include <phasar/PhasarLLVM/IfdsIde/Solver/LLVMIFDSSolver.h>
+#include <phasar/PhasarLLVM/IfdsIde/SolverConfiguration.h>
 #include <phasar/PhasarLLVM/Mono/Contexts/CallString.h>
 #include <phasar/PhasarLLVM/Mono/Problems/InterMonoSolverTest.h>
 #include <phasar/PhasarLLVM/Mono/Problems/InterMonoTaintAnalysis.h>
@@ -64,6 +65,15 @@ std::ostream &operator<<(std::ostream &os, const ExportType &E) {
   return os << ExportTypeToString.at(E);
 }
 
+// Applies the solver options given on the command line to a tabulation
+// problem, which must happen before the problem's solver is constructed.
+template <typename ProblemTy>
+static void configureSolver(ProblemTy &Problem, unsigned NumThreads,
+                            WorklistOrder Order) {
+  Problem.solver_config.numThreads = NumThreads;
+  Problem.solver_config.worklistOrder = Order;
+}
+
 AnalysisController::AnalysisController(
     ProjectIRDB &&IRDB, std::vector<DataFlowAnalysisType> Analyses,
     bool WPA_MODE, bool PrintEdgeRecorder, std::string graph_id)
@@ -99,6 +109,19 @@ AnalysisController::AnalysisController(
       EntryPoints = VariablesMap["entry-points"].as<vector<string>>();
     }
   }
+  unsigned NumThreads = VariablesMap.count("threads")
+                            ? VariablesMap["threads"].as<unsigned>()
+                            : 1;
+  WorklistOrder Order = VariablesMap.count("worklist-order")
+                            ? StringToWorklistOrder.at(
+                                  VariablesMap["worklist-order"].as<string>())
+                            : WorklistOrder::lifo;
+  if (NumThreads > 1 && Order == WorklistOrder::priority) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, WARNING)
+                  << "The priority worklist order is not supported by the "
+                     "parallel solver, falling back to lifo.");
+    Order = WorklistOrder::lifo;
+  }
   if (WPA_MODE) {
     // here we link every llvm module into a single module containing the entire
     // IR
@@ -112,7 +135,7 @@ AnalysisController::AnalysisController(
         BOOST_LOG_SEV(lg, INFO)
         << "link all llvm modules into a single module for WPA ended\n");
   }
-  IRDB.preprocessIR();
+  IRDB.preprocessIR(NumThreads);
 
   // START_TIMER("DB Start Up", PAMM_SEVERITY_LEVEL::Full);
   // DBConn &db = DBConn::getInstance();
@@ -166,7 +189,7 @@ AnalysisController::AnalysisController(
   // Perform whole program analysis (WPA) analysis
   if (WPA_MODE) {
     START_TIMER("CG Construction", PAMM_SEVERITY_LEVEL::Core);
-    LLVMBasedICFG ICFG(CH, IRDB, CGType, EntryPoints);
+    LLVMBasedICFG ICFG(CH, IRDB, CGType, EntryPoints, NumThreads);
 
     if (VariablesMap.count("callgraph-plugin")) {
       throw runtime_error("callgraph plugin not found");
@@ -198,6 +221,7 @@ AnalysisController::AnalysisController(
       case DataFlowAnalysisType::IFDS_TaintAnalysis: {
         TaintSensitiveFunctions TSF;
         IFDSTaintAnalysis TaintAnalysisProblem(ICFG, TSF, EntryPoints);
+        configureSolver(TaintAnalysisProblem, NumThreads, Order);
         LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> LLVMTaintSolver(
             TaintAnalysisProblem, false);
         cout << "IFDS Taint Analysis ..." << endl;
@@ -211,6 +235,7 @@ AnalysisController::AnalysisController(
       }
       case DataFlowAnalysisType::IDE_TaintAnalysis: {
         IDETaintAnalysis taintanalysisproblem(ICFG, EntryPoints);
+        configureSolver(taintanalysisproblem, NumThreads, Order);
         LLVMIDESolver<const llvm::Value *, const llvm::Value *, LLVMBasedICFG &>
             llvmtaintsolver(taintanalysisproblem, true);
         llvmtaintsolver.solve();
@@ -223,6 +248,7 @@ AnalysisController::AnalysisController(
       case DataFlowAnalysisType::IDE_TypeStateAnalysis: {
         IDETypeStateAnalysis typestateproblem(ICFG, "struct._IO_FILE",
                                               EntryPoints);
+        configureSolver(typestateproblem, NumThreads, Order);
         LLVMIDESolver<const llvm::Value *, State, LLVMBasedICFG &>
             llvmtypestatesolver(typestateproblem, true);
         llvmtypestatesolver.solve();
@@ -234,6 +260,7 @@ AnalysisController::AnalysisController(
       }
       case DataFlowAnalysisType::IFDS_TypeAnalysis: {
         IFDSTypeAnalysis typeanalysisproblem(ICFG, EntryPoints);
+        configureSolver(typeanalysisproblem, NumThreads, Order);
         LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> llvmtypesolver(
             typeanalysisproblem, true);
         llvmtypesolver.solve();
@@ -245,6 +272,7 @@ AnalysisController::AnalysisController(
       }
       case DataFlowAnalysisType::IFDS_UninitializedVariables: {
         IFDSUnitializedVariables uninitializedvarproblem(ICFG, EntryPoints);
+        configureSolver(uninitializedvarproblem, NumThreads, Order);
         LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> llvmunivsolver(
             uninitializedvarproblem, false);
         cout << "IFDS UninitVar Analysis ..." << endl;
@@ -258,6 +286,7 @@ AnalysisController::AnalysisController(
       }
       case DataFlowAnalysisType::IFDS_LinearConstantAnalysis: {
         IFDSLinearConstantAnalysis lcaproblem(ICFG, EntryPoints);
+        configureSolver(lcaproblem, NumThreads, Order);
         LLVMIFDSSolver<LCAPair, LLVMBasedICFG &> llvmlcasolver(lcaproblem,
                                                                true);
         llvmlcasolver.solve();
@@ -269,6 +298,7 @@ AnalysisController::AnalysisController(
       }
       case DataFlowAnalysisType::IDE_LinearConstantAnalysis: {
         IDELinearConstantAnalysis lcaproblem(ICFG, EntryPoints);
+        configureSolver(lcaproblem, NumThreads, Order);
         LLVMIDESolver<const llvm::Value *, int64_t, LLVMBasedICFG &>
             llvmlcasolver(lcaproblem, true);
         llvmlcasolver.solve();
@@ -281,6 +311,7 @@ AnalysisController::AnalysisController(
       case DataFlowAnalysisType::IFDS_ConstAnalysis: {
         IFDSConstAnalysis constproblem(ICFG, IRDB.getAllMemoryLocations(),
                                        EntryPoints);
+        configureSolver(constproblem, NumThreads, Order);
         LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> llvmconstsolver(
             constproblem, true);
         llvmconstsolver.solve();
@@ -292,6 +323,7 @@ AnalysisController::AnalysisController(
       }
       case DataFlowAnalysisType::IFDS_SolverTest: {
         IFDSSolverTest ifdstest(ICFG, EntryPoints);
+        configureSolver(ifdstest, NumThreads, Order);
         LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> llvmifdstestsolver(
             ifdstest, false);
         cout << "IFDS Solvertest ..." << endl;
@@ -305,6 +337,7 @@ AnalysisController::AnalysisController(
       }
       case DataFlowAnalysisType::IDE_SolverTest: {
         IDESolverTest idetest(ICFG, EntryPoints);
+        configureSolver(idetest, NumThreads, Order);
         LLVMIDESolver<const llvm::Value *, const llvm::Value *, LLVMBasedICFG &>
             llvmidetestsolver(idetest, true);
         llvmidetestsolver.solve();
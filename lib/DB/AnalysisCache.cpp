@@ -0,0 +1,313 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/log/sources/record_ostream.hpp>
+
+#include <phasar/DB/AnalysisCache.h>
+#include <phasar/PhasarLLVM/Pointer/PointsToGraph.h>
+#include <phasar/Utils/IO.h>
+#include <phasar/Utils/Logger.h>
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+// Has to be changed whenever the layout of an entry changes
+static const string PTGEntryMagic = "PSRPTG01";
+
+// How a value of a points-to graph is identified relative to its function
+enum class CachedValueKind : uint32_t {
+  Instruction,
+  Argument,
+  Global,
+  Operand
+};
+
+static void writeU32(string &Buffer, uint32_t X) {
+  Buffer.append(reinterpret_cast<const char *>(&X), sizeof(X));
+}
+
+static void writeString(string &Buffer, const string &S) {
+  writeU32(Buffer, S.size());
+  Buffer.append(S);
+}
+
+static bool readU32(const string &Buffer, size_t &Pos, uint32_t &X) {
+  if (Buffer.size() - Pos < sizeof(X)) {
+    return false;
+  }
+  memcpy(&X, Buffer.data() + Pos, sizeof(X));
+  Pos += sizeof(X);
+  return true;
+}
+
+static bool readString(const string &Buffer, size_t &Pos, string &S) {
+  uint32_t Size;
+  if (!readU32(Buffer, Pos, Size) || Buffer.size() - Pos < Size) {
+    return false;
+  }
+  S.assign(Buffer, Pos, Size);
+  Pos += Size;
+  return true;
+}
+
+AnalysisCache::AnalysisCache(const string &CacheDirectory,
+                             const string &Configuration)
+    : CacheDirectory(CacheDirectory), Configuration(Configuration) {
+  boost::filesystem::create_directories(CacheDirectory);
+}
+
+string AnalysisCache::getEntryPath(const string &ModuleHash,
+                                   const string &Extension) const {
+  return (boost::filesystem::path(CacheDirectory) /
+          (ModuleHash + "." + Extension))
+      .string();
+}
+
+string AnalysisCache::getModuleHash(const llvm::Module &M) const {
+  string Bitcode;
+  llvm::raw_string_ostream RSO(Bitcode);
+  llvm::WriteBitcodeToFile(&M, RSO);
+  RSO.flush();
+  llvm::MD5 Hash;
+  // the lengths keep the parts apart
+  string Key;
+  writeString(Key, PTGEntryMagic);
+  writeString(Key, Configuration);
+  Hash.update(Key);
+  Hash.update(Bitcode);
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  llvm::SmallString<32> Digest;
+  llvm::MD5::stringifyResult(Result, Digest);
+  return Digest.str().str();
+}
+
+bool AnalysisCache::loadPointsToGraphs(
+    const llvm::Module &M, const string &ModuleHash,
+    map<string, unique_ptr<PointsToGraph>> &PTGs) const {
+  string Path = getEntryPath(ModuleHash, "ptg");
+  if (!boost::filesystem::exists(Path)) {
+    return false;
+  }
+  string Buffer;
+  try {
+    Buffer = readFile(Path);
+  } catch (const ios_base::failure &) {
+    return false;
+  }
+  if (Buffer.compare(0, PTGEntryMagic.size(), PTGEntryMagic) != 0) {
+    return false;
+  }
+  size_t Pos = PTGEntryMagic.size();
+  // Nothing is handed out unless the whole entry could be restored
+  map<string, unique_ptr<PointsToGraph>> Restored;
+  uint32_t NumFunctions;
+  if (!readU32(Buffer, Pos, NumFunctions)) {
+    return false;
+  }
+  for (uint32_t FIdx = 0; FIdx < NumFunctions; ++FIdx) {
+    string FunctionName;
+    if (!readString(Buffer, Pos, FunctionName)) {
+      return false;
+    }
+    const llvm::Function *F = M.getFunction(FunctionName);
+    if (!F || F->isDeclaration()) {
+      return false;
+    }
+    vector<const llvm::Instruction *> Instructions;
+    for (auto I = llvm::inst_begin(F), E = llvm::inst_end(F); I != E; ++I) {
+      Instructions.push_back(&*I);
+    }
+    unique_ptr<PointsToGraph> PTG(
+        new PointsToGraph(vector<string>{FunctionName}));
+    uint32_t NumVertices;
+    if (!readU32(Buffer, Pos, NumVertices)) {
+      return false;
+    }
+    for (uint32_t VIdx = 0; VIdx < NumVertices; ++VIdx) {
+      uint32_t Kind, Idx, OpIdx;
+      string GlobalName;
+      const llvm::Value *V = nullptr;
+      if (!readU32(Buffer, Pos, Kind)) {
+        return false;
+      }
+      switch (static_cast<CachedValueKind>(Kind)) {
+      case CachedValueKind::Instruction:
+        if (readU32(Buffer, Pos, Idx) && Idx < Instructions.size()) {
+          V = Instructions[Idx];
+        }
+        break;
+      case CachedValueKind::Argument:
+        if (readU32(Buffer, Pos, Idx) && Idx < F->arg_size()) {
+          V = &*std::next(F->arg_begin(), Idx);
+        }
+        break;
+      case CachedValueKind::Global:
+        if (readString(Buffer, Pos, GlobalName)) {
+          V = M.getNamedValue(GlobalName);
+        }
+        break;
+      case CachedValueKind::Operand:
+        if (readU32(Buffer, Pos, Idx) && readU32(Buffer, Pos, OpIdx) &&
+            Idx < Instructions.size() &&
+            OpIdx < Instructions[Idx]->getNumOperands()) {
+          V = Instructions[Idx]->getOperand(OpIdx);
+        }
+        break;
+      }
+      if (!V) {
+        return false;
+      }
+      auto Vertex = boost::add_vertex(PTG->ptg);
+      PTG->ptg[Vertex] = PointsToGraph::VertexProperties(V);
+    }
+    PTG->indexVertices(0);
+    uint32_t NumEdges;
+    if (!readU32(Buffer, Pos, NumEdges)) {
+      return false;
+    }
+    for (uint32_t EIdx = 0; EIdx < NumEdges; ++EIdx) {
+      uint32_t Source, Target;
+      if (!readU32(Buffer, Pos, Source) || !readU32(Buffer, Pos, Target) ||
+          Source >= NumVertices || Target >= NumVertices) {
+        return false;
+      }
+      boost::add_edge(Source, Target, PTG->ptg);
+    }
+    PTG->rebuildComponents();
+    Restored[FunctionName] = std::move(PTG);
+  }
+  if (Pos != Buffer.size()) {
+    return false;
+  }
+  for (auto &Entry : Restored) {
+    PTGs[Entry.first] = std::move(Entry.second);
+  }
+  return true;
+}
+
+void AnalysisCache::storePointsToGraphs(
+    const llvm::Module &M, const string &ModuleHash,
+    const map<string, const PointsToGraph *> &PTGs) const {
+  auto &lg = lg::get();
+  string Functions;
+  uint32_t NumFunctions = 0;
+  for (auto &Entry : PTGs) {
+    const llvm::Function *F = M.getFunction(Entry.first);
+    if (!Entry.second || !F || F->isDeclaration()) {
+      continue;
+    }
+    // Number the instructions of F and remember an instruction that uses each
+    // of the other values as an operand, e.g. constant expressions.
+    unordered_map<const llvm::Value *, uint32_t> InstructionIdx;
+    unordered_map<const llvm::Value *, pair<uint32_t, uint32_t>> OperandIdx;
+    uint32_t Idx = 0;
+    for (auto I = llvm::inst_begin(F), E = llvm::inst_end(F); I != E;
+         ++I, ++Idx) {
+      InstructionIdx[&*I] = Idx;
+      for (unsigned OpIdx = 0; OpIdx < I->getNumOperands(); ++OpIdx) {
+        OperandIdx.insert(
+            make_pair(I->getOperand(OpIdx), make_pair(Idx, OpIdx)));
+      }
+    }
+    const PointsToGraph::graph_t &G = Entry.second->ptg;
+    string Function;
+    writeString(Function, Entry.first);
+    writeU32(Function, boost::num_vertices(G));
+    bool Encoded = true;
+    for (PointsToGraph::vertex_t V = 0; V < boost::num_vertices(G) && Encoded;
+         ++V) {
+      const llvm::Value *Value = G[V].value;
+      auto Inst = InstructionIdx.find(Value);
+      auto Op = OperandIdx.find(Value);
+      auto A = llvm::dyn_cast<llvm::Argument>(Value);
+      if (Inst != InstructionIdx.end()) {
+        writeU32(Function, static_cast<uint32_t>(CachedValueKind::Instruction));
+        writeU32(Function, Inst->second);
+      } else if (A && A->getParent() == F) {
+        writeU32(Function, static_cast<uint32_t>(CachedValueKind::Argument));
+        writeU32(Function, A->getArgNo());
+      } else if (llvm::isa<llvm::GlobalValue>(Value) && Value->hasName()) {
+        writeU32(Function, static_cast<uint32_t>(CachedValueKind::Global));
+        writeString(Function, Value->getName().str());
+      } else if (!llvm::isa<llvm::Instruction>(Value) && !A &&
+                 Op != OperandIdx.end()) {
+        writeU32(Function, static_cast<uint32_t>(CachedValueKind::Operand));
+        writeU32(Function, Op->second.first);
+        writeU32(Function, Op->second.second);
+      } else {
+        // an instruction or argument of another function
+        Encoded = false;
+      }
+    }
+    if (!Encoded) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
+                    << "Points-to graph of " << Entry.first
+                    << " does not belong to module "
+                    << M.getModuleIdentifier() << ", not cached");
+      continue;
+    }
+    writeU32(Function, boost::num_edges(G));
+    boost::graph_traits<PointsToGraph::graph_t>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = boost::edges(G); ei != ei_end; ++ei) {
+      writeU32(Function, boost::source(*ei, G));
+      writeU32(Function, boost::target(*ei, G));
+    }
+    Functions.append(Function);
+    ++NumFunctions;
+  }
+  string Buffer = PTGEntryMagic;
+  writeU32(Buffer, NumFunctions);
+  Buffer.append(Functions);
+  // Write to a temporary file first, such that concurrent runs on the same
+  // cache never observe a partially written entry.
+  boost::filesystem::path Path(getEntryPath(ModuleHash, "ptg"));
+  boost::filesystem::path TmpPath =
+      boost::filesystem::unique_path(Path.string() + ".%%%%-%%%%");
+  {
+    ofstream ofs(TmpPath.string(), ios::binary);
+    if (ofs.is_open()) {
+      ofs.write(Buffer.data(), Buffer.size());
+    }
+    if (!ofs) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, WARNING)
+                    << "Could not write analysis cache entry: "
+                    << TmpPath.string());
+      return;
+    }
+  }
+  boost::system::error_code EC;
+  boost::filesystem::rename(TmpPath, Path, EC);
+  if (EC) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, WARNING)
+                  << "Could not write analysis cache entry: " << Path.string());
+    boost::filesystem::remove(TmpPath, EC);
+  }
+}
+
+} // namespace psr
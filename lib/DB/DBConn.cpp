@@ -14,7 +14,7 @@
  *      Author: pdschbrt
  */
 
-#include <thread>
+#include <sstream>
 
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/Function.h>
@@ -24,14 +24,9 @@
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Support/SourceMgr.h>
 
-#include <cppconn/driver.h>
-#include <cppconn/exception.h>
-#include <cppconn/prepared_statement.h>
-#include <cppconn/resultset.h>
-#include <cppconn/statement.h>
-
 #include <phasar/DB/DBConn.h>
 #include <phasar/DB/Hexastore.h>
+#include <phasar/DB/MySQLBackend.h>
 #include <phasar/PhasarLLVM/Pointer/VTable.h>
 
 #include <phasar/Utils/IO.h>
@@ -49,35 +44,28 @@ const string DBConn::db_user = "root";
 const string DBConn::db_password = "1234";
 const string DBConn::db_server_address = "tcp://127.0.0.1:3306";
 
-DBConn::DBConn() {
-  auto lg = lg::get();
-  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Connect to database");
-  try {
-    driver = get_driver_instance();
-    conn = driver->connect(db_server_address, db_user, db_password);
-    if (!schemeExists()) {
-      buildDBScheme();
-    }
-    conn->setSchema(db_schema_name);
-    unique_ptr<sql::PreparedStatement> pstmt(
-        conn->prepareStatement("SET foreign_key_checks = 0"));
-    pstmt->executeQuery();
-  } catch (sql::SQLException &e) {
-    SQL_STD_ERROR_HANDLING;
+DBConn::DBConn() = default;
+
+DBConn::~DBConn() = default;
+
+DBBackend *DBConn::conn() {
+  if (!backend) {
+    backend.reset(new MySQLBackend(db_server_address, db_user, db_password,
+                                   db_schema_name));
   }
+  return backend.get();
 }
 
-DBConn::~DBConn() {
-  auto lg = lg::get();
-  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Close database connection");
-  delete conn;
+unique_ptr<DBBackend> DBConn::setBackend(unique_ptr<DBBackend> Backend) {
+  swap(backend, Backend);
+  return Backend;
 }
 
 int DBConn::getNextAvailableID(const string &TableName) {
   int id = 1;
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(
-        conn->prepareStatement([&TableName]() {
+    unique_ptr<DBStatement> pstmt(
+        conn()->prepareStatement([&TableName]() {
           if (TableName == "project") {
             return "SELECT project_id FROM project ORDER BY project_id DESC "
                    "LIMIT 1";
@@ -99,8 +87,8 @@ int DBConn::getNextAvailableID(const string &TableName) {
             return "SELECT callgraph_id FROM callgraph ORDER BY callgraph_id "
                    "DESC LIMIT 1";
           } else if (TableName == "points-to_graph") {
-            return "SELECT points-to_graph_id FROM points-to_graph ORDER BY "
-                   "points-to_graph_id DESC LIMIT 1";
+            return "SELECT `points-to_graph_id` FROM `points-to_graph` "
+                   "ORDER BY `points-to_graph_id` DESC LIMIT 1";
           } else if (TableName == "ifds_ide_summary") {
             return "SELECT ifds_ide_summary_id FROM ifds_ide_summary ORDER BY "
                    "ifds_ide_summary_id DESC LIMIT 1";
@@ -109,12 +97,12 @@ int DBConn::getNextAvailableID(const string &TableName) {
                 "Cannot look up next free id, because table does not exist.");
           }
         }()));
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     if (res->next()) {
       id = res->getInt(1);
       id++;
     }
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return id;
@@ -123,15 +111,15 @@ int DBConn::getNextAvailableID(const string &TableName) {
 int DBConn::getProjectID(const string &Identifier) {
   int projectID = -1;
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
         "SELECT project_id FROM project WHERE identifier=(?)"));
     pstmt->setString(1, Identifier);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     if (res->next()) {
       projectID = res->getInt(1);
     }
     return projectID;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return projectID;
@@ -140,15 +128,15 @@ int DBConn::getProjectID(const string &Identifier) {
 int DBConn::getModuleID(const string &Identifier) {
   int moduleID = -1;
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
         "SELECT module_id FROM module WHERE identifier=(?)"));
     pstmt->setString(1, Identifier);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     if (res->next()) {
       moduleID = res->getInt(1);
     }
     return moduleID;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return moduleID;
@@ -157,15 +145,15 @@ int DBConn::getModuleID(const string &Identifier) {
 set<int> DBConn::getFunctionID(const string &Identifier) {
   set<int> functionIDs;
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
         "SELECT function_id FROM function WHERE identifier=(?)"));
     pstmt->setString(1, Identifier);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     while (res->next()) {
       functionIDs.insert(res->getInt(1));
     }
     return functionIDs;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return functionIDs;
@@ -174,17 +162,17 @@ set<int> DBConn::getFunctionID(const string &Identifier) {
 size_t DBConn::getFunctionHash(const unsigned functionID) {
   size_t hash_value = 0;
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
         "SELECT hash FROM function WHERE function_id=(?)"));
     pstmt->setInt(1, functionID);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     if (res->next()) {
       string hash_string = res->getString(1);
       stringstream sstream(hash_string);
       sstream >> hash_value;
     }
     return hash_value;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return hash_value;
@@ -193,17 +181,17 @@ size_t DBConn::getFunctionHash(const unsigned functionID) {
 size_t DBConn::getModuleHash(const unsigned moduleID) {
   size_t hash_value = 0;
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(
-        conn->prepareStatement("SELECT hash FROM module WHERE module_id=(?)"));
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
+        "SELECT hash FROM module WHERE module_id=(?)"));
     pstmt->setInt(1, moduleID);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     if (res->next()) {
       string hash_string = res->getString(1);
       stringstream sstream(hash_string);
       sstream >> hash_value;
     }
     return hash_value;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return hash_value;
@@ -212,15 +200,15 @@ size_t DBConn::getModuleHash(const unsigned moduleID) {
 set<int> DBConn::getGlobalVariableID(const string &Identifier) {
   set<int> globalVariableIDs;
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
         "SELECT global_variable_id FROM global_variable WHERE identifier=(?)"));
     pstmt->setString(1, Identifier);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     while (res->next()) {
       globalVariableIDs.insert(res->getInt(1));
     }
     return globalVariableIDs;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return globalVariableIDs;
@@ -229,15 +217,15 @@ set<int> DBConn::getGlobalVariableID(const string &Identifier) {
 int DBConn::getTypeID(const string &Identifier) {
   int typeID = -1;
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
         "SELECT type_id FROM type WHERE identifier=(?)"));
     pstmt->setString(1, Identifier);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     if (res->next()) {
       typeID = res->getInt(1);
     }
     return typeID;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return typeID;
@@ -251,17 +239,17 @@ DBConn &DBConn::getInstance() {
 set<int> DBConn::getModuleIDsFromProject(const string &Identifier) {
   set<int> moduleIDs;
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
         "SELECT module_id "
         "FROM project_has_module WHERE project_id=(SELECT "
-        "project_id FROM phasardb.project WHERE identifier=?)"));
+        "project_id FROM project WHERE identifier=?)"));
     pstmt->setString(1, Identifier);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     while (res->next()) {
       moduleIDs.insert(res->getInt(1));
     }
     return moduleIDs;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return moduleIDs;
@@ -270,15 +258,15 @@ set<int> DBConn::getModuleIDsFromProject(const string &Identifier) {
 int DBConn::getModuleIDFromTypeID(const unsigned typeID) {
   int moduleID = -1;
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
         "SELECT module_id FROM module_has_type WHERE type_id=?)"));
     pstmt->setInt(1, typeID);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     if (res->next()) {
       moduleID = res->getInt(1);
     }
     return moduleID;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return moduleID;
@@ -287,15 +275,15 @@ int DBConn::getModuleIDFromTypeID(const unsigned typeID) {
 int DBConn::getModuleIDFromFunctionID(const unsigned functionID) {
   int moduleID = -1;
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
         "SELECT module_id FROM module_has_function WHERE type_id=?)"));
     pstmt->setInt(1, functionID);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     if (res->next()) {
       moduleID = res->getInt(1);
     }
     return moduleID;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return moduleID;
@@ -304,14 +292,14 @@ int DBConn::getModuleIDFromFunctionID(const unsigned functionID) {
 set<int> DBConn::getAllTypeHierarchyIDs() {
   set<int> THIDs;
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(
-        conn->prepareStatement("SELECT type_hierarchy_id FROM type_hierarchy"));
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
+        "SELECT type_hierarchy_id FROM type_hierarchy"));
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     while (res->next()) {
       THIDs.insert(res->getInt("type_hierarchy_id"));
     }
     return THIDs;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return THIDs;
@@ -320,16 +308,16 @@ set<int> DBConn::getAllTypeHierarchyIDs() {
 set<int> DBConn::getAllModuleIDsFromTH(const unsigned typeHierarchyID) {
   set<int> moduleIDs;
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
         "SELECT module_id FROM moduel_has_type_hierarchy WHERE "
         "type_hierarchy_id=?"));
     pstmt->setInt(1, typeHierarchyID);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     while (res->next()) {
       moduleIDs.insert(res->getInt("module_id"));
     }
     return moduleIDs;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return moduleIDs;
@@ -337,12 +325,12 @@ set<int> DBConn::getAllModuleIDsFromTH(const unsigned typeHierarchyID) {
 
 QueryReturnCode DBConn::moduleHasTypeHierarchy(const unsigned moduleID) {
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
         "SELECT module_id FROM module_has_type_hierarchy WHERE module_id=?"));
     pstmt->setInt(1, moduleID);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     return res->next() ? QueryReturnCode::DBTrue : QueryReturnCode::DBFalse;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return QueryReturnCode::DBError;
@@ -351,22 +339,22 @@ QueryReturnCode DBConn::moduleHasTypeHierarchy(const unsigned moduleID) {
 QueryReturnCode
 DBConn::globalVariableIsDeclaration(const unsigned globalVariableID) {
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
         "SELECT declaration FROM global_variable WHERE global_variable_id=?"));
     pstmt->setInt(1, globalVariableID);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     if (res->next()) {
       return res->getBoolean("declaration") ? QueryReturnCode::DBTrue
                                             : QueryReturnCode::DBFalse;
     }
     return QueryReturnCode::DBError;
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return QueryReturnCode::DBError;
 }
 
-string DBConn::getDBName() { return db_schema_name; }
+string DBConn::getDBName() { return conn()->getName(); }
 
 bool DBConn::insertGlobalVariable(const llvm::GlobalVariable &G,
                                   const unsigned moduleID) {
@@ -386,7 +374,7 @@ bool DBConn::insertGlobalVariable(const llvm::GlobalVariable &G,
         (globalVariableIDs.size() == 1 &&
          globalVariableIsDeclaration(*globalVariableIDs.begin()) !=
              GIsDeclarataion)) {
-      unique_ptr<sql::PreparedStatement> gpstmt(conn->prepareStatement(
+      unique_ptr<DBStatement> gpstmt(conn()->prepareStatement(
           "INSERT INTO global_variable "
           "(global_variable_id,identifier,declaration) VALUES (?,?,?)"));
       gpstmt->setInt(1, newGlobalID);
@@ -396,8 +384,8 @@ bool DBConn::insertGlobalVariable(const llvm::GlobalVariable &G,
       newGlobVar = true;
     }
     // Fill module - global relation
-    unique_ptr<sql::PreparedStatement> grpstmt(
-        conn->prepareStatement("INSERT INTO module_has_global_variable "
+    unique_ptr<DBStatement> grpstmt(
+        conn()->prepareStatement("INSERT INTO module_has_global_variable "
                                "(module_id,global_variable_id) VALUES (?,?)"));
     grpstmt->setInt(1, moduleID);
     // Find the ID of the global variable
@@ -419,8 +407,9 @@ bool DBConn::insertGlobalVariable(const llvm::GlobalVariable &G,
       }
     }
     grpstmt->executeUpdate();
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
+    throw;
   }
   return false;
 }
@@ -444,7 +433,7 @@ bool DBConn::insertFunction(const llvm::Function &F, const unsigned moduleID) {
     }
     // Do not write duplicate functions
     if (newFunc) {
-      unique_ptr<sql::PreparedStatement> fpstmt(conn->prepareStatement(
+      unique_ptr<DBStatement> fpstmt(conn()->prepareStatement(
           "INSERT INTO function (function_id,identifier,declaration,hash) "
           "VALUES (?,?,?,?)"));
       fpstmt->setInt(1, newFunctionID);
@@ -454,8 +443,8 @@ bool DBConn::insertFunction(const llvm::Function &F, const unsigned moduleID) {
       fpstmt->executeUpdate();
     }
     // Fill module - function relation
-    unique_ptr<sql::PreparedStatement> frpstmt(
-        conn->prepareStatement("INSERT INTO module_has_function "
+    unique_ptr<DBStatement> frpstmt(
+        conn()->prepareStatement("INSERT INTO module_has_function "
                                "(module_id,function_id) VALUES (?,?)"));
     frpstmt->setInt(1, moduleID);
     if (newFunc) {
@@ -464,8 +453,9 @@ bool DBConn::insertFunction(const llvm::Function &F, const unsigned moduleID) {
       frpstmt->setInt(2, matchingFID);
     }
     frpstmt->executeUpdate();
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
+    throw;
   }
   return false;
 }
@@ -477,7 +467,7 @@ bool DBConn::insertType(const llvm::StructType &ST, const unsigned moduleID) {
     bool newType = false;
     // Do not write duplicate types
     if (typeID == -1) {
-      unique_ptr<sql::PreparedStatement> stpstmt(conn->prepareStatement(
+      unique_ptr<DBStatement> stpstmt(conn()->prepareStatement(
           "INSERT INTO type (type_id, identifier) VALUES (?,?)"));
       stpstmt->setInt(1, newTypeID);
       stpstmt->setString(2, ST.getName().str());
@@ -485,8 +475,8 @@ bool DBConn::insertType(const llvm::StructType &ST, const unsigned moduleID) {
       newType = true;
     }
     // Fill module - type relation
-    unique_ptr<sql::PreparedStatement> trpstmt(
-        conn->prepareStatement("INSERT INTO module_has_type "
+    unique_ptr<DBStatement> trpstmt(
+        conn()->prepareStatement("INSERT INTO module_has_type "
                                "(module_id,type_id) VALUES (?,?)"));
     trpstmt->setInt(1, moduleID);
     if (newType) {
@@ -495,8 +485,9 @@ bool DBConn::insertType(const llvm::StructType &ST, const unsigned moduleID) {
       trpstmt->setInt(2, typeID);
     }
     trpstmt->executeUpdate();
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
+    throw;
   }
   return false;
 }
@@ -508,21 +499,21 @@ bool DBConn::insertVTable(const VTable &VTBL, const string &TypeName,
     // module ID of the module that contains the current type
     for (auto fname : VTBL) {
       // Identify the corresponding function id
-      unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+      unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
           "SELECT DISTINCT function_id, declaration FROM function "
           "NATURAL JOIN module_has_function NATURAL JOIN project_has_module "
           "WHERE function.identifier=? AND project_id=( "
           "SELECT project_id FROM project WHERE project.identifier=?)"));
       pstmt->setString(1, fname);
       pstmt->setString(2, ProjectName);
-      unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+      unique_ptr<DBResultSet> res(pstmt->executeQuery());
       int fid = -1;
       while (res->next()) {
         fid = res->getInt("function_id");
         if (!res->getBoolean("declaration"))
           break;
       }
-      unique_ptr<sql::PreparedStatement> tvpstmt(conn->prepareStatement(
+      unique_ptr<DBStatement> tvpstmt(conn()->prepareStatement(
           "INSERT INTO type_has_virtual_function "
           "(type_id,function_id,vtable_index) VALUES(?,?,?)"));
       tvpstmt->setInt(1, typeID);
@@ -530,8 +521,9 @@ bool DBConn::insertVTable(const VTable &VTBL, const string &TypeName,
       tvpstmt->setInt(3, VTBL.getEntryByFunctionName(fname));
       tvpstmt->executeUpdate();
     }
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
+    throw;
   }
   return false;
 }
@@ -543,7 +535,7 @@ bool DBConn::insertModule(const string &ProjectName,
     int projectID = getProjectID(ProjectName);
     if (projectID == -1) {
       projectID = getNextAvailableID("project");
-      unique_ptr<sql::PreparedStatement> ppstmt(conn->prepareStatement(
+      unique_ptr<DBStatement> ppstmt(conn()->prepareStatement(
           "INSERT INTO project (project_id,identifier) VALUES(?,?)"));
       ppstmt->setInt(1, projectID);
       ppstmt->setString(2, ProjectName);
@@ -555,19 +547,18 @@ bool DBConn::insertModule(const string &ProjectName,
     llvm::raw_string_ostream rso(ir_mod_buffer);
     llvm::WriteBitcodeToFile(module, rso);
     rso.flush();
-    istringstream ist(ir_mod_buffer);
     size_t hash_value = hash<string>()(ir_mod_buffer);
-    unique_ptr<sql::PreparedStatement> mpstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> mpstmt(conn()->prepareStatement(
         "INSERT INTO module (module_id,identifier,hash,code) VALUES(?,?,?,?)"));
     int moduleID = getNextAvailableID("module");
     mpstmt->setInt(1, moduleID);
     mpstmt->setString(2, identifier);
     mpstmt->setString(3, to_string(hash_value));
-    mpstmt->setBlob(4, &ist);
+    mpstmt->setBlob(4, ir_mod_buffer);
     mpstmt->executeUpdate();
     // Fill project - module relation
     cout << "PROJECT ID IS: " << projectID << endl;
-    unique_ptr<sql::PreparedStatement> pmrstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pmrstmt(conn()->prepareStatement(
         "INSERT INTO project_has_module(project_id,module_id) VALUES(?,?)"));
     pmrstmt->setInt(1, projectID);
     pmrstmt->setInt(2, moduleID);
@@ -584,8 +575,9 @@ bool DBConn::insertModule(const string &ProjectName,
     for (const llvm::StructType *ST : module->getIdentifiedStructTypes()) {
       insertType(*ST, moduleID);
     }
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
+    throw;
   }
   return false;
 }
@@ -594,13 +586,12 @@ bool DBConn::insertModule(const string &ProjectName,
 unique_ptr<llvm::Module> DBConn::getModule(const string &identifier,
                                            llvm::LLVMContext &Context) {
   try {
-    unique_ptr<sql::PreparedStatement> pstmt(
-        conn->prepareStatement("SELECT code FROM module WHERE identifier=?"));
+    unique_ptr<DBStatement> pstmt(
+        conn()->prepareStatement("SELECT code FROM module WHERE identifier=?"));
     pstmt->setString(1, identifier);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     if (res->next()) {
-      istream *ist = res->getBlob("code");
-      string ir_mod_buffer(istreambuf_iterator<char>(*ist), {});
+      string ir_mod_buffer = res->getBlob("code");
       // parse the freshly retrieved byte sequence into an llvm::Module
       llvm::SMDiagnostic ErrorDiagnostics;
       unique_ptr<llvm::MemoryBuffer> MemBuffer =
@@ -622,7 +613,7 @@ unique_ptr<llvm::Module> DBConn::getModule(const string &identifier,
     } else {
       return nullptr;
     }
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
     return nullptr;
   }
@@ -859,7 +850,7 @@ void operator>>(DBConn &db, PointsToGraph &PTG) {
 void DBConn::storeLLVMBasedICFG(const LLVMBasedICFG &ICFG,
                                 const string &ProjectName, bool use_hs) {
   try {
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
 }
@@ -867,7 +858,7 @@ void DBConn::storeLLVMBasedICFG(const LLVMBasedICFG &ICFG,
 LLVMBasedICFG DBConn::loadLLVMBasedICFGfromModule(const string &ModuleName,
                                                   bool use_hs) {
   try {
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   ProjectIRDB IRDB(IRDBOptions::NONE);
@@ -879,7 +870,7 @@ LLVMBasedICFG
 DBConn::loadLLVMBasedICFGfromModules(initializer_list<string> ModuleNames,
                                      bool use_hs) {
   try {
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   ProjectIRDB IRDB(IRDBOptions::NONE);
@@ -890,7 +881,7 @@ DBConn::loadLLVMBasedICFGfromModules(initializer_list<string> ModuleNames,
 LLVMBasedICFG DBConn::loadLLVMBasedICFGfromProject(const string &ProjectName,
                                                    bool use_hs) {
   try {
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   ProjectIRDB IRDB(IRDBOptions::NONE);
@@ -901,7 +892,7 @@ LLVMBasedICFG DBConn::loadLLVMBasedICFGfromProject(const string &ProjectName,
 void DBConn::storePointsToGraph(const PointsToGraph &PTG,
                                 const string &ProjectName, bool use_hs) {
   try {
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
 }
@@ -909,7 +900,7 @@ void DBConn::storePointsToGraph(const PointsToGraph &PTG,
 PointsToGraph DBConn::loadPointsToGraphFromFunction(const string &FunctionName,
                                                     bool use_hs) {
   try {
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return PointsToGraph();
@@ -918,13 +909,14 @@ PointsToGraph DBConn::loadPointsToGraphFromFunction(const string &FunctionName,
 void DBConn::storeLTHGraphToHex(const LLVMTypeHierarchy::bidigraph_t &G,
                                 const string hex_id) {
   Hexastore h(hex_id);
+  vector<array<string, 3>> hs_edges;
   typename boost::graph_traits<LLVMTypeHierarchy::bidigraph_t>::edge_iterator
       ei_start,
       e_end;
   for (tie(ei_start, e_end) = boost::edges(G); ei_start != e_end; ++ei_start) {
     auto source = boost::source(*ei_start, G);
     auto target = boost::target(*ei_start, G);
-    h.put({{G[source].name, "-->", G[target].name}});
+    hs_edges.push_back({{G[source].name, "-->", G[target].name}});
   }
   typedef boost::graph_traits<LLVMTypeHierarchy::bidigraph_t>::vertex_iterator
       vertex_iterator_t;
@@ -936,9 +928,10 @@ void DBConn::storeLTHGraphToHex(const LLVMTypeHierarchy::bidigraph_t &G,
     boost::tie(ei, ei_end) = boost::out_edges(*vp.first, G);
     if (ei == ei_end) {
       string hs_vertex_rep = G[*vp.first].name;
-      h.put({{hs_vertex_rep, "---", "---"}});
+      hs_edges.push_back({{hs_vertex_rep, "---", "---"}});
     }
   }
+  h.putAll(hs_edges);
   auto result = h.get({{"?", "?", "?"}});
   for_each(result.begin(), result.end(),
            [](hs_result r) { cout << r << endl; });
@@ -1039,11 +1032,11 @@ LLVMTypeHierarchy
 DBConn::loadLLVMTypeHierarchyFromModule(const string &ModuleName, bool use_hs) {
   try {
     int THID = -1;
-    unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+    unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
         "SELECT type_hierarchy_id FROM module_has_type_hierarchy "
         "NATURAL JOIN module WHERE module.identifier=?"));
     pstmt->setString(1, ModuleName);
-    unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    unique_ptr<DBResultSet> res(pstmt->executeQuery());
     while (res->next()) {
       if (THID == -1)
         THID = res->getInt("type_hierarchy_id");
@@ -1054,7 +1047,7 @@ DBConn::loadLLVMTypeHierarchyFromModule(const string &ModuleName, bool use_hs) {
     if (THID == -1)
       throw logic_error(
           "No Type Hierarchy found that contains the given module!");
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   } catch (logic_error &e) {
     cout << e.what() << endl;
@@ -1082,7 +1075,7 @@ DBConn::loadLLVMTypeHierarchyFromModules(initializer_list<string> ModuleNames,
       throw logic_error(
           "No Type Hierarchy found that contains all given modules!");
 
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   } catch (logic_error &e) {
     cout << e.what() << endl;
@@ -1094,7 +1087,7 @@ LLVMTypeHierarchy
 DBConn::loadLLVMTypeHierarchyFromProject(const string &ProjectName,
                                          bool use_hs) {
   try {
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return LLVMTypeHierarchy();
@@ -1102,7 +1095,7 @@ DBConn::loadLLVMTypeHierarchyFromProject(const string &ProjectName,
 
 void DBConn::storeIDESummary(const IDESummary &S) {
   try {
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
 }
@@ -1110,7 +1103,7 @@ void DBConn::storeIDESummary(const IDESummary &S) {
 IDESummary DBConn::loadIDESummary(const string &FunctionName,
                                   const string &AnalysisName) {
   try {
-  } catch (sql::SQLException &e) {
+  } catch (DBException &e) {
     SQL_STD_ERROR_HANDLING;
   }
   return IDESummary();
@@ -1118,27 +1111,40 @@ IDESummary DBConn::loadIDESummary(const string &FunctionName,
 
 void DBConn::storeProjectIRDB(const string &ProjectName,
                               const ProjectIRDB &IRDB) {
-  // Initialize the transaction
-  unique_ptr<sql::Statement> stmt(conn->createStatement());
-  stmt->execute("START TRANSACTION");
-  for (auto M : IRDB.getAllModules()) {
-    int moduleID = getModuleID(M->getModuleIdentifier());
-    if (moduleID == -1 ||
-        getModuleHash(moduleID) != computeModuleHash(M, true)) {
-      insertModule(ProjectName, M);
+  bool InTransaction = false;
+  try {
+    // All modules are inserted within a single transaction
+    conn()->beginTransaction();
+    InTransaction = true;
+    for (auto M : IRDB.getAllModules()) {
+      int moduleID = getModuleID(M->getModuleIdentifier());
+      if (moduleID == -1 ||
+          getModuleHash(moduleID) != computeModuleHash(M, true)) {
+        insertModule(ProjectName, M);
+      }
+    }
+    // Perform the commit
+    conn()->commit();
+  } catch (DBException &e) {
+    SQL_STD_ERROR_HANDLING;
+    // Either all modules are stored or none
+    if (InTransaction) {
+      try {
+        conn()->rollback();
+      } catch (DBException &e) {
+        SQL_STD_ERROR_HANDLING;
+      }
     }
   }
-  // Perform the commit
-  conn->commit();
 }
 
 ProjectIRDB DBConn::loadProjectIRDB(const string &ProjectName) {
-  unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+  unique_ptr<DBStatement> pstmt(conn()->prepareStatement(
       "SELECT identifier "
       "FROM project_has_module NATURAL JOIN module WHERE project_id=(SELECT "
       "project_id FROM project WHERE identifier=?)"));
   pstmt->setString(1, ProjectName);
-  unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+  unique_ptr<DBResultSet> res(pstmt->executeQuery());
   ProjectIRDB IRDB(IRDBOptions::NONE);
   while (res->next()) {
     string module_identifier = res->getString("identifier");
@@ -1150,408 +1156,9 @@ ProjectIRDB DBConn::loadProjectIRDB(const string &ProjectName) {
   return IRDB;
 }
 
-bool DBConn::schemeExists() {
-  unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
-      "SELECT SCHEMA_NAME FROM INFORMATION_SCHEMA.SCHEMATA WHERE "
-      "SCHEMA_NAME=?"));
-  pstmt->setString(1, db_schema_name);
-  unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-  return res->next();
-}
-
-void DBConn::buildDBScheme() {
-  auto lg = lg::get();
-  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Building database schema");
-
-  unique_ptr<sql::Statement> stmt(conn->createStatement());
-  static const string old_unique_checks(
-      "SET @OLD_UNIQUE_CHECKS=@@UNIQUE_CHECKS, UNIQUE_CHECKS=0; ");
-  stmt->execute(old_unique_checks);
-
-  static const string old_foreign_key_checks(
-      "SET @OLD_FOREIGN_KEY_CHECKS=@@FOREIGN_KEY_CHECKS, "
-      "FOREIGN_KEY_CHECKS=0; ");
-  stmt->execute(old_foreign_key_checks);
-
-  static const string old_sql_mode(
-      "SET @OLD_SQL_MODE=@@SQL_MODE, "
-      "SQL_MODE='TRADITIONAL,ALLOW_INVALID_DATES';");
-  stmt->execute(old_sql_mode);
-
-  static const string create_schema(
-      "CREATE SCHEMA IF NOT EXISTS `phasardb` DEFAULT CHARACTER SET utf8 ; ");
-  stmt->execute(create_schema);
-
-  static const string create_function(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`function` ( "
-      "`function_id` INT(11) NOT NULL AUTO_INCREMENT, "
-      "`identifier` VARCHAR(512) NULL DEFAULT NULL, "
-      "`declaration` TINYINT(1) NULL DEFAULT NULL, "
-      "`hash` VARCHAR(512) NULL DEFAULT NULL, "
-      "PRIMARY KEY (`function_id`)) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_function);
-
-  static const string create_ifds_ide_summary(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`ifds_ide_summary` ( "
-      "`ifds_ide_summary_id` INT(11) NOT NULL AUTO_INCREMENT, "
-      "`analysis` VARCHAR(512) NULL DEFAULT NULL, "
-      "`representation` BLOB NULL DEFAULT NULL, "
-      "PRIMARY KEY (`ifds_ide_summary_id`)) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_ifds_ide_summary);
-
-  static const string create_module(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`module` ( "
-      "`module_id` INT(11) NOT NULL AUTO_INCREMENT, "
-      "`identifier` VARCHAR(512) NULL DEFAULT NULL, "
-      "`hash` VARCHAR(512) NULL DEFAULT NULL, "
-      "`code` LONGBLOB NULL DEFAULT NULL, "
-      "PRIMARY KEY (`module_id`)) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_module);
-
-  static const string create_type(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`type` ( "
-      "`type_id` INT(11) NOT NULL AUTO_INCREMENT, "
-      "`identifier` VARCHAR(512) NULL DEFAULT NULL, "
-      "PRIMARY KEY (`type_id`)) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_type);
-
-  static const string create_type_hierarchy(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`type_hierarchy` ( "
-      "`type_hierarchy_id` INT(11) NOT NULL AUTO_INCREMENT, "
-      "`representation` LONGBLOB NULL DEFAULT NULL, "
-      "`representation_ref` VARCHAR(512) NULL DEFAULT NULL, "
-      "PRIMARY KEY (`type_hierarchy_id`)) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_type_hierarchy);
-
-  static const string create_global_variable(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`global_variable` ( "
-      "`global_variable_id` INT(11) NOT NULL AUTO_INCREMENT, "
-      "`identifier` VARCHAR(512) NULL DEFAULT NULL, "
-      "`declaration` TINYINT(1) NULL DEFAULT NULL, "
-      "PRIMARY KEY (`global_variable_id`)) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_global_variable);
-
-  static const string create_callgraph(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`callgraph` ( "
-      "`callgraph_id` INT(11) NOT NULL AUTO_INCREMENT, "
-      "`representation` LONGBLOB NULL DEFAULT NULL, "
-      "`representation_ref` VARCHAR(512) NULL DEFAULT NULL, "
-      "PRIMARY KEY (`callgraph_id`)) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_callgraph);
-
-  static const string create_points_to_graph(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`points-to_graph` ( "
-      "`points-to_graph_id` INT(11) NOT NULL AUTO_INCREMENT, "
-      "`representation` LONGBLOB NULL DEFAULT NULL, "
-      "`representation_ref` VARCHAR(512) NULL DEFAULT NULL, "
-      "PRIMARY KEY (`points-to_graph_id`)) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_points_to_graph);
-
-  static const string create_project(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`project` ( "
-      "`project_id` INT(11) NOT NULL AUTO_INCREMENT, "
-      "`identifier` VARCHAR(512) NULL DEFAULT NULL, "
-      "PRIMARY KEY (`project_id`)) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_project);
-
-  static const string create_project_has_module(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`project_has_module` ( "
-      "`project_id` INT(11) NOT NULL, "
-      "`module_id` INT(11) NOT NULL, "
-      "PRIMARY KEY (`project_id`, `module_id`), "
-      "INDEX `fk_project_has_module_module1_idx` (`module_id` ASC), "
-      "INDEX `fk_project_has_module_project1_idx` (`project_id` ASC), "
-      "CONSTRAINT `fk_project_has_module_project1` "
-      "FOREIGN KEY (`project_id`) "
-      "REFERENCES `phasardb`.`project` (`project_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE, "
-      "CONSTRAINT `fk_project_has_module_module1` "
-      "FOREIGN KEY (`module_id`) "
-      "REFERENCES `phasardb`.`module` (`module_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_project_has_module);
-
-  static const string create_module_has_callgraph(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`module_has_callgraph` ( "
-      "`module_id` INT(11) NOT NULL, "
-      "`callgraph_id` INT(11) NOT NULL, "
-      "PRIMARY KEY (`module_id`, `callgraph_id`), "
-      "INDEX `fk_module_has_callgraph_callgraph1_idx` (`callgraph_id` ASC), "
-      "INDEX `fk_module_has_callgraph_module1_idx` (`module_id` ASC), "
-      "CONSTRAINT `fk_module_has_callgraph_module1` "
-      "FOREIGN KEY (`module_id`) "
-      "REFERENCES `phasardb`.`module` (`module_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE, "
-      "CONSTRAINT `fk_module_has_callgraph_callgraph1` "
-      "FOREIGN KEY (`callgraph_id`) "
-      "REFERENCES `phasardb`.`callgraph` (`callgraph_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_module_has_callgraph);
-
-  static const string create_callgraph_has_points_to_graph(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`callgraph_has_points-to_graph` ( "
-      "`callgraph_id` INT(11) NOT NULL, "
-      "`points-to_graph_id` INT(11) NOT NULL, "
-      "PRIMARY KEY (`callgraph_id`, `points-to_graph_id`), "
-      "INDEX `fk_callgraph_has_points-to_graph_points-to_graph1_idx` "
-      "(`points-to_graph_id` ASC), "
-      "INDEX `fk_callgraph_has_points-to_graph_callgraph1_idx` (`callgraph_id` "
-      "ASC), "
-      "CONSTRAINT `fk_callgraph_has_points-to_graph_callgraph1` "
-      "FOREIGN KEY (`callgraph_id`) "
-      "REFERENCES `phasardb`.`callgraph` (`callgraph_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE, "
-      "CONSTRAINT `fk_callgraph_has_points-to_graph_points-to_graph1` "
-      "FOREIGN KEY (`points-to_graph_id`) "
-      "REFERENCES `phasardb`.`points-to_graph` (`points-to_graph_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_callgraph_has_points_to_graph);
-
-  static const string create_module_has_function(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`module_has_function` ( "
-      "`module_id` INT(11) NOT NULL, "
-      "`function_id` INT(11) NOT NULL, "
-      "PRIMARY KEY (`module_id`, `function_id`), "
-      "INDEX `fk_module_has_function_function1_idx` (`function_id` ASC), "
-      "INDEX `fk_module_has_function_module1_idx` (`module_id` ASC), "
-      "CONSTRAINT `fk_module_has_function_module1` "
-      "FOREIGN KEY (`module_id`) "
-      "REFERENCES `phasardb`.`module` (`module_id`) "
-      "ON DELETE NO ACTION "
-      "ON UPDATE NO ACTION, "
-      "CONSTRAINT `fk_module_has_function_function1` "
-      "FOREIGN KEY (`function_id`) "
-      "REFERENCES `phasardb`.`function` (`function_id`) "
-      "ON DELETE NO ACTION "
-      "ON UPDATE NO ACTION) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_module_has_function);
-
-  static const string create_module_has_global_variable(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`module_has_global_variable` ( "
-      "`module_id` INT(11) NOT NULL, "
-      "`global_variable_id` INT(11) NOT NULL, "
-      "PRIMARY KEY (`module_id`, `global_variable_id`), "
-      "INDEX `fk_module_has_global_variable_global_variable1_idx` "
-      "(`global_variable_id` ASC), "
-      "INDEX `fk_module_has_global_variable_module1_idx` (`module_id` ASC), "
-      "CONSTRAINT `fk_module_has_global_variable_module1` "
-      "FOREIGN KEY (`module_id`) "
-      "REFERENCES `phasardb`.`module` (`module_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE, "
-      "CONSTRAINT `fk_module_has_global_variable_global_variable1` "
-      "FOREIGN KEY (`global_variable_id`) "
-      "REFERENCES `phasardb`.`global_variable` (`global_variable_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_module_has_global_variable);
-
-  static const string create_module_has_type_hierarchy(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`module_has_type_hierarchy` ( "
-      "`module_id` INT(11) NOT NULL, "
-      "`type_hierarchy_id` INT(11) NOT NULL, "
-      "PRIMARY KEY (`module_id`, `type_hierarchy_id`), "
-      "INDEX `fk_module_has_type_hierarchy_type_hierarchy1_idx` "
-      "(`type_hierarchy_id` ASC), "
-      "INDEX `fk_module_has_type_hierarchy_module1_idx` (`module_id` ASC), "
-      "CONSTRAINT `fk_module_has_type_hierarchy_module1` "
-      "FOREIGN KEY (`module_id`) "
-      "REFERENCES `phasardb`.`module` (`module_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE, "
-      "CONSTRAINT `fk_module_has_type_hierarchy_type_hierarchy1` "
-      "FOREIGN KEY (`type_hierarchy_id`) "
-      "REFERENCES `phasardb`.`type_hierarchy` (`type_hierarchy_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_module_has_type_hierarchy);
-
-  static const string create_module_has_type(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`module_has_type` ( "
-      "`module_id` INT(11) NOT NULL, "
-      "`type_id` INT(11) NOT NULL, "
-      "PRIMARY KEY (`module_id`, `type_id`), "
-      "INDEX `fk_module_has_type_type1_idx` (`type_id` ASC), "
-      "INDEX `fk_module_has_type_module1_idx` (`module_id` ASC), "
-      "CONSTRAINT `fk_module_has_type_module1` "
-      "FOREIGN KEY (`module_id`) "
-      "REFERENCES `phasardb`.`module` (`module_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE, "
-      "CONSTRAINT `fk_module_has_type_type1` "
-      "FOREIGN KEY (`type_id`) "
-      "REFERENCES `phasardb`.`type` (`type_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_module_has_type);
-
-  static const string create_type_hierarchy_has_type(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`type_hierarchy_has_type` ( "
-      "`type_hierarchy_id` INT(11) NOT NULL, "
-      "`type_id` INT(11) NOT NULL, "
-      "PRIMARY KEY (`type_hierarchy_id`, `type_id`), "
-      "INDEX `fk_type_hierarchy_has_type_type1_idx` (`type_id` ASC), "
-      "INDEX `fk_type_hierarchy_has_type_type_hierarchy1_idx` "
-      "(`type_hierarchy_id` ASC), "
-      "CONSTRAINT `fk_type_hierarchy_has_type_type_hierarchy1` "
-      "FOREIGN KEY (`type_hierarchy_id`) "
-      "REFERENCES `phasardb`.`type_hierarchy` (`type_hierarchy_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE, "
-      "CONSTRAINT `fk_type_hierarchy_has_type_type1` "
-      "FOREIGN KEY (`type_id`) "
-      "REFERENCES `phasardb`.`type` (`type_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_type_hierarchy_has_type);
-
-  static const string create_function_has_ifds_ide_summary(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`function_has_ifds_ide_summary` ( "
-      "`function_id` INT(11) NOT NULL, "
-      "`ifds_ide_summary_id` INT(11) NOT NULL, "
-      "PRIMARY KEY (`function_id`, `ifds_ide_summary_id`), "
-      "INDEX `fk_function_has_ifds_ide_summary_ifds_ide_summary1_idx` "
-      "(`ifds_ide_summary_id` ASC), "
-      "INDEX `fk_function_has_ifds_ide_summary_function1_idx` (`function_id` "
-      "ASC), "
-      "CONSTRAINT `fk_function_has_ifds_ide_summary_function1` "
-      "FOREIGN KEY (`function_id`) "
-      "REFERENCES `phasardb`.`function` (`function_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE, "
-      "CONSTRAINT `fk_function_has_ifds_ide_summary_ifds_ide_summary1` "
-      "FOREIGN KEY (`ifds_ide_summary_id`) "
-      "REFERENCES `phasardb`.`ifds_ide_summary` (`ifds_ide_summary_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_function_has_ifds_ide_summary);
-
-  static const string create_function_has_points_to_graph(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`function_has_points-to_graph` ( "
-      "`function_id` INT(11) NOT NULL, "
-      "`points-to_graph_id` INT(11) NOT NULL, "
-      "PRIMARY KEY (`function_id`, `points-to_graph_id`), "
-      "INDEX `fk_function_has_points-to_graph_points-to_graph1_idx` "
-      "(`points-to_graph_id` ASC), "
-      "INDEX `fk_function_has_points-to_graph_function1_idx` (`function_id` "
-      "ASC), "
-      "CONSTRAINT `fk_function_has_points-to_graph_function1` "
-      "FOREIGN KEY (`function_id`) "
-      "REFERENCES `phasardb`.`function` (`function_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE, "
-      "CONSTRAINT `fk_function_has_points-to_graph_points-to_graph1` "
-      "FOREIGN KEY (`points-to_graph_id`) "
-      "REFERENCES `phasardb`.`points-to_graph` (`points-to_graph_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_function_has_points_to_graph);
-
-  static const string create_type_has_virtual_function(
-      "CREATE TABLE IF NOT EXISTS `phasardb`.`type_has_virtual_function` ( "
-      "`type_id` INT(11) NOT NULL, "
-      "`function_id` INT(11) NOT NULL, "
-      "`vtable_index` INT(11) NULL DEFAULT NULL, "
-      "PRIMARY KEY (`type_id`, `function_id`), "
-      "INDEX `fk_type_has_function_function1_idx` (`function_id` ASC), "
-      "INDEX `fk_type_has_function_type1_idx` (`type_id` ASC), "
-      "CONSTRAINT `fk_type_has_function_type1` "
-      "FOREIGN KEY (`type_id`) "
-      "REFERENCES `phasardb`.`type` (`type_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE, "
-      "CONSTRAINT `fk_type_has_function_function1` "
-      "FOREIGN KEY (`function_id`) "
-      "REFERENCES `phasardb`.`function` (`function_id`) "
-      "ON DELETE CASCADE "
-      "ON UPDATE CASCADE) "
-      "ENGINE = InnoDB "
-      "DEFAULT CHARACTER SET = utf8 "
-      "COLLATE = utf8_unicode_ci; ");
-  stmt->execute(create_type_has_virtual_function);
-
-  static const string sql_mode("SET SQL_MODE=@OLD_SQL_MODE; ");
-  stmt->execute(sql_mode);
-
-  static const string foreign_key_checks(
-      "SET FOREIGN_KEY_CHECKS=@OLD_FOREIGN_KEY_CHECKS; ");
-  stmt->execute(foreign_key_checks);
-
-  static const string unique_checks("SET UNIQUE_CHECKS=@OLD_UNIQUE_CHECKS; ");
-  stmt->execute(unique_checks);
-  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Database schema done");
-}
-
 void DBConn::dropDBAndRebuildScheme() {
-  unique_ptr<sql::Statement> stmt(conn->createStatement());
-  const string drop_database("DROP DATABASE IF EXISTS `phasardb`");
-  stmt->execute(drop_database);
-  cout << "DROPED DATABASE SCHEMA" << endl;
-  this_thread::sleep_for(5s);
-  buildDBScheme();
+  conn()->dropScheme();
+  conn()->buildScheme();
 }
 
 } // namespace psr
@@ -8,101 +8,154 @@
  *****************************************************************************/
 
 #include <iostream>
+#include <stdexcept>
 
 #include <phasar/DB/Hexastore.h>
+#include <phasar/DB/SQLiteBackend.h>
 
 using namespace psr;
 using namespace std;
-using namespace boost;
 
 namespace psr {
 
 Hexastore::Hexastore(string filename) {
-  sqlite3_open(filename.c_str(), &hs_internal_db);
-  const string query = INIT;
-  char *err;
-  sqlite3_exec(hs_internal_db, query.c_str(), callback, 0, &err);
-  if (err != NULL)
+  if (sqlite3_open(filename.c_str(), &hs_internal_db) != SQLITE_OK) {
+    string err = sqlite3_errmsg(hs_internal_db);
+    sqlite3_close(hs_internal_db);
+    throw runtime_error("could not open hexastore " + filename + ": " + err);
+  }
+  if (enableWriteAheadLog(hs_internal_db) != SQLITE_OK) {
+    cout << sqlite3_errmsg(hs_internal_db) << "\n\n";
+  }
+  exec(INIT);
+  try {
+    for (auto query : {SPO_INSERT, SOP_INSERT, PSO_INSERT, POS_INSERT,
+                       OSP_INSERT, OPS_INSERT}) {
+      prepare(query, insert_stmts);
+    }
+    const string *search_queries[8] = {
+        &SEARCH_XXX, &SEARCH_XXO, &SEARCH_XPX, &SEARCH_XPO,
+        &SEARCH_SXX, &SEARCH_SXO, &SEARCH_SPX, &SEARCH_SPO};
+    for (size_t i = 0; i < search_stmts.size(); ++i) {
+      vector<sqlite3_stmt *> stmts;
+      prepare(*search_queries[i], stmts);
+      search_stmts[i] = stmts.front();
+    }
+  } catch (...) {
+    for (auto stmt : insert_stmts) {
+      sqlite3_finalize(stmt);
+    }
+    for (auto stmt : search_stmts) {
+      sqlite3_finalize(stmt);
+    }
+    sqlite3_close(hs_internal_db);
+    throw;
+  }
+}
+
+Hexastore::~Hexastore() {
+  for (auto stmt : insert_stmts) {
+    sqlite3_finalize(stmt);
+  }
+  for (auto stmt : search_stmts) {
+    sqlite3_finalize(stmt);
+  }
+  sqlite3_close(hs_internal_db);
+}
+
+bool Hexastore::exec(const string &query) {
+  char *err = nullptr;
+  sqlite3_exec(hs_internal_db, query.c_str(), nullptr, nullptr, &err);
+  if (err != NULL) {
     cout << err << "\n\n";
+    sqlite3_free(err);
+    return false;
+  }
+  return true;
 }
 
-Hexastore::~Hexastore() { sqlite3_close(hs_internal_db); }
+void Hexastore::prepare(const string &query, vector<sqlite3_stmt *> &stmts) {
+  // a query may consist of several statements, each is prepared on its own
+  const char *tail = query.c_str();
+  while (*tail) {
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(hs_internal_db, tail, -1, &stmt, &tail) !=
+        SQLITE_OK) {
+      for (auto prepared : stmts) {
+        sqlite3_finalize(prepared);
+      }
+      stmts.clear();
+      throw runtime_error(string("could not prepare hexastore query: ") +
+                          sqlite3_errmsg(hs_internal_db));
+    }
+    // trailing whitespace does not yield a statement
+    if (stmt) {
+      stmts.push_back(stmt);
+    }
+  }
+}
 
-int Hexastore::callback(void *NotUsed, int argc, char **argv,
-                        char **azColName) {
-  for (int i = 0; i < argc; ++i) {
-    cout << azColName[i] << " " << (argv[i] ? argv[i] : "NULL") << endl;
+static void bindEdge(sqlite3_stmt *stmt, const array<string, 3> &edge) {
+  // queries refer to subject, predicate and object as ?1, ?2 and ?3
+  for (int i = 1; i <= sqlite3_bind_parameter_count(stmt); ++i) {
+    sqlite3_bind_text(stmt, i, edge[i - 1].data(), edge[i - 1].size(),
+                      SQLITE_STATIC);
   }
-  return 0;
 }
 
 void Hexastore::put(array<string, 3> edge) {
-  doPut(SPO_INSERT, edge);
-  doPut(SOP_INSERT, edge);
-  doPut(PSO_INSERT, edge);
-  doPut(POS_INSERT, edge);
-  doPut(OSP_INSERT, edge);
-  doPut(OPS_INSERT, edge);
+  putAll(vector<array<string, 3>>{edge});
 }
 
-void Hexastore::doPut(string query, array<string, 3> edge) {
-  string compiled_query = str(format(query) % edge[0] % edge[1] % edge[2]);
-  char *err;
-  sqlite3_exec(hs_internal_db, compiled_query.c_str(), callback, 0, &err);
-  if (err != NULL)
-    cout << err;
+void Hexastore::putAll(const vector<array<string, 3>> &edges) {
+  if (!exec("begin transaction;")) {
+    return;
+  }
+  for (auto &edge : edges) {
+    if (!doPut(edge)) {
+      exec("rollback transaction;");
+      return;
+    }
+  }
+  exec("commit transaction;");
+}
+
+bool Hexastore::doPut(const array<string, 3> &edge) {
+  for (auto stmt : insert_stmts) {
+    bindEdge(stmt, edge);
+    int rc = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    if (rc != SQLITE_DONE) {
+      cout << sqlite3_errmsg(hs_internal_db);
+      return false;
+    }
+  }
+  return true;
 }
 
 vector<hs_result> Hexastore::get(array<string, 3> edge_query,
                                  size_t result_size_hint) {
   vector<hs_result> result;
   result.reserve(result_size_hint);
-  string querystring;
-  if (edge_query[0] == "?") {
-    if (edge_query[1] == "?") {
-      if (edge_query[2] == "?") {
-        querystring = SEARCH_XXX;
-      } else {
-        querystring = SEARCH_XXO;
-      }
-    } else {
-      if (edge_query[2] == "?") {
-        querystring = SEARCH_XPX;
-      } else {
-        querystring = SEARCH_XPO;
-      }
-    }
-  } else {
-    if (edge_query[1] == "?") {
-      if (edge_query[2] == "?") {
-        querystring = SEARCH_SXX;
-      } else {
-        querystring = SEARCH_SXO;
-      }
-    } else {
-      if (edge_query[2] == "?") {
-        querystring = SEARCH_SPX;
-      } else {
-        querystring = SEARCH_SPO;
-      }
-    }
+  size_t query = (edge_query[0] != "?") << 2 | (edge_query[1] != "?") << 1 |
+                 (edge_query[2] != "?");
+  sqlite3_stmt *stmt = search_stmts[query];
+  bindEdge(stmt, edge_query);
+  int rc;
+  while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+    auto column = [stmt](int i) {
+      return string(
+          reinterpret_cast<const char *>(sqlite3_column_text(stmt, i)),
+          sqlite3_column_bytes(stmt, i));
+    };
+    result.emplace_back(column(0), column(1), column(2));
   }
-  string compiled_query =
-      str(format(querystring) % edge_query[0] % edge_query[1] % edge_query[2]);
-  // this lambda will collect all of our results, since it is called on every
-  // row of the result set
-  auto sqlite_cb_result_collector = [](void *cb, int argc, char **argv,
-                                       char **azColName) {
-    vector<hs_result> *res = static_cast<vector<hs_result> *>(cb);
-    res->emplace_back(argv[0], argv[1], argv[2]);
-    return 0;
-  };
-  char *err;
-  sqlite3_exec(hs_internal_db, compiled_query.c_str(),
-               sqlite_cb_result_collector, &result, &err);
-  if (err != NULL) {
-    cout << err;
+  if (rc != SQLITE_DONE) {
+    cout << sqlite3_errmsg(hs_internal_db);
   }
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
   return result;
 }
 
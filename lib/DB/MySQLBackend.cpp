@@ -0,0 +1,597 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <cppconn/driver.h>
+#include <cppconn/exception.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include <mysql_connection.h>
+
+#include <boost/log/sources/record_ostream.hpp>
+
+#include <phasar/DB/MySQLBackend.h>
+#include <phasar/Utils/Logger.h>
+
+using namespace psr;
+using namespace std;
+
+namespace psr {
+
+// Runs F and rethrows the exceptions of the MySQL connector as DBException
+template <typename F> static auto translateExceptions(F f) -> decltype(f()) {
+  try {
+    return f();
+  } catch (sql::SQLException &e) {
+    throw DBException(e.what(), e.getErrorCode(), e.getSQLState());
+  }
+}
+
+namespace {
+
+class MySQLResultSet : public DBResultSet {
+private:
+  unique_ptr<sql::ResultSet> res;
+
+public:
+  MySQLResultSet(sql::ResultSet *res) : res(res) {}
+
+  bool next() override {
+    return translateExceptions([&] { return res->next(); });
+  }
+
+  unsigned findColumn(const string &ColumnLabel) override {
+    return translateExceptions(
+        [&] { return unsigned(res->findColumn(ColumnLabel)); });
+  }
+
+  int getInt(unsigned ColumnIndex) override {
+    return translateExceptions([&] { return res->getInt(ColumnIndex); });
+  }
+
+  bool getBoolean(unsigned ColumnIndex) override {
+    return translateExceptions([&] { return res->getBoolean(ColumnIndex); });
+  }
+
+  string getString(unsigned ColumnIndex) override {
+    return translateExceptions(
+        [&] { return res->getString(ColumnIndex).asStdString(); });
+  }
+
+  string getBlob(unsigned ColumnIndex) override {
+    return translateExceptions([&] {
+      unique_ptr<istream> ist(res->getBlob(ColumnIndex));
+      return string(istreambuf_iterator<char>(*ist), {});
+    });
+  }
+};
+
+class MySQLStatement : public DBStatement {
+private:
+  unique_ptr<sql::PreparedStatement> pstmt;
+  // the connector reads blobs from streams when the statement is executed
+  vector<unique_ptr<istringstream>> blobs;
+
+public:
+  MySQLStatement(sql::PreparedStatement *pstmt) : pstmt(pstmt) {}
+
+  void setInt(unsigned ParameterIndex, int Value) override {
+    translateExceptions([&] { pstmt->setInt(ParameterIndex, Value); });
+  }
+
+  void setBoolean(unsigned ParameterIndex, bool Value) override {
+    translateExceptions([&] { pstmt->setBoolean(ParameterIndex, Value); });
+  }
+
+  void setString(unsigned ParameterIndex, const string &Value) override {
+    translateExceptions([&] { pstmt->setString(ParameterIndex, Value); });
+  }
+
+  void setBlob(unsigned ParameterIndex, const string &Value) override {
+    blobs.emplace_back(new istringstream(Value));
+    translateExceptions(
+        [&] { pstmt->setBlob(ParameterIndex, blobs.back().get()); });
+  }
+
+  void setNull(unsigned ParameterIndex) override {
+    translateExceptions([&] { pstmt->setNull(ParameterIndex, 0); });
+  }
+
+  int executeUpdate() override {
+    return translateExceptions([&] { return pstmt->executeUpdate(); });
+  }
+
+  unique_ptr<DBResultSet> executeQuery() override {
+    return translateExceptions([&] {
+      return unique_ptr<DBResultSet>(
+          new MySQLResultSet(pstmt->executeQuery()));
+    });
+  }
+};
+
+} // namespace
+
+static bool mysqlSchemeExists(sql::Connection *conn,
+                              const string &schema_name) {
+  unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+      "SELECT SCHEMA_NAME FROM INFORMATION_SCHEMA.SCHEMATA WHERE "
+      "SCHEMA_NAME=?"));
+  pstmt->setString(1, schema_name);
+  unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+  return res->next();
+}
+
+static void mysqlBuildScheme(sql::Connection *conn) {
+  auto lg = lg::get();
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Building database schema");
+
+  unique_ptr<sql::Statement> stmt(conn->createStatement());
+  static const string old_unique_checks(
+      "SET @OLD_UNIQUE_CHECKS=@@UNIQUE_CHECKS, UNIQUE_CHECKS=0; ");
+  stmt->execute(old_unique_checks);
+
+  static const string old_foreign_key_checks(
+      "SET @OLD_FOREIGN_KEY_CHECKS=@@FOREIGN_KEY_CHECKS, "
+      "FOREIGN_KEY_CHECKS=0; ");
+  stmt->execute(old_foreign_key_checks);
+
+  static const string old_sql_mode(
+      "SET @OLD_SQL_MODE=@@SQL_MODE, "
+      "SQL_MODE='TRADITIONAL,ALLOW_INVALID_DATES';");
+  stmt->execute(old_sql_mode);
+
+  static const string create_schema(
+      "CREATE SCHEMA IF NOT EXISTS `phasardb` DEFAULT CHARACTER SET utf8 ; ");
+  stmt->execute(create_schema);
+
+  static const string create_function(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`function` ( "
+      "`function_id` INT(11) NOT NULL AUTO_INCREMENT, "
+      "`identifier` VARCHAR(512) NULL DEFAULT NULL, "
+      "`declaration` TINYINT(1) NULL DEFAULT NULL, "
+      "`hash` VARCHAR(512) NULL DEFAULT NULL, "
+      "PRIMARY KEY (`function_id`)) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_function);
+
+  static const string create_ifds_ide_summary(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`ifds_ide_summary` ( "
+      "`ifds_ide_summary_id` INT(11) NOT NULL AUTO_INCREMENT, "
+      "`analysis` VARCHAR(512) NULL DEFAULT NULL, "
+      "`representation` BLOB NULL DEFAULT NULL, "
+      "PRIMARY KEY (`ifds_ide_summary_id`)) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_ifds_ide_summary);
+
+  static const string create_module(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`module` ( "
+      "`module_id` INT(11) NOT NULL AUTO_INCREMENT, "
+      "`identifier` VARCHAR(512) NULL DEFAULT NULL, "
+      "`hash` VARCHAR(512) NULL DEFAULT NULL, "
+      "`code` LONGBLOB NULL DEFAULT NULL, "
+      "PRIMARY KEY (`module_id`)) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_module);
+
+  static const string create_type(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`type` ( "
+      "`type_id` INT(11) NOT NULL AUTO_INCREMENT, "
+      "`identifier` VARCHAR(512) NULL DEFAULT NULL, "
+      "PRIMARY KEY (`type_id`)) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_type);
+
+  static const string create_type_hierarchy(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`type_hierarchy` ( "
+      "`type_hierarchy_id` INT(11) NOT NULL AUTO_INCREMENT, "
+      "`representation` LONGBLOB NULL DEFAULT NULL, "
+      "`representation_ref` VARCHAR(512) NULL DEFAULT NULL, "
+      "PRIMARY KEY (`type_hierarchy_id`)) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_type_hierarchy);
+
+  static const string create_global_variable(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`global_variable` ( "
+      "`global_variable_id` INT(11) NOT NULL AUTO_INCREMENT, "
+      "`identifier` VARCHAR(512) NULL DEFAULT NULL, "
+      "`declaration` TINYINT(1) NULL DEFAULT NULL, "
+      "PRIMARY KEY (`global_variable_id`)) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_global_variable);
+
+  static const string create_callgraph(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`callgraph` ( "
+      "`callgraph_id` INT(11) NOT NULL AUTO_INCREMENT, "
+      "`representation` LONGBLOB NULL DEFAULT NULL, "
+      "`representation_ref` VARCHAR(512) NULL DEFAULT NULL, "
+      "PRIMARY KEY (`callgraph_id`)) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_callgraph);
+
+  static const string create_points_to_graph(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`points-to_graph` ( "
+      "`points-to_graph_id` INT(11) NOT NULL AUTO_INCREMENT, "
+      "`representation` LONGBLOB NULL DEFAULT NULL, "
+      "`representation_ref` VARCHAR(512) NULL DEFAULT NULL, "
+      "PRIMARY KEY (`points-to_graph_id`)) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_points_to_graph);
+
+  static const string create_project(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`project` ( "
+      "`project_id` INT(11) NOT NULL AUTO_INCREMENT, "
+      "`identifier` VARCHAR(512) NULL DEFAULT NULL, "
+      "PRIMARY KEY (`project_id`)) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_project);
+
+  static const string create_project_has_module(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`project_has_module` ( "
+      "`project_id` INT(11) NOT NULL, "
+      "`module_id` INT(11) NOT NULL, "
+      "PRIMARY KEY (`project_id`, `module_id`), "
+      "INDEX `fk_project_has_module_module1_idx` (`module_id` ASC), "
+      "INDEX `fk_project_has_module_project1_idx` (`project_id` ASC), "
+      "CONSTRAINT `fk_project_has_module_project1` "
+      "FOREIGN KEY (`project_id`) "
+      "REFERENCES `phasardb`.`project` (`project_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE, "
+      "CONSTRAINT `fk_project_has_module_module1` "
+      "FOREIGN KEY (`module_id`) "
+      "REFERENCES `phasardb`.`module` (`module_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_project_has_module);
+
+  static const string create_module_has_callgraph(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`module_has_callgraph` ( "
+      "`module_id` INT(11) NOT NULL, "
+      "`callgraph_id` INT(11) NOT NULL, "
+      "PRIMARY KEY (`module_id`, `callgraph_id`), "
+      "INDEX `fk_module_has_callgraph_callgraph1_idx` (`callgraph_id` ASC), "
+      "INDEX `fk_module_has_callgraph_module1_idx` (`module_id` ASC), "
+      "CONSTRAINT `fk_module_has_callgraph_module1` "
+      "FOREIGN KEY (`module_id`) "
+      "REFERENCES `phasardb`.`module` (`module_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE, "
+      "CONSTRAINT `fk_module_has_callgraph_callgraph1` "
+      "FOREIGN KEY (`callgraph_id`) "
+      "REFERENCES `phasardb`.`callgraph` (`callgraph_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_module_has_callgraph);
+
+  static const string create_callgraph_has_points_to_graph(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`callgraph_has_points-to_graph` ( "
+      "`callgraph_id` INT(11) NOT NULL, "
+      "`points-to_graph_id` INT(11) NOT NULL, "
+      "PRIMARY KEY (`callgraph_id`, `points-to_graph_id`), "
+      "INDEX `fk_callgraph_has_points-to_graph_points-to_graph1_idx` "
+      "(`points-to_graph_id` ASC), "
+      "INDEX `fk_callgraph_has_points-to_graph_callgraph1_idx` (`callgraph_id` "
+      "ASC), "
+      "CONSTRAINT `fk_callgraph_has_points-to_graph_callgraph1` "
+      "FOREIGN KEY (`callgraph_id`) "
+      "REFERENCES `phasardb`.`callgraph` (`callgraph_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE, "
+      "CONSTRAINT `fk_callgraph_has_points-to_graph_points-to_graph1` "
+      "FOREIGN KEY (`points-to_graph_id`) "
+      "REFERENCES `phasardb`.`points-to_graph` (`points-to_graph_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_callgraph_has_points_to_graph);
+
+  static const string create_module_has_function(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`module_has_function` ( "
+      "`module_id` INT(11) NOT NULL, "
+      "`function_id` INT(11) NOT NULL, "
+      "PRIMARY KEY (`module_id`, `function_id`), "
+      "INDEX `fk_module_has_function_function1_idx` (`function_id` ASC), "
+      "INDEX `fk_module_has_function_module1_idx` (`module_id` ASC), "
+      "CONSTRAINT `fk_module_has_function_module1` "
+      "FOREIGN KEY (`module_id`) "
+      "REFERENCES `phasardb`.`module` (`module_id`) "
+      "ON DELETE NO ACTION "
+      "ON UPDATE NO ACTION, "
+      "CONSTRAINT `fk_module_has_function_function1` "
+      "FOREIGN KEY (`function_id`) "
+      "REFERENCES `phasardb`.`function` (`function_id`) "
+      "ON DELETE NO ACTION "
+      "ON UPDATE NO ACTION) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_module_has_function);
+
+  static const string create_module_has_global_variable(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`module_has_global_variable` ( "
+      "`module_id` INT(11) NOT NULL, "
+      "`global_variable_id` INT(11) NOT NULL, "
+      "PRIMARY KEY (`module_id`, `global_variable_id`), "
+      "INDEX `fk_module_has_global_variable_global_variable1_idx` "
+      "(`global_variable_id` ASC), "
+      "INDEX `fk_module_has_global_variable_module1_idx` (`module_id` ASC), "
+      "CONSTRAINT `fk_module_has_global_variable_module1` "
+      "FOREIGN KEY (`module_id`) "
+      "REFERENCES `phasardb`.`module` (`module_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE, "
+      "CONSTRAINT `fk_module_has_global_variable_global_variable1` "
+      "FOREIGN KEY (`global_variable_id`) "
+      "REFERENCES `phasardb`.`global_variable` (`global_variable_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_module_has_global_variable);
+
+  static const string create_module_has_type_hierarchy(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`module_has_type_hierarchy` ( "
+      "`module_id` INT(11) NOT NULL, "
+      "`type_hierarchy_id` INT(11) NOT NULL, "
+      "PRIMARY KEY (`module_id`, `type_hierarchy_id`), "
+      "INDEX `fk_module_has_type_hierarchy_type_hierarchy1_idx` "
+      "(`type_hierarchy_id` ASC), "
+      "INDEX `fk_module_has_type_hierarchy_module1_idx` (`module_id` ASC), "
+      "CONSTRAINT `fk_module_has_type_hierarchy_module1` "
+      "FOREIGN KEY (`module_id`) "
+      "REFERENCES `phasardb`.`module` (`module_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE, "
+      "CONSTRAINT `fk_module_has_type_hierarchy_type_hierarchy1` "
+      "FOREIGN KEY (`type_hierarchy_id`) "
+      "REFERENCES `phasardb`.`type_hierarchy` (`type_hierarchy_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_module_has_type_hierarchy);
+
+  static const string create_module_has_type(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`module_has_type` ( "
+      "`module_id` INT(11) NOT NULL, "
+      "`type_id` INT(11) NOT NULL, "
+      "PRIMARY KEY (`module_id`, `type_id`), "
+      "INDEX `fk_module_has_type_type1_idx` (`type_id` ASC), "
+      "INDEX `fk_module_has_type_module1_idx` (`module_id` ASC), "
+      "CONSTRAINT `fk_module_has_type_module1` "
+      "FOREIGN KEY (`module_id`) "
+      "REFERENCES `phasardb`.`module` (`module_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE, "
+      "CONSTRAINT `fk_module_has_type_type1` "
+      "FOREIGN KEY (`type_id`) "
+      "REFERENCES `phasardb`.`type` (`type_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_module_has_type);
+
+  static const string create_type_hierarchy_has_type(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`type_hierarchy_has_type` ( "
+      "`type_hierarchy_id` INT(11) NOT NULL, "
+      "`type_id` INT(11) NOT NULL, "
+      "PRIMARY KEY (`type_hierarchy_id`, `type_id`), "
+      "INDEX `fk_type_hierarchy_has_type_type1_idx` (`type_id` ASC), "
+      "INDEX `fk_type_hierarchy_has_type_type_hierarchy1_idx` "
+      "(`type_hierarchy_id` ASC), "
+      "CONSTRAINT `fk_type_hierarchy_has_type_type_hierarchy1` "
+      "FOREIGN KEY (`type_hierarchy_id`) "
+      "REFERENCES `phasardb`.`type_hierarchy` (`type_hierarchy_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE, "
+      "CONSTRAINT `fk_type_hierarchy_has_type_type1` "
+      "FOREIGN KEY (`type_id`) "
+      "REFERENCES `phasardb`.`type` (`type_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_type_hierarchy_has_type);
+
+  static const string create_function_has_ifds_ide_summary(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`function_has_ifds_ide_summary` ( "
+      "`function_id` INT(11) NOT NULL, "
+      "`ifds_ide_summary_id` INT(11) NOT NULL, "
+      "PRIMARY KEY (`function_id`, `ifds_ide_summary_id`), "
+      "INDEX `fk_function_has_ifds_ide_summary_ifds_ide_summary1_idx` "
+      "(`ifds_ide_summary_id` ASC), "
+      "INDEX `fk_function_has_ifds_ide_summary_function1_idx` (`function_id` "
+      "ASC), "
+      "CONSTRAINT `fk_function_has_ifds_ide_summary_function1` "
+      "FOREIGN KEY (`function_id`) "
+      "REFERENCES `phasardb`.`function` (`function_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE, "
+      "CONSTRAINT `fk_function_has_ifds_ide_summary_ifds_ide_summary1` "
+      "FOREIGN KEY (`ifds_ide_summary_id`) "
+      "REFERENCES `phasardb`.`ifds_ide_summary` (`ifds_ide_summary_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_function_has_ifds_ide_summary);
+
+  static const string create_function_has_points_to_graph(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`function_has_points-to_graph` ( "
+      "`function_id` INT(11) NOT NULL, "
+      "`points-to_graph_id` INT(11) NOT NULL, "
+      "PRIMARY KEY (`function_id`, `points-to_graph_id`), "
+      "INDEX `fk_function_has_points-to_graph_points-to_graph1_idx` "
+      "(`points-to_graph_id` ASC), "
+      "INDEX `fk_function_has_points-to_graph_function1_idx` (`function_id` "
+      "ASC), "
+      "CONSTRAINT `fk_function_has_points-to_graph_function1` "
+      "FOREIGN KEY (`function_id`) "
+      "REFERENCES `phasardb`.`function` (`function_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE, "
+      "CONSTRAINT `fk_function_has_points-to_graph_points-to_graph1` "
+      "FOREIGN KEY (`points-to_graph_id`) "
+      "REFERENCES `phasardb`.`points-to_graph` (`points-to_graph_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_function_has_points_to_graph);
+
+  static const string create_type_has_virtual_function(
+      "CREATE TABLE IF NOT EXISTS `phasardb`.`type_has_virtual_function` ( "
+      "`type_id` INT(11) NOT NULL, "
+      "`function_id` INT(11) NOT NULL, "
+      "`vtable_index` INT(11) NULL DEFAULT NULL, "
+      "PRIMARY KEY (`type_id`, `function_id`), "
+      "INDEX `fk_type_has_function_function1_idx` (`function_id` ASC), "
+      "INDEX `fk_type_has_function_type1_idx` (`type_id` ASC), "
+      "CONSTRAINT `fk_type_has_function_type1` "
+      "FOREIGN KEY (`type_id`) "
+      "REFERENCES `phasardb`.`type` (`type_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE, "
+      "CONSTRAINT `fk_type_has_function_function1` "
+      "FOREIGN KEY (`function_id`) "
+      "REFERENCES `phasardb`.`function` (`function_id`) "
+      "ON DELETE CASCADE "
+      "ON UPDATE CASCADE) "
+      "ENGINE = InnoDB "
+      "DEFAULT CHARACTER SET = utf8 "
+      "COLLATE = utf8_unicode_ci; ");
+  stmt->execute(create_type_has_virtual_function);
+
+  static const string sql_mode("SET SQL_MODE=@OLD_SQL_MODE; ");
+  stmt->execute(sql_mode);
+
+  static const string foreign_key_checks(
+      "SET FOREIGN_KEY_CHECKS=@OLD_FOREIGN_KEY_CHECKS; ");
+  stmt->execute(foreign_key_checks);
+
+  static const string unique_checks("SET UNIQUE_CHECKS=@OLD_UNIQUE_CHECKS; ");
+  stmt->execute(unique_checks);
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Database schema done");
+}
+
+static void mysqlDropScheme(sql::Connection *conn) {
+  unique_ptr<sql::Statement> stmt(conn->createStatement());
+  const string drop_database("DROP DATABASE IF EXISTS `phasardb`");
+  stmt->execute(drop_database);
+  cout << "DROPED DATABASE SCHEMA" << endl;
+  this_thread::sleep_for(5s);
+}
+
+MySQLBackend::MySQLBackend(const string &server_address, const string &user,
+                           const string &password, const string &schema_name)
+    : schema_name(schema_name) {
+  auto lg = lg::get();
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Connect to database");
+  translateExceptions([&] {
+    driver = get_driver_instance();
+    conn = driver->connect(server_address, user, password);
+  });
+  try {
+    if (!schemeExists()) {
+      buildScheme();
+    }
+    translateExceptions([&] {
+      conn->setSchema(schema_name);
+      unique_ptr<sql::PreparedStatement> pstmt(
+          conn->prepareStatement("SET foreign_key_checks = 0"));
+      pstmt->executeQuery();
+    });
+  } catch (...) {
+    delete conn;
+    throw;
+  }
+}
+
+MySQLBackend::~MySQLBackend() {
+  auto lg = lg::get();
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Close database connection");
+  delete conn;
+}
+
+string MySQLBackend::getName() const { return schema_name; }
+
+unique_ptr<DBStatement> MySQLBackend::prepareStatement(const string &SQL) {
+  return translateExceptions([&] {
+    return unique_ptr<DBStatement>(
+        new MySQLStatement(conn->prepareStatement(SQL)));
+  });
+}
+
+void MySQLBackend::beginTransaction() {
+  translateExceptions([&] {
+    unique_ptr<sql::Statement> stmt(conn->createStatement());
+    stmt->execute("START TRANSACTION");
+  });
+}
+
+void MySQLBackend::commit() {
+  translateExceptions([&] { conn->commit(); });
+}
+
+void MySQLBackend::rollback() {
+  translateExceptions([&] { conn->rollback(); });
+}
+
+bool MySQLBackend::schemeExists() {
+  return translateExceptions(
+      [&] { return mysqlSchemeExists(conn, schema_name); });
+}
+
+void MySQLBackend::buildScheme() {
+  translateExceptions([&] { mysqlBuildScheme(conn); });
+}
+
+void MySQLBackend::dropScheme() {
+  translateExceptions([&] { mysqlDropScheme(conn); });
+}
+
+} // namespace psr
@@ -18,8 +18,10 @@
 #include <clang/Frontend/TextDiagnosticPrinter.h>
 
 #include <llvm/Analysis/AliasAnalysis.h>
+#include <llvm/Analysis/AssumptionCache.h>
 #include <llvm/Analysis/BasicAliasAnalysis.h>
 #include <llvm/Analysis/CFLAndersAliasAnalysis.h>
+#include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/Function.h>
@@ -43,6 +45,7 @@
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/Macros.h>
 #include <phasar/Utils/PAMMMacros.h>
+#include <phasar/Utils/WorkStealingScheduler.h>
 
 using namespace psr;
 using namespace std;
@@ -72,15 +75,31 @@ const std::set<std::string> ProjectIRDB::unknown_flags = {
 ProjectIRDB::ProjectIRDB(enum IRDBOptions Opt) : Options(Opt) {}
 
 ProjectIRDB::ProjectIRDB(const std::vector<std::string> &IRFiles,
-                         enum IRDBOptions Opt)
+                         enum IRDBOptions Opt, unsigned NumThreads)
     : Options(Opt) {
-  for (const auto &File : IRFiles) {
-    source_files.insert(File);
+  // Every file is parsed into a context of its own, hence the files can be
+  // parsed and verified concurrently. For whole-program analysis, all files
+  // are parsed into one shared context instead, such that linkForWPA() can
+  // link them directly. As a context must not be used by several threads at
+  // once, the files are parsed one after another in that case.
+  std::unique_ptr<llvm::LLVMContext> SharedContext;
+  if ((Opt & IRDBOptions::WPA) && IRFiles.size() > 1) {
+    SharedContext.reset(new llvm::LLVMContext);
+    NumThreads = 1;
+  }
+  std::vector<std::unique_ptr<llvm::LLVMContext>> Contexts(IRFiles.size());
+  std::vector<std::unique_ptr<llvm::Module>> Modules(IRFiles.size());
+  WorkStealingScheduler<std::size_t> Parsing(NumThreads, [&](std::size_t Idx) {
+    const auto &File = IRFiles[Idx];
     // if we have a file that is already compiled to llvm ir
     if (File.find(".ll") != File.npos && boost::filesystem::exists(File)) {
       llvm::SMDiagnostic Diag;
-      std::unique_ptr<llvm::LLVMContext> C(new llvm::LLVMContext);
-      std::unique_ptr<llvm::Module> M = llvm::parseIRFile(File, Diag, *C);
+      std::unique_ptr<llvm::LLVMContext> C;
+      if (!SharedContext) {
+        C.reset(new llvm::LLVMContext);
+      }
+      std::unique_ptr<llvm::Module> M = llvm::parseIRFile(
+          File, Diag, SharedContext ? *SharedContext : *C);
       bool broken_debug_info = false;
       if (M.get() == nullptr)
         Diag.print(File.c_str(), llvm::errs());
@@ -92,14 +111,29 @@ ProjectIRDB::ProjectIRDB(const std::vector<std::string> &IRFiles,
       if (broken_debug_info) {
         std::cout << "caution: debug info is broken\n";
       }
-
-      buildFunctionModuleMapping(M.get());
-      buildGlobalModuleMapping(M.get());
-      contexts.insert(std::make_pair(File, std::move(C)));
-      modules.insert(std::make_pair(File, std::move(M)));
+      Contexts[Idx] = std::move(C);
+      Modules[Idx] = std::move(M);
     } else {
       throw std::invalid_argument(File + " is not a valid llvm module");
     }
+  });
+  for (std::size_t Idx = 0; Idx < IRFiles.size(); ++Idx) {
+    Parsing.push(Idx);
+  }
+  Parsing.run();
+  // the mappings are built in the order of the files
+  for (std::size_t Idx = 0; Idx < IRFiles.size(); ++Idx) {
+    const auto &File = IRFiles[Idx];
+    source_files.insert(File);
+    buildFunctionModuleMapping(Modules[Idx].get());
+    buildGlobalModuleMapping(Modules[Idx].get());
+    if (Contexts[Idx]) {
+      contexts.insert(std::make_pair(File, std::move(Contexts[Idx])));
+    }
+    modules.insert(std::make_pair(File, std::move(Modules[Idx])));
+  }
+  if (SharedContext) {
+    contexts.insert(std::make_pair(IRFiles.front(), std::move(SharedContext)));
   }
   cout << "All modules loaded\n";
 }
@@ -256,14 +290,25 @@ void ProjectIRDB::compileAndAddToDB(std::vector<const char *> CompileCommand) {
   }
 }
 
-void ProjectIRDB::preprocessModule(llvm::Module *M) {
+void ProjectIRDB::preprocessModule(llvm::Module *M, unsigned NumThreads,
+                                   std::size_t FirstValueID, bool Concurrent) {
   // WARNING: Activating passes lead to higher time in llvmIRToString
   PAMM_GET_INSTANCE;
   auto &lg = lg::get();
-  // add moduleID to timer name if performing MWA!
-  START_TIMER("LLVM Passes", PAMM_SEVERITY_LEVEL::Full);
+  // PAMM's timers cannot be shared by modules that are preprocessed
+  // concurrently, preprocessIR() measures the whole stage instead.
+  if (!Concurrent) {
+    // add moduleID to timer name if performing MWA!
+    START_TIMER("LLVM Passes", PAMM_SEVERITY_LEVEL::Full);
+  }
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
                 << "Preprocess module: " << M->getModuleIdentifier());
+  // The hash has to be computed before the ids are annotated, which depend on
+  // the modules that have been preprocessed before.
+  std::string ModuleHash;
+  if (Cache && !(Options & IRDBOptions::LAZY_PTG)) {
+    ModuleHash = Cache->getModuleHash(*M);
+  }
 
   // TODO Have a look at this stuff from the future at some point in time
   /// PassManagerBuilder - This class is used to set up a standard
@@ -297,13 +342,11 @@ void ProjectIRDB::preprocessModule(llvm::Module *M) {
   ///                        addMyLoopPass);
   ///   ...
   // But for now, stick to what is well debugged
+  // Note that mem2reg has already been run by preprocessIR().
   llvm::legacy::PassManager PM;
-  if (Options & IRDBOptions::MEM2REG) {
-    llvm::FunctionPass *Mem2Reg = llvm::createPromoteMemoryToRegisterPass();
-    PM.add(Mem2Reg);
-  }
   GeneralStatisticsPass *GSP = new GeneralStatisticsPass();
-  ValueAnnotationPass *VAP = new ValueAnnotationPass(M->getContext());
+  ValueAnnotationPass *VAP =
+      new ValueAnnotationPass(M->getContext(), FirstValueID);
   // Mandatory passed for the alias analysis
   auto BasicAAWP = llvm::createBasicAAWrapperPass();
   auto TargetLibraryWP = new llvm::TargetLibraryInfoWrapperPass();
@@ -337,41 +380,151 @@ void ProjectIRDB::preprocessModule(llvm::Module *M) {
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, WARNING)
                   << "AnalysisController: debug info is broken.");
   }
-  for (auto RR : GSP->getRetResInstructions()) {
-    ret_res_instructions.insert(RR);
-  }
-  for (auto A : GSP->getAllocaInstructions()) {
-    alloca_instructions.insert(A);
+  {
+    std::lock_guard<std::mutex> Lock(*preprocess_mtx);
+    for (auto RR : GSP->getRetResInstructions()) {
+      ret_res_instructions.insert(RR);
+    }
+    for (auto A : GSP->getAllocaInstructions()) {
+      alloca_instructions.insert(A);
+    }
+    // Obtain the allocated types found in the module
+    allocated_types = GSP->getAllocatedTypes();
+  }
+  bool PartitionPTG = static_cast<bool>(Options & IRDBOptions::PARTITION_PTG);
+  if (!Concurrent) {
+    STOP_TIMER("LLVM Passes", PAMM_SEVERITY_LEVEL::Full);
+    cout << "PTG construction ...\n";
+    START_TIMER("PTG Construction", PAMM_SEVERITY_LEVEL::Core);
+    START_TIMER(PartitionPTG ? "PTG Partitioned Alias Queries"
+                             : "PTG Exhaustive Alias Queries",
+                PAMM_SEVERITY_LEVEL::Full);
+  }
+  // Restore the points-to graphs of an unchanged module. Functions that are
+  // missing in the cache entry are constructed as usual.
+  std::map<std::string, std::unique_ptr<PointsToGraph>> CachedPTGs;
+  bool UseCachedPTGs = !ModuleHash.empty() &&
+                       Cache->loadPointsToGraphs(*M, ModuleHash, CachedPTGs);
+  if (UseCachedPTGs) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                  << "Restored " << CachedPTGs.size()
+                  << " points-to graphs from the analysis cache");
+    for (auto &Entry : CachedPTGs) {
+      insertPointsToGraph(Entry.first, Entry.second.release());
+    }
+    std::lock_guard<std::mutex> Lock(*ptgs_mtx);
+    for (auto &Entry : CachedPTGs) {
+      restored_ptgs.insert(Entry.first);
+    }
   }
-  // Obtain the allocated types found in the module
-  allocated_types = GSP->getAllocatedTypes();
-  STOP_TIMER("LLVM Passes", PAMM_SEVERITY_LEVEL::Full);
-  cout << "PTG construction ...\n";
-  START_TIMER("PTG Construction", PAMM_SEVERITY_LEVEL::Core);
   // Obtain the very important alias analysis results
   // and construct the intra-procedural points-to graphs.
-  REG_COUNTER("GS Pointer", 0, PAMM_SEVERITY_LEVEL::Core)
-  for (auto &F : *M) {
-    // When module-wise analysis is performed, declarations might occure
-    // causing meaningless points-to graphs to be produced.
-    if (!F.isDeclaration()) {
-      llvm::BasicAAResult BAAResult =
-          createLegacyPMBasicAAResult(*BasicAAWP, F);
-      llvm::AAResults AARes =
-          llvm::createLegacyPMAAResults(*BasicAAWP, F, BAAResult);
-      // This line is a major slowdown
-      // The problem comes from the generation of PtG which is far too slow
-      // due to the use of llvmIRToString (without it, the generation of PtG is
-      // very acceptable)
-      insertPointsToGraph(F.getName().str(), new PointsToGraph(AARes, &F));
-    }
-  }
-  STOP_TIMER("PTG Construction", PAMM_SEVERITY_LEVEL::Core);
-  cout << "PTG construction ended\n";
+  if (Options & IRDBOptions::LAZY_PTG) {
+    // The points-to graphs are constructed by getPointsToGraph() as soon as
+    // they are requested.
+  } else if (NumThreads <= 1) {
+    for (auto &F : *M) {
+      // When module-wise analysis is performed, declarations might occure
+      // causing meaningless points-to graphs to be produced.
+      if (!F.isDeclaration() && !CachedPTGs.count(F.getName().str())) {
+        llvm::BasicAAResult BAAResult =
+            createLegacyPMBasicAAResult(*BasicAAWP, F);
+        llvm::AAResults AARes =
+            llvm::createLegacyPMAAResults(*BasicAAWP, F, BAAResult);
+        // This line is a major slowdown
+        // The problem comes from the generation of PtG which is far too slow
+        // due to the use of llvmIRToString (without it, the generation of PtG
+        // is very acceptable)
+        insertPointsToGraph(F.getName().str(),
+                            new PointsToGraph(AARes, &F, false, PartitionPTG));
+      }
+    }
+  } else {
+    // The slots of the points-to graph map are created up front, such that
+    // the workers only write to their own, already existing entry and the map
+    // itself is never modified concurrently.
+    typedef std::pair<llvm::Function *, std::unique_ptr<PointsToGraph> *>
+        PTGTask_t;
+    std::vector<PTGTask_t> Tasks;
+    {
+      std::lock_guard<std::mutex> Lock(*ptgs_mtx);
+      for (auto &F : *M) {
+        if (!F.isDeclaration()) {
+          auto &Slot = ptgs[F.getName().str()];
+          if (!Slot) {
+            Tasks.emplace_back(&F, &Slot);
+          }
+        }
+      }
+    }
+    const llvm::TargetLibraryInfo &TLI = TargetLibraryWP->getTLI();
+    WorkStealingScheduler<PTGTask_t> PTGConstruction(
+        NumThreads, [&](PTGTask_t Task) {
+          Task.second->reset(constructPointsToGraph(Task.first, TLI));
+        });
+    for (auto &Task : Tasks) {
+      PTGConstruction.push(Task);
+    }
+    PTGConstruction.run();
+  }
+  if (!Concurrent) {
+    PAUSE_TIMER(PartitionPTG ? "PTG Partitioned Alias Queries"
+                             : "PTG Exhaustive Alias Queries",
+                PAMM_SEVERITY_LEVEL::Full);
+    STOP_TIMER("PTG Construction", PAMM_SEVERITY_LEVEL::Core);
+    cout << "PTG construction ended\n";
+  }
+  if (!ModuleHash.empty() && !UseCachedPTGs) {
+    std::map<std::string, const PointsToGraph *> ModulePTGs;
+    {
+      std::lock_guard<std::mutex> Lock(*ptgs_mtx);
+      for (auto &F : *M) {
+        auto Search = ptgs.find(F.getName().str());
+        if (!F.isDeclaration() && Search != ptgs.end()) {
+          ModulePTGs[Search->first] = Search->second.get();
+        }
+      }
+    }
+    Cache->storePointsToGraphs(*M, ModuleHash, ModulePTGs);
+  }
 
   buildIDModuleMapping(M);
 }
 
+void ProjectIRDB::useAnalysisCache(const std::string &CacheDirectory) {
+  // The points-to graphs depend on the alias analyses that are used by
+  // constructPointsToGraph() and on the options of their construction
+  std::string Configuration =
+      "aa=basic,cfl-anders;must-alias-only=0;partition=" +
+      std::to_string(static_cast<bool>(Options & IRDBOptions::PARTITION_PTG)) +
+      ";lazy=" +
+      std::to_string(static_cast<bool>(Options & IRDBOptions::LAZY_PTG));
+  Cache.reset(new AnalysisCache(CacheDirectory, Configuration));
+}
+
+void ProjectIRDB::promoteMemoryToRegister(llvm::Module *M) {
+  llvm::legacy::PassManager PM;
+  PM.add(llvm::createPromoteMemoryToRegisterPass());
+  PM.run(*M);
+}
+
+PointsToGraph *
+ProjectIRDB::constructPointsToGraph(llvm::Function *F,
+                                    const llvm::TargetLibraryInfo &TLI) {
+  // Every call uses its own assumption cache and alias analysis results, as
+  // those cache intermediate results while answering queries. The results
+  // are the ones createLegacyPMAAResults() combines for the sequential
+  // construction, BasicAA refined by CFLAnders.
+  llvm::AssumptionCache AC(*F);
+  llvm::BasicAAResult BAAResult(F->getParent()->getDataLayout(), TLI, AC);
+  llvm::CFLAndersAAResult CFLAndersResult(TLI);
+  llvm::AAResults AARes(TLI);
+  AARes.addAAResult(BAAResult);
+  AARes.addAAResult(CFLAndersResult);
+  return new PointsToGraph(
+      AARes, F, false, static_cast<bool>(Options & IRDBOptions::PARTITION_PTG));
+}
+
 void ProjectIRDB::linkForWPA() {
   // Linking llvm modules:
   // Unfortunately linking between different contexts is currently not possible.
@@ -386,24 +539,27 @@ void ProjectIRDB::linkForWPA() {
     for (auto &entry : modules) {
       // we do not want to link a module with itself!
       if (MainMod != entry.second.get()) {
-        // reload the modules into the module containing the main function
-        std::string IRBuffer;
-        llvm::raw_string_ostream RSO(IRBuffer);
-        llvm::WriteBitcodeToFile(entry.second.get(), RSO);
-        RSO.flush();
-        llvm::SMDiagnostic ErrorDiagnostics;
-        std::unique_ptr<llvm::MemoryBuffer> MemBuffer =
-            llvm::MemoryBuffer::getMemBuffer(IRBuffer);
-        std::unique_ptr<llvm::Module> TmpMod =
-            llvm::parseIR(*MemBuffer, ErrorDiagnostics, MainMod->getContext());
-        bool broken_debug_info = false;
-        if (TmpMod.get() == nullptr ||
-            llvm::verifyModule(*TmpMod, &llvm::errs(), &broken_debug_info)) {
-          std::cout << "module is broken!\nabort!" << std::endl;
-          DIE_HARD;
-        }
-        if (broken_debug_info) {
-          std::cout << "debug info is broken" << std::endl;
+        std::unique_ptr<llvm::Module> TmpMod;
+        if (&entry.second->getContext() == &MainMod->getContext()) {
+          // modules that already share the context of the main module can be
+          // linked directly
+          TmpMod = std::move(entry.second);
+        } else {
+          // reload the modules into the module containing the main function,
+          // they have been verified when they were loaded
+          std::string IRBuffer;
+          llvm::raw_string_ostream RSO(IRBuffer);
+          llvm::WriteBitcodeToFile(entry.second.get(), RSO);
+          RSO.flush();
+          llvm::SMDiagnostic ErrorDiagnostics;
+          std::unique_ptr<llvm::MemoryBuffer> MemBuffer =
+              llvm::MemoryBuffer::getMemBuffer(IRBuffer);
+          TmpMod = llvm::parseIR(*MemBuffer, ErrorDiagnostics,
+                                 MainMod->getContext());
+          if (TmpMod.get() == nullptr) {
+            std::cout << "module is broken!\nabort!" << std::endl;
+            DIE_HARD;
+          }
         }
         // now we can safely perform the linking
         if (llvm::Linker::linkModules(*MainMod, std::move(TmpMod),
@@ -450,10 +606,59 @@ void ProjectIRDB::linkForWPA() {
   }
 }
 
-void ProjectIRDB::preprocessIR() {
-  for (llvm::Module *M : getAllModules()) {
-    preprocessModule(M);
+void ProjectIRDB::preprocessIR(unsigned NumThreads) {
+  PAMM_GET_INSTANCE;
+  REG_COUNTER("GS Pointer", 0, PAMM_SEVERITY_LEVEL::Core)
+  REG_COUNTER("PTG Alias Queries", 0, PAMM_SEVERITY_LEVEL::Full)
+  std::set<llvm::Module *> AllModules = getAllModules();
+  std::vector<llvm::Module *> Modules(AllModules.begin(), AllModules.end());
+  std::set<llvm::LLVMContext *> Contexts;
+  for (llvm::Module *M : Modules) {
+    Contexts.insert(&M->getContext());
+  }
+  if (NumThreads <= 1 || Modules.size() <= 1 ||
+      Contexts.size() < Modules.size()) {
+    // the threads, if any, are used for the points-to graphs of the module
+    for (llvm::Module *M : Modules) {
+      if (Options & IRDBOptions::MEM2REG) {
+        promoteMemoryToRegister(M);
+      }
+      preprocessModule(
+          M, NumThreads,
+          ValueAnnotationPass::reserveValueIDs(
+              ValueAnnotationPass::countAnnotatedValues(*M)),
+          false);
+    }
+    return;
+  }
+  // Every module lives in its own context, so the modules can be
+  // preprocessed concurrently. Only the reservation of the
+  // value ids is sequential, such that every module gets the same ids as it
+  // would get if the modules were preprocessed one after another. As mem2reg
+  // removes instructions, it has to be run before the ids are reserved.
+  START_TIMER("IR Preprocessing", PAMM_SEVERITY_LEVEL::Core);
+  if (Options & IRDBOptions::MEM2REG) {
+    WorkStealingScheduler<llvm::Module *> Mem2Reg(
+        NumThreads, [&](llvm::Module *M) { promoteMemoryToRegister(M); });
+    for (llvm::Module *M : Modules) {
+      Mem2Reg.push(M);
+    }
+    Mem2Reg.run();
   }
+  std::vector<std::size_t> FirstValueIDs;
+  for (llvm::Module *M : Modules) {
+    FirstValueIDs.push_back(ValueAnnotationPass::reserveValueIDs(
+        ValueAnnotationPass::countAnnotatedValues(*M)));
+  }
+  WorkStealingScheduler<std::size_t> Preprocessing(
+      NumThreads, [&](std::size_t Idx) {
+        preprocessModule(Modules[Idx], 1, FirstValueIDs[Idx], true);
+      });
+  for (std::size_t Idx = 0; Idx < Modules.size(); ++Idx) {
+    Preprocessing.push(Idx);
+  }
+  Preprocessing.run();
+  STOP_TIMER("IR Preprocessing", PAMM_SEVERITY_LEVEL::Core);
 }
 
 llvm::Module *ProjectIRDB::getWPAModule() {
@@ -471,6 +676,20 @@ void ProjectIRDB::buildFunctionModuleMapping(llvm::Module *M) {
   }
 }
 
+void ProjectIRDB::updateFunctionModuleMapping(llvm::Module *M) {
+  for (auto It = functionToModuleMap.begin();
+       It != functionToModuleMap.end();) {
+    if (It->second == M->getModuleIdentifier() && !M->getFunction(It->first)) {
+      It = functionToModuleMap.erase(It);
+    } else {
+      ++It;
+    }
+  }
+  buildFunctionModuleMapping(M);
+  // the functions are collected from the mapping on the next request
+  functions.clear();
+}
+
 void ProjectIRDB::buildGlobalModuleMapping(llvm::Module *M) {
   for (auto &global : M->globals()) {
     globals[global.getName().str()] = M->getModuleIdentifier();
@@ -478,10 +697,26 @@ void ProjectIRDB::buildGlobalModuleMapping(llvm::Module *M) {
 }
 
 void ProjectIRDB::buildIDModuleMapping(llvm::Module *M) {
+  // The metadata ids are only parsed once here, all further lookups use the
+  // side tables.
+  std::lock_guard<std::mutex> Lock(*preprocess_mtx);
   for (auto &F : *M) {
     for (auto &BB : F) {
       for (auto &I : BB) {
-        instructions[stol(getMetaDataID(&I))] = &I;
+        std::size_t id = stoul(getMetaDataID(&I));
+        if (instructions.empty()) {
+          FirstInstructionID = id;
+        } else if (id < FirstInstructionID) {
+          // a module with lower ids has been preprocessed after this one
+          instructions.insert(instructions.begin(), FirstInstructionID - id,
+                              nullptr);
+          FirstInstructionID = id;
+        }
+        if (id - FirstInstructionID >= instructions.size()) {
+          instructions.resize(id - FirstInstructionID + 1, nullptr);
+        }
+        instructions[id - FirstInstructionID] = &I;
+        instruction_ids[&I] = id;
       }
     }
   }
@@ -492,8 +727,10 @@ bool ProjectIRDB::containsSourceFile(const std::string &src) {
 }
 
 llvm::LLVMContext *ProjectIRDB::getLLVMContext(const std::string &name) {
-  if (contexts.count(name))
-    return contexts[name].get();
+  // modules may share a context, which is only stored once
+  auto Search = modules.find(name);
+  if (Search != modules.end() && Search->second)
+    return &Search->second->getContext();
   return nullptr;
 }
 
@@ -521,8 +758,10 @@ llvm::Module *ProjectIRDB::getModuleDefiningFunction(const std::string &name) {
 }
 
 llvm::Function *ProjectIRDB::getFunction(const std::string &name) {
-  if (functionToModuleMap.count(name))
-    return modules[functionToModuleMap[name]]->getFunction(name);
+  // only uses lookups that never insert, such that concurrent calls are safe
+  auto Search = functionToModuleMap.find(name);
+  if (Search != functionToModuleMap.end())
+    return modules.at(Search->second)->getFunction(name);
   return nullptr;
 }
 
@@ -535,24 +774,50 @@ llvm::GlobalVariable *ProjectIRDB::getGlobalVariable(const std::string &name) {
 std::set<std::string> ProjectIRDB::getAllSourceFiles() { return source_files; }
 
 llvm::Instruction *ProjectIRDB::getInstruction(std::size_t id) {
-  if (instructions.count(id))
-    return instructions[id];
+  if (id >= FirstInstructionID && id - FirstInstructionID < instructions.size())
+    return instructions[id - FirstInstructionID];
   return nullptr;
 }
 
 std::size_t ProjectIRDB::getInstructionID(const llvm::Instruction *I) {
-  std::size_t id = 0;
-  if (auto MD = llvm::cast<llvm::MDString>(
-          I->getMetadata(MetaDataKind)->getOperand(0))) {
-    id = stol(MD->getString().str());
+  auto Search = instruction_ids.find(I);
+  if (Search != instruction_ids.end())
+    return Search->second;
+  // the instruction has been annotated, but its module has not been indexed
+  if (auto MD = I->getMetadata(MetaDataKind)) {
+    return stoul(
+        llvm::cast<llvm::MDString>(MD->getOperand(0))->getString().str());
   }
-  return id;
+  return 0;
 }
 
 PointsToGraph *ProjectIRDB::getPointsToGraph(const std::string &name) {
-  if (ptgs.count(name))
-    return ptgs[name].get();
-  return nullptr;
+  {
+    std::lock_guard<std::mutex> Lock(*ptgs_mtx);
+    auto Search = ptgs.find(name);
+    if (Search != ptgs.end())
+      return Search->second.get();
+  }
+  if (!(Options & IRDBOptions::LAZY_PTG))
+    return nullptr;
+  llvm::Function *F = getFunction(name);
+  if (!F || F->isDeclaration())
+    return nullptr;
+  // Construct the graph without holding the lock, such that graphs of
+  // different functions can be constructed concurrently. If another thread
+  // has been faster, its graph is kept and ours is discarded. The graph is
+  // built from the same alias analyses as an eagerly constructed one.
+  llvm::TargetLibraryInfoImpl TLII(
+      llvm::Triple(F->getParent()->getTargetTriple()));
+  llvm::TargetLibraryInfo TLI(TLII);
+  std::unique_ptr<PointsToGraph> PTG(constructPointsToGraph(F, TLI));
+  std::lock_guard<std::mutex> Lock(*ptgs_mtx);
+  return ptgs.insert(std::make_pair(name, std::move(PTG))).first->second.get();
+}
+
+bool ProjectIRDB::isPointsToGraphRestored(const std::string &name) {
+  std::lock_guard<std::mutex> Lock(*ptgs_mtx);
+  return restored_ptgs.count(name);
 }
 
 void ProjectIRDB::print() {
@@ -577,7 +842,8 @@ std::string ProjectIRDB::valueToPersistedString(const llvm::Value *V) {
     return LLVMZeroValueInternalName;
   } else if (const llvm::Instruction *I =
                  llvm::dyn_cast<llvm::Instruction>(V)) {
-    return I->getFunction()->getName().str() + "." + getMetaDataID(I);
+    return I->getFunction()->getName().str() + "." +
+           to_string(getInstructionID(I));
   } else if (const llvm::Argument *A = llvm::dyn_cast<llvm::Argument>(V)) {
     return A->getParent()->getName().str() + ".f" + to_string(A->getArgNo());
   } else if (const llvm::GlobalValue *G =
@@ -601,8 +867,8 @@ std::string ProjectIRDB::valueToPersistedString(const llvm::Value *V) {
               llvm::dyn_cast<llvm::Instruction>(User)) {
         for (unsigned idx = 0; idx < I->getNumOperands(); ++idx) {
           if (I->getOperand(idx) == V) {
-            return I->getFunction()->getName().str() + "." + getMetaDataID(I) +
-                   ".o." + to_string(idx);
+            return I->getFunction()->getName().str() + "." +
+                   to_string(getInstructionID(I)) + ".o." + to_string(idx);
           }
         }
       }
@@ -632,23 +898,14 @@ const llvm::Value *ProjectIRDB::persistedStringToValue(const std::string &S) {
     // std::cout << "FOUND instID: " << instID << "\n";
     unsigned opIdx = stoi(S.substr(j + 3, S.size()));
     // std::cout << "FOUND opIdx: " << to_string(opIdx) << "\n";
-    llvm::Function *F = getFunction(S.substr(0, S.find(".")));
-    for (auto &BB : *F) {
-      for (auto &I : BB) {
-        if (getMetaDataID(&I) == to_string(instID)) {
-          return I.getOperand(opIdx);
-        }
-      }
+    if (llvm::Instruction *I = getInstruction(instID)) {
+      return I->getOperand(opIdx);
     }
     UNRECOVERABLE_CXX_ERROR_UNCOND("Operand not found.");
   } else if (S.find(".") != std::string::npos) {
-    llvm::Function *F = getFunction(S.substr(0, S.find(".")));
-    for (auto &BB : *F) {
-      for (auto &I : BB) {
-        if (getMetaDataID(&I) == S.substr(S.find(".") + 1, S.size())) {
-          return &I;
-        }
-      }
+    if (llvm::Instruction *I =
+            getInstruction(stoul(S.substr(S.find(".") + 1, S.size())))) {
+      return I;
     }
     UNRECOVERABLE_CXX_ERROR_UNCOND("llvm::Instruction not found.");
   } else {
@@ -660,6 +917,7 @@ const llvm::Value *ProjectIRDB::persistedStringToValue(const std::string &S) {
 
 void ProjectIRDB::insertPointsToGraph(const std::string &FunctionName,
                                       PointsToGraph *ptg) {
+  std::lock_guard<std::mutex> Lock(*ptgs_mtx);
   ptgs.insert(
       std::make_pair(FunctionName, std::unique_ptr<PointsToGraph>(ptg)));
 }
@@ -0,0 +1,402 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <boost/log/sources/record_ostream.hpp>
+
+#include <phasar/DB/SQLiteBackend.h>
+#include <phasar/Utils/Logger.h>
+
+using namespace psr;
+using namespace std;
+
+namespace psr {
+
+// SQLite does not know SQL states, hence all errors share the generic one
+static const string SQLiteSQLState = "HY000";
+
+static DBException makeException(sqlite3 *db) {
+  return DBException(sqlite3_errmsg(db), sqlite3_extended_errcode(db),
+                     SQLiteSQLState);
+}
+
+static const string SQLiteScheme = R"(
+create table if not exists function (
+    function_id integer not null primary key,
+    identifier varchar(512) default null,
+    declaration tinyint(1) default null,
+    hash varchar(512) default null
+);
+create index if not exists function_identifier_idx on function (identifier);
+
+create table if not exists ifds_ide_summary (
+    ifds_ide_summary_id integer not null primary key,
+    analysis varchar(512) default null,
+    representation blob default null
+);
+
+create table if not exists module (
+    module_id integer not null primary key,
+    identifier varchar(512) default null,
+    hash varchar(512) default null,
+    code blob default null
+);
+create index if not exists module_identifier_idx on module (identifier);
+
+create table if not exists type (
+    type_id integer not null primary key,
+    identifier varchar(512) default null
+);
+create index if not exists type_identifier_idx on type (identifier);
+
+create table if not exists type_hierarchy (
+    type_hierarchy_id integer not null primary key,
+    representation blob default null,
+    representation_ref varchar(512) default null
+);
+
+create table if not exists global_variable (
+    global_variable_id integer not null primary key,
+    identifier varchar(512) default null,
+    declaration tinyint(1) default null
+);
+create index if not exists global_variable_identifier_idx
+    on global_variable (identifier);
+
+create table if not exists callgraph (
+    callgraph_id integer not null primary key,
+    representation blob default null,
+    representation_ref varchar(512) default null
+);
+
+create table if not exists `points-to_graph` (
+    `points-to_graph_id` integer not null primary key,
+    representation blob default null,
+    representation_ref varchar(512) default null
+);
+
+create table if not exists project (
+    project_id integer not null primary key,
+    identifier varchar(512) default null
+);
+create index if not exists project_identifier_idx on project (identifier);
+
+create table if not exists project_has_module (
+    project_id integer not null references project (project_id),
+    module_id integer not null references module (module_id),
+    primary key (project_id, module_id)
+);
+
+create table if not exists module_has_callgraph (
+    module_id integer not null references module (module_id),
+    callgraph_id integer not null references callgraph (callgraph_id),
+    primary key (module_id, callgraph_id)
+);
+
+create table if not exists `callgraph_has_points-to_graph` (
+    callgraph_id integer not null references callgraph (callgraph_id),
+    `points-to_graph_id` integer not null
+        references `points-to_graph` (`points-to_graph_id`),
+    primary key (callgraph_id, `points-to_graph_id`)
+);
+
+create table if not exists module_has_function (
+    module_id integer not null references module (module_id),
+    function_id integer not null references function (function_id),
+    primary key (module_id, function_id)
+);
+
+create table if not exists module_has_global_variable (
+    module_id integer not null references module (module_id),
+    global_variable_id integer not null
+        references global_variable (global_variable_id),
+    primary key (module_id, global_variable_id)
+);
+
+create table if not exists module_has_type_hierarchy (
+    module_id integer not null references module (module_id),
+    type_hierarchy_id integer not null
+        references type_hierarchy (type_hierarchy_id),
+    primary key (module_id, type_hierarchy_id)
+);
+
+create table if not exists module_has_type (
+    module_id integer not null references module (module_id),
+    type_id integer not null references type (type_id),
+    primary key (module_id, type_id)
+);
+
+create table if not exists type_hierarchy_has_type (
+    type_hierarchy_id integer not null
+        references type_hierarchy (type_hierarchy_id),
+    type_id integer not null references type (type_id),
+    primary key (type_hierarchy_id, type_id)
+);
+
+create table if not exists function_has_ifds_ide_summary (
+    function_id integer not null references function (function_id),
+    ifds_ide_summary_id integer not null
+        references ifds_ide_summary (ifds_ide_summary_id),
+    primary key (function_id, ifds_ide_summary_id)
+);
+
+create table if not exists `function_has_points-to_graph` (
+    function_id integer not null references function (function_id),
+    `points-to_graph_id` integer not null
+        references `points-to_graph` (`points-to_graph_id`),
+    primary key (function_id, `points-to_graph_id`)
+);
+
+create table if not exists type_has_virtual_function (
+    type_id integer not null references type (type_id),
+    function_id integer not null references function (function_id),
+    vtable_index integer default null,
+    primary key (type_id, function_id)
+);
+)";
+
+int enableWriteAheadLog(sqlite3 *db) {
+  // The write-ahead log only has to be synced on checkpoints, which makes
+  // commits much cheaper while keeping the database consistent.
+  for (const char *Pragma :
+       {"pragma journal_mode=WAL", "pragma synchronous=NORMAL"}) {
+    int rc = sqlite3_exec(db, Pragma, nullptr, nullptr, nullptr);
+    if (rc != SQLITE_OK) {
+      return rc;
+    }
+  }
+  return SQLITE_OK;
+}
+
+namespace {
+
+class SQLiteResultSet : public DBResultSet {
+private:
+  sqlite3 *db;
+  sqlite3_stmt *stmt;
+
+public:
+  SQLiteResultSet(sqlite3 *db, sqlite3_stmt *stmt) : db(db), stmt(stmt) {}
+
+  bool next() override {
+    int rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW) {
+      return true;
+    }
+    if (rc != SQLITE_DONE) {
+      throw makeException(db);
+    }
+    return false;
+  }
+
+  unsigned findColumn(const string &ColumnLabel) override {
+    for (int i = 0; i < sqlite3_column_count(stmt); ++i) {
+      if (ColumnLabel == sqlite3_column_name(stmt, i)) {
+        return i + 1;
+      }
+    }
+    throw DBException("no such column: " + ColumnLabel, SQLITE_RANGE,
+                      SQLiteSQLState);
+  }
+
+  int getInt(unsigned ColumnIndex) override {
+    return sqlite3_column_int(stmt, ColumnIndex - 1);
+  }
+
+  bool getBoolean(unsigned ColumnIndex) override {
+    return sqlite3_column_int(stmt, ColumnIndex - 1) != 0;
+  }
+
+  string getString(unsigned ColumnIndex) override {
+    const unsigned char *Text = sqlite3_column_text(stmt, ColumnIndex - 1);
+    if (!Text) {
+      return "";
+    }
+    return string(reinterpret_cast<const char *>(Text),
+                  sqlite3_column_bytes(stmt, ColumnIndex - 1));
+  }
+
+  string getBlob(unsigned ColumnIndex) override {
+    const void *Blob = sqlite3_column_blob(stmt, ColumnIndex - 1);
+    if (!Blob) {
+      return "";
+    }
+    return string(static_cast<const char *>(Blob),
+                  sqlite3_column_bytes(stmt, ColumnIndex - 1));
+  }
+};
+
+class SQLiteStatement : public DBStatement {
+private:
+  SQLiteBackend &backend;
+  sqlite3 *db;
+  string SQL;
+  sqlite3_stmt *stmt;
+
+  void check(int rc) {
+    if (rc != SQLITE_OK) {
+      throw makeException(db);
+    }
+  }
+
+public:
+  SQLiteStatement(SQLiteBackend &backend, sqlite3 *db, string SQL,
+                  sqlite3_stmt *stmt)
+      : backend(backend), db(db), SQL(move(SQL)), stmt(stmt) {}
+
+  ~SQLiteStatement() override { backend.releaseStatement(SQL, stmt); }
+
+  void setInt(unsigned ParameterIndex, int Value) override {
+    check(sqlite3_bind_int(stmt, ParameterIndex, Value));
+  }
+
+  void setBoolean(unsigned ParameterIndex, bool Value) override {
+    check(sqlite3_bind_int(stmt, ParameterIndex, Value));
+  }
+
+  void setString(unsigned ParameterIndex, const string &Value) override {
+    check(sqlite3_bind_text(stmt, ParameterIndex, Value.data(), Value.size(),
+                            SQLITE_TRANSIENT));
+  }
+
+  void setBlob(unsigned ParameterIndex, const string &Value) override {
+    check(sqlite3_bind_blob(stmt, ParameterIndex, Value.data(), Value.size(),
+                            SQLITE_TRANSIENT));
+  }
+
+  void setNull(unsigned ParameterIndex) override {
+    check(sqlite3_bind_null(stmt, ParameterIndex));
+  }
+
+  int executeUpdate() override {
+    sqlite3_reset(stmt);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+    }
+    if (rc != SQLITE_DONE) {
+      sqlite3_reset(stmt);
+      throw makeException(db);
+    }
+    sqlite3_reset(stmt);
+    return sqlite3_changes(db);
+  }
+
+  unique_ptr<DBResultSet> executeQuery() override {
+    sqlite3_reset(stmt);
+    return unique_ptr<DBResultSet>(new SQLiteResultSet(db, stmt));
+  }
+};
+
+} // namespace
+
+SQLiteBackend::SQLiteBackend(const string &filename) : filename(filename) {
+  if (sqlite3_open(filename.c_str(), &db) != SQLITE_OK) {
+    DBException e = makeException(db);
+    sqlite3_close(db);
+    throw e;
+  }
+  try {
+    if (enableWriteAheadLog(db) != SQLITE_OK) {
+      throw makeException(db);
+    }
+    if (!schemeExists()) {
+      buildScheme();
+    }
+  } catch (...) {
+    for (auto &Entry : statement_pool) {
+      for (auto stmt : Entry.second) {
+        sqlite3_finalize(stmt);
+      }
+    }
+    sqlite3_close(db);
+    throw;
+  }
+}
+
+SQLiteBackend::~SQLiteBackend() {
+  for (auto &Entry : statement_pool) {
+    for (auto stmt : Entry.second) {
+      sqlite3_finalize(stmt);
+    }
+  }
+  sqlite3_close(db);
+}
+
+void SQLiteBackend::exec(const string &SQL) {
+  char *err = nullptr;
+  if (sqlite3_exec(db, SQL.c_str(), nullptr, nullptr, &err) != SQLITE_OK) {
+    string what = err ? err : "unknown error";
+    sqlite3_free(err);
+    throw DBException(what, sqlite3_extended_errcode(db), SQLiteSQLState);
+  }
+}
+
+string SQLiteBackend::getName() const { return filename; }
+
+unique_ptr<DBStatement> SQLiteBackend::prepareStatement(const string &SQL) {
+  sqlite3_stmt *stmt = nullptr;
+  auto &pool = statement_pool[SQL];
+  if (!pool.empty()) {
+    stmt = pool.back();
+    pool.pop_back();
+  } else if (sqlite3_prepare_v2(db, SQL.c_str(), SQL.size(), &stmt,
+                                nullptr) != SQLITE_OK) {
+    throw makeException(db);
+  }
+  return unique_ptr<DBStatement>(new SQLiteStatement(*this, db, SQL, stmt));
+}
+
+void SQLiteBackend::releaseStatement(const string &SQL, sqlite3_stmt *stmt) {
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+  statement_pool[SQL].push_back(stmt);
+}
+
+void SQLiteBackend::beginTransaction() { exec("begin transaction"); }
+
+void SQLiteBackend::commit() { exec("commit transaction"); }
+
+void SQLiteBackend::rollback() { exec("rollback transaction"); }
+
+bool SQLiteBackend::schemeExists() {
+  auto pstmt = prepareStatement(
+      "SELECT name FROM sqlite_master WHERE type='table' AND name='module'");
+  auto res = pstmt->executeQuery();
+  return res->next();
+}
+
+void SQLiteBackend::buildScheme() {
+  auto &lg = lg::get();
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Building database schema");
+  exec(SQLiteScheme);
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Database schema done");
+}
+
+void SQLiteBackend::dropScheme() {
+  // pooled statements may refer to the tables that are dropped
+  for (auto &Entry : statement_pool) {
+    for (auto stmt : Entry.second) {
+      sqlite3_finalize(stmt);
+    }
+  }
+  statement_pool.clear();
+  vector<string> tables;
+  {
+    auto pstmt = prepareStatement("SELECT name FROM sqlite_master WHERE "
+                                  "type='table' AND name NOT LIKE 'sqlite_%'");
+    auto res = pstmt->executeQuery();
+    while (res->next()) {
+      tables.push_back(res->getString(1));
+    }
+  }
+  for (auto &table : tables) {
+    exec("DROP TABLE IF EXISTS `" + table + "`");
+  }
+}
+
+} // namespace psr
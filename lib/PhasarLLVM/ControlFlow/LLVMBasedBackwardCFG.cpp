@@ -14,6 +14,8 @@
  *      Author: philipp
  */
 
+#include <algorithm>
+
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Instruction.h>
 #include <llvm/IR/Instructions.h>
@@ -35,65 +37,31 @@ LLVMBasedBackwardCFG::getMethodOf(const llvm::Instruction *stmt) {
 
 std::vector<const llvm::Instruction *>
 LLVMBasedBackwardCFG::getPredsOf(const llvm::Instruction *stmt) {
-  vector<const llvm::Instruction *> preds;
-  if (stmt->getNextNode())
-    preds.push_back(stmt->getNextNode());
-  if (const llvm::TerminatorInst *T =
-          llvm::dyn_cast<llvm::TerminatorInst>(stmt)) {
-    for (auto successor : T->successors()) {
-      preds.push_back(&*successor->begin());
-    }
-  }
-  return preds;
+  return ForwardCFG.getSuccsOf(stmt);
 }
 
 std::vector<const llvm::Instruction *>
 LLVMBasedBackwardCFG::getSuccsOf(const llvm::Instruction *stmt) {
-  vector<const llvm::Instruction *> Preds;
-  if (stmt->getPrevNode()) {
-    Preds.push_back(stmt->getPrevNode());
-  }
-  /*
-   * If we do not have a successor yet, look for basic blocks which
-   * lead to our instruction in question!
-   */
-  if (Preds.empty()) {
-    for (auto &BB : *stmt->getFunction()) {
-      if (const llvm::TerminatorInst *T =
-              llvm::dyn_cast<llvm::TerminatorInst>(BB.getTerminator())) {
-        for (auto successor : T->successors()) {
-          if (&*successor->begin() == stmt) {
-            Preds.push_back(T);
-          }
-        }
-      }
-    }
-  }
-  return Preds;
+  return ForwardCFG.getPredsOf(stmt);
 }
 
 std::vector<std::pair<const llvm::Instruction *, const llvm::Instruction *>>
 LLVMBasedBackwardCFG::getAllControlFlowEdges(const llvm::Function *fun) {
   vector<pair<const llvm::Instruction *, const llvm::Instruction *>> Edges;
-  for (auto &BB : *fun) {
-    for (auto &I : BB) {
-      auto Successors = getSuccsOf(&I);
-      for (auto Successor : Successors) {
-        Edges.insert(Edges.begin(), make_pair(Successor, &I));
-      }
+  for (auto I : ForwardCFG.getAllInstructionsOf(fun)) {
+    for (auto Successor : getSuccsOf(I)) {
+      Edges.push_back(make_pair(Successor, I));
     }
   }
+  reverse(Edges.begin(), Edges.end());
   return Edges;
 }
 
 std::vector<const llvm::Instruction *>
 LLVMBasedBackwardCFG::getAllInstructionsOf(const llvm::Function *fun) {
-  vector<const llvm::Instruction *> Instructions;
-  for (auto &BB : *fun) {
-    for (auto &I : BB) {
-      Instructions.insert(Instructions.begin(), &I);
-    }
-  }
+  vector<const llvm::Instruction *> Instructions =
+      ForwardCFG.getAllInstructionsOf(fun);
+  reverse(Instructions.begin(), Instructions.end());
   return Instructions;
 }
 
@@ -82,6 +82,12 @@ LLVMBasedBackwardsICFG::getCalleesOfCallAt(const llvm::Instruction *n) {
   return ForwardICFG.getCalleesOfCallAt(n);
 }
 
+const std::set<const llvm::Function *> &
+LLVMBasedBackwardsICFG::getCalleesOfCallAtRef(
+    const llvm::Instruction *n) const {
+  return ForwardICFG.getCalleesOfCallAtRef(n);
+}
+
 std::set<const llvm::Instruction *>
 LLVMBasedBackwardsICFG::getCallersOf(const llvm::Function *m) {
   return ForwardICFG.getCallersOf(m);
@@ -32,52 +32,23 @@ const llvm::Function *LLVMBasedCFG::getMethodOf(const llvm::Instruction *stmt) {
 
 vector<const llvm::Instruction *>
 LLVMBasedCFG::getPredsOf(const llvm::Instruction *I) {
-  vector<const llvm::Instruction *> Preds;
-  if (I->getPrevNode()) {
-    Preds.push_back(I->getPrevNode());
-  }
-  /*
-   * If we do not have a predecessor yet, look for basic blocks which
-   * lead to our instruction in question!
-   */
-  if (Preds.empty()) {
-    for (auto &BB : *I->getFunction()) {
-      if (const llvm::TerminatorInst *T =
-              llvm::dyn_cast<llvm::TerminatorInst>(BB.getTerminator())) {
-        for (auto successor : T->successors()) {
-          if (&*successor->begin() == I) {
-            Preds.push_back(T);
-          }
-        }
-      }
-    }
-  }
-  return Preds;
+  auto Preds = CFGIndex->predecessorsOf(I);
+  return vector<const llvm::Instruction *>(Preds.begin(), Preds.end());
 }
 
 vector<const llvm::Instruction *>
 LLVMBasedCFG::getSuccsOf(const llvm::Instruction *I) {
-  vector<const llvm::Instruction *> Successors;
-  if (I->getNextNode()) {
-    Successors.push_back(I->getNextNode());
-  }
-  if (const llvm::TerminatorInst *T = llvm::dyn_cast<llvm::TerminatorInst>(I)) {
-    for (auto successor : T->successors()) {
-      Successors.push_back(&*successor->begin());
-    }
-  }
-  return Successors;
+  auto Successors = CFGIndex->successorsOf(I);
+  return vector<const llvm::Instruction *>(Successors.begin(),
+                                           Successors.end());
 }
 
 vector<pair<const llvm::Instruction *, const llvm::Instruction *>>
 LLVMBasedCFG::getAllControlFlowEdges(const llvm::Function *fun) {
   vector<pair<const llvm::Instruction *, const llvm::Instruction *>> Edges;
-  for (auto &BB : *fun) {
-    for (auto &I : BB) {
-      auto Successors = getSuccsOf(&I);
-      for (auto Successor : Successors) {
-        Edges.push_back(make_pair(&I, Successor));
-      }
+  for (const llvm::Instruction *I : CFGIndex->instructionsOf(fun)) {
+    for (const llvm::Instruction *Successor : CFGIndex->successorsOf(I)) {
+      Edges.push_back(make_pair(I, Successor));
     }
   }
   return Edges;
@@ -85,13 +56,9 @@ LLVMBasedCFG::getAllControlFlowEdges(const llvm::Function *fun) {
 
 vector<const llvm::Instruction *>
 LLVMBasedCFG::getAllInstructionsOf(const llvm::Function *fun) {
-  vector<const llvm::Instruction *> Instructions;
-  for (auto &BB : *fun) {
-    for (auto &I : BB) {
-      Instructions.push_back(&I);
-    }
-  }
-  return Instructions;
+  auto Instructions = CFGIndex->instructionsOf(fun);
+  return vector<const llvm::Instruction *>(Instructions.begin(),
+                                           Instructions.end());
 }
 
 bool LLVMBasedCFG::isExitStmt(const llvm::Instruction *stmt) {
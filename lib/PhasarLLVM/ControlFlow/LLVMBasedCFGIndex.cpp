@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <cassert>
+#include <mutex>
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instruction.h>
+#include <llvm/IR/Instructions.h>
+
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedCFGIndex.h>
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+unique_ptr<LLVMBasedCFGIndex::FunctionIndex>
+LLVMBasedCFGIndex::build(const llvm::Function *F) {
+  auto Index = make_unique<FunctionIndex>();
+  llvm::DenseMap<const llvm::Instruction *, uint32_t> Ids;
+  for (auto &BB : *F) {
+    for (auto &I : BB) {
+      Ids[&I] = Index->Instructions.size();
+      Index->Instructions.push_back(&I);
+    }
+  }
+  size_t NumInsts = Index->Instructions.size();
+  // successors in instruction order; an instruction either falls through to
+  // its next instruction or is a terminator that branches to the first
+  // instructions of its successor blocks
+  vector<uint32_t> NumPreds(NumInsts, 0);
+  Index->SuccOffsets.reserve(NumInsts + 1);
+  Index->SuccOffsets.push_back(0);
+  for (const llvm::Instruction *I : Index->Instructions) {
+    if (I->getNextNode()) {
+      Index->Succs.push_back(I->getNextNode());
+    }
+    if (const llvm::TerminatorInst *T =
+            llvm::dyn_cast<llvm::TerminatorInst>(I)) {
+      for (auto successor : T->successors()) {
+        Index->Succs.push_back(&*successor->begin());
+      }
+    }
+    Index->SuccOffsets.push_back(Index->Succs.size());
+  }
+  for (const llvm::Instruction *Succ : Index->Succs) {
+    ++NumPreds[Ids[Succ]];
+  }
+  // predecessors by a stable counting sort of the edges by their targets,
+  // such that the terminators reaching a block appear in block order
+  Index->PredOffsets.resize(NumInsts + 1, 0);
+  for (size_t i = 0; i < NumInsts; ++i) {
+    Index->PredOffsets[i + 1] = Index->PredOffsets[i] + NumPreds[i];
+  }
+  Index->Preds.resize(Index->Succs.size());
+  vector<uint32_t> Next(Index->PredOffsets.begin(),
+                        Index->PredOffsets.end() - 1);
+  for (size_t i = 0; i < NumInsts; ++i) {
+    for (uint32_t j = Index->SuccOffsets[i]; j < Index->SuccOffsets[i + 1];
+         ++j) {
+      Index->Preds[Next[Ids[Index->Succs[j]]]++] = Index->Instructions[i];
+    }
+  }
+  return Index;
+}
+
+const LLVMBasedCFGIndex::FunctionIndex *
+LLVMBasedCFGIndex::indexOf(const llvm::Function *F) {
+  {
+    shared_lock<shared_mutex> Lock(Mtx);
+    auto Search = Functions.find(F);
+    if (Search != Functions.end()) {
+      return Search->second.get();
+    }
+  }
+  unique_lock<shared_mutex> Lock(Mtx);
+  auto Inserted = Functions.try_emplace(F, nullptr);
+  if (Inserted.second) {
+    Inserted.first->second = build(F);
+    const FunctionIndex *Index = Inserted.first->second.get();
+    for (uint32_t i = 0; i < Index->Instructions.size(); ++i) {
+      Positions[Index->Instructions[i]] = make_pair(Index, i);
+    }
+  }
+  return Inserted.first->second.get();
+}
+
+pair<const LLVMBasedCFGIndex::FunctionIndex *, uint32_t>
+LLVMBasedCFGIndex::positionOf(const llvm::Instruction *I) {
+  {
+    shared_lock<shared_mutex> Lock(Mtx);
+    auto Search = Positions.find(I);
+    if (Search != Positions.end()) {
+      return Search->second;
+    }
+  }
+  indexOf(I->getFunction());
+  shared_lock<shared_mutex> Lock(Mtx);
+  auto Search = Positions.find(I);
+  assert(Search != Positions.end() &&
+         "function has been changed without invalidating its index");
+  return Search->second;
+}
+
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedCFGIndex::successorsOf(const llvm::Instruction *I) {
+  auto Pos = positionOf(I);
+  uint32_t Begin = Pos.first->SuccOffsets[Pos.second];
+  uint32_t End = Pos.first->SuccOffsets[Pos.second + 1];
+  return llvm::makeArrayRef(Pos.first->Succs).slice(Begin, End - Begin);
+}
+
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedCFGIndex::predecessorsOf(const llvm::Instruction *I) {
+  auto Pos = positionOf(I);
+  uint32_t Begin = Pos.first->PredOffsets[Pos.second];
+  uint32_t End = Pos.first->PredOffsets[Pos.second + 1];
+  return llvm::makeArrayRef(Pos.first->Preds).slice(Begin, End - Begin);
+}
+
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedCFGIndex::instructionsOf(const llvm::Function *F) {
+  return indexOf(F)->Instructions;
+}
+
+void LLVMBasedCFGIndex::invalidate(const llvm::Function *F) {
+  unique_lock<shared_mutex> Lock(Mtx);
+  auto Search = Functions.find(F);
+  if (Search == Functions.end()) {
+    return;
+  }
+  for (const llvm::Instruction *I : Search->second->Instructions) {
+    Positions.erase(I);
+  }
+  Functions.erase(Search);
+}
+
+void LLVMBasedCFGIndex::clear() {
+  unique_lock<shared_mutex> Lock(Mtx);
+  Positions.clear();
+  Functions.clear();
+}
+
+} // namespace psr
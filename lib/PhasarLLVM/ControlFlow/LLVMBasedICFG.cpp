@@ -14,6 +14,8 @@
  *      Author: pdschbrt
  */
 
+#include <algorithm>
+#include <map>
 #include <memory>
 
 #include <llvm/IR/CallSite.h>
@@ -22,6 +24,7 @@
 #include <llvm/IR/InstIterator.h>
 #include <llvm/IR/Instruction.h>
 #include <llvm/IR/Module.h>
+#include <llvm/Support/raw_ostream.h>
 
 #include <boost/graph/copy.hpp>
 #include <boost/graph/depth_first_search.hpp>
@@ -30,16 +33,19 @@
 #include <boost/log/sources/record_ostream.hpp>
 
 #include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
+#include <phasar/PhasarLLVM/ControlFlow/MappedICFG.h>
 #include <phasar/PhasarLLVM/ControlFlow/Resolver/CHAResolver.h>
 #include <phasar/PhasarLLVM/ControlFlow/Resolver/DTAResolver.h>
 #include <phasar/PhasarLLVM/ControlFlow/Resolver/OTFResolver.h>
 #include <phasar/PhasarLLVM/ControlFlow/Resolver/RTAResolver.h>
 #include <phasar/PhasarLLVM/ControlFlow/Resolver/Resolver.h>
 
+#include <phasar/Utils/IO.h>
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/Macros.h>
 #include <phasar/Utils/PAMMMacros.h>
+#include <phasar/Utils/WorkStealingScheduler.h>
 
 #include <phasar/DB/ProjectIRDB.h>
 #include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
@@ -63,44 +69,28 @@ LLVMBasedICFG::VertexProperties::VertexProperties(const llvm::Function *f,
                                                   bool isDecl)
     : function(f), functionName(f->getName().str()), isDeclaration(isDecl) {}
 
-LLVMBasedICFG::EdgeProperties::EdgeProperties(const llvm::Instruction *i)
+LLVMBasedICFG::EdgeProperties::EdgeProperties(const llvm::Instruction *i,
+                                              size_t id)
     : callsite(i),
       // WARNING: Huge cost
       //, ir_code(llvmIRToString(i)),
-      ir_code(""), id(stoull(getMetaDataID(i))) {}
+      ir_code(""), id(id) {}
 
 LLVMBasedICFG::LLVMBasedICFG(LLVMTypeHierarchy &STH, ProjectIRDB &IRDB)
     : CH(STH), IRDB(IRDB) {}
 
 LLVMBasedICFG::LLVMBasedICFG(LLVMTypeHierarchy &STH, ProjectIRDB &IRDB,
                              CallGraphAnalysisType CGType,
-                             const vector<string> &EntryPoints)
+                             const vector<string> &EntryPoints,
+                             unsigned NumThreads)
     : CGType(CGType), CH(STH), IRDB(IRDB) {
   PAMM_GET_INSTANCE;
   auto &lg = lg::get();
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
                 << "Starting CallGraphAnalysisType: " << CGType);
   VisitedFunctions.reserve(IRDB.getAllFunctions().size());
-  unique_ptr<Resolver> resolver(
-      [CGType, &IRDB, &STH, this]() -> unique_ptr<Resolver> {
-        switch (CGType) {
-        case (CallGraphAnalysisType::CHA):
-          return make_unique<CHAResolver>(IRDB, STH);
-          break;
-        case (CallGraphAnalysisType::RTA):
-          return make_unique<RTAResolver>(IRDB, STH);
-          break;
-        case (CallGraphAnalysisType::DTA):
-          return make_unique<DTAResolver>(IRDB, STH);
-          break;
-        case (CallGraphAnalysisType::OTF):
-          return make_unique<OTFResolver>(IRDB, STH, WholeModulePTG);
-          break;
-        default:
-          throw runtime_error("Resolver strategy not properly instantiated");
-          break;
-        }
-      }());
+  unique_ptr<Resolver> resolver = makeResolver();
+  vector<const llvm::Function *> EntryFunctions;
   for (auto &EntryPoint : EntryPoints) {
     llvm::Function *F = IRDB.getFunction(EntryPoint);
     if (F == nullptr) {
@@ -109,7 +99,15 @@ LLVMBasedICFG::LLVMBasedICFG(LLVMTypeHierarchy &STH, ProjectIRDB &IRDB,
     }
     PointsToGraph &ptg = *IRDB.getPointsToGraph(EntryPoint);
     WholeModulePTG.mergeWith(ptg, F);
-    constructionWalker(F, resolver.get());
+    EntryPointNames.push_back(EntryPoint);
+    if (NumThreads > 1) {
+      EntryFunctions.push_back(F);
+    } else {
+      constructionWalker(F, resolver.get());
+    }
+  }
+  if (!EntryFunctions.empty()) {
+    parallelConstructionWalker(EntryFunctions, resolver.get(), NumThreads);
   }
   REG_COUNTER("WM-PTG Vertices", WholeModulePTG.getNumOfVertices(),
               PAMM_SEVERITY_LEVEL::Full);
@@ -117,13 +115,14 @@ LLVMBasedICFG::LLVMBasedICFG(LLVMTypeHierarchy &STH, ProjectIRDB &IRDB,
               PAMM_SEVERITY_LEVEL::Full);
   REG_COUNTER("CG Vertices", getNumOfVertices(), PAMM_SEVERITY_LEVEL::Full);
   REG_COUNTER("CG Edges", getNumOfEdges(), PAMM_SEVERITY_LEVEL::Full);
+  ResolutionStateHash = computeResolutionStateHash();
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Call graph has been constructed");
 }
 
 LLVMBasedICFG::LLVMBasedICFG(LLVMTypeHierarchy &STH, ProjectIRDB &IRDB,
                              const llvm::Module &M,
                              CallGraphAnalysisType CGType,
-                             vector<string> EntryPoints)
+                             vector<string> EntryPoints, unsigned NumThreads)
     : CGType(CGType), CH(STH), IRDB(IRDB) {
   auto &lg = lg::get();
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
@@ -134,37 +133,48 @@ LLVMBasedICFG::LLVMBasedICFG(LLVMTypeHierarchy &STH, ProjectIRDB &IRDB,
       EntryPoints.push_back(F.getName().str());
     }
   }
-  unique_ptr<Resolver> resolver(
-      [CGType, &IRDB, &STH, this]() -> unique_ptr<Resolver> {
-        switch (CGType) {
-        case (CallGraphAnalysisType::CHA):
-          return make_unique<CHAResolver>(IRDB, STH);
-          break;
-        case (CallGraphAnalysisType::RTA):
-          return make_unique<RTAResolver>(IRDB, STH);
-          break;
-        case (CallGraphAnalysisType::DTA):
-          return make_unique<DTAResolver>(IRDB, STH);
-          break;
-        case (CallGraphAnalysisType::OTF):
-          return make_unique<OTFResolver>(IRDB, STH, WholeModulePTG);
-          break;
-        default:
-          throw runtime_error("Resolver strategy not properly instantiated");
-          break;
-        }
-      }());
+  unique_ptr<Resolver> resolver = makeResolver();
+  vector<const llvm::Function *> EntryFunctions;
   for (auto &EntryPoint : EntryPoints) {
     llvm::Function *F = M.getFunction(EntryPoint);
     if (F && !F->isDeclaration()) {
       PointsToGraph &ptg = *IRDB.getPointsToGraph(EntryPoint);
       WholeModulePTG.mergeWith(ptg, F);
-      constructionWalker(F, resolver.get());
+      EntryPointNames.push_back(EntryPoint);
+      if (NumThreads > 1) {
+        EntryFunctions.push_back(F);
+      } else {
+        constructionWalker(F, resolver.get());
+      }
     }
   }
+  if (!EntryFunctions.empty()) {
+    parallelConstructionWalker(EntryFunctions, resolver.get(), NumThreads);
+  }
+  ResolutionStateHash = computeResolutionStateHash();
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Call graph has been constructed");
 }
 
+unique_ptr<Resolver> LLVMBasedICFG::makeResolver() {
+  switch (CGType) {
+  case (CallGraphAnalysisType::CHA):
+    return make_unique<CHAResolver>(IRDB, CH);
+    break;
+  case (CallGraphAnalysisType::RTA):
+    return make_unique<RTAResolver>(IRDB, CH);
+    break;
+  case (CallGraphAnalysisType::DTA):
+    return make_unique<DTAResolver>(IRDB, CH);
+    break;
+  case (CallGraphAnalysisType::OTF):
+    return make_unique<OTFResolver>(IRDB, CH, WholeModulePTG);
+    break;
+  default:
+    throw runtime_error("Resolver strategy not properly instantiated");
+    break;
+  }
+}
+
 void LLVMBasedICFG::constructionWalker(const llvm::Function *F,
                                        Resolver *resolver) {
   PAMM_GET_INSTANCE;
@@ -179,12 +189,10 @@ void LLVMBasedICFG::constructionWalker(const llvm::Function *F,
     return;
   }
   VisitedFunctions.insert(F);
+  FunctionHashes.emplace(F->getName().str(), nullopt);
 
   // add a node for function F to the call graph (if not present already)
-  if (!function_vertex_map.count(F->getName().str())) {
-    function_vertex_map[F->getName().str()] = boost::add_vertex(cg);
-    cg[function_vertex_map[F->getName().str()]] = VertexProperties(F);
-  }
+  addFunctionVertex(F);
 
   if (first_function) {
     first_function = false;
@@ -198,51 +206,13 @@ void LLVMBasedICFG::constructionWalker(const llvm::Function *F,
       resolver->preCall(&Inst);
 
       llvm::ImmutableCallSite cs(&Inst);
-      set<const llvm::Function *> possible_targets;
-      // check if function call can be resolved statically
-      if (cs.getCalledFunction() != nullptr) {
-        possible_targets.insert(cs.getCalledFunction());
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "Found static call-site: "
-                      << llvmIRToString(cs.getInstruction()));
-      } else { // the function call must be resolved dynamically
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "Found dynamic call-site: "
-                      << llvmIRToString(cs.getInstruction()));
-        // call the resolve routine
-        set<string> possible_target_names;
-        if (isVirtualFunctionCall(cs)) {
-          possible_target_names = resolver->resolveVirtualCall(cs);
-        } else {
-          possible_target_names = resolver->resolveFunctionPointer(cs);
-        }
-
-        for (auto &possible_target_name : possible_target_names) {
-          if (IRDB.getFunction(possible_target_name)) {
-            possible_targets.insert(IRDB.getFunction(possible_target_name));
-          }
-        }
-      }
-
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "Found " << possible_targets.size()
-                    << " possible target(s)");
+      set<const llvm::Function *> possible_targets =
+          resolveCallSite(cs, resolver);
 
       resolver->TreatPossibleTarget(cs, possible_targets);
       // Insert possible target inside the graph and add the link with
       // the current function
-      for (auto &possible_target : possible_targets) {
-        string target_name = possible_target->getName().str();
-        if (!function_vertex_map.count(target_name)) {
-          function_vertex_map[target_name] = boost::add_vertex(cg);
-          cg[function_vertex_map[target_name]] = VertexProperties(
-              possible_target, possible_target->isDeclaration());
-        }
-
-        boost::add_edge(function_vertex_map[F->getName().str()],
-                        function_vertex_map[target_name],
-                        EdgeProperties(cs.getInstruction()), cg);
-      }
+      addCallEdges(F, cs.getInstruction(), possible_targets);
 
       // continue resolving
       for (auto possible_target : possible_targets) {
@@ -256,6 +226,197 @@ void LLVMBasedICFG::constructionWalker(const llvm::Function *F,
   }
 }
 
+/**
+ * Constructs the call graph reachable from the given entry functions by
+ * resolving the call sites of independent functions concurrently.
+ *
+ * The construction proceeds in rounds. Each round handles the functions that
+ * have been discovered by the previous one and consists of three phases:
+ *
+ *  1. All non-call instructions are passed to the resolver's OtherInst() and
+ *     the call sites are collected (in parallel).
+ *  2. The possible targets of all collected call sites are resolved (in
+ *     parallel).
+ *  3. The targets are passed to the resolver's TreatPossibleTarget() and
+ *     added to the call graph; targets that have not been visited yet form
+ *     the next round (sequentially, in instruction order).
+ *
+ * Since the functions are not walked depth-first, preCall() and postCall()
+ * are not called, i.e. the OTF resolver resolves calls without a calling
+ * context and only sees the points-to information that has been merged in
+ * the rounds before.
+ */
+void LLVMBasedICFG::parallelConstructionWalker(
+    const vector<const llvm::Function *> &EntryFunctions, Resolver *resolver,
+    unsigned NumThreads) {
+  PAMM_GET_INSTANCE;
+  auto &lg = lg::get();
+  // Fill the IRDB's lazily computed function set before it is queried
+  // concurrently by the resolvers.
+  IRDB.getAllFunctions();
+  vector<const llvm::Function *> Round;
+  for (auto F : EntryFunctions) {
+    if (!F->isDeclaration() && VisitedFunctions.insert(F).second) {
+      addFunctionVertex(F);
+      Round.push_back(F);
+    }
+  }
+  if (!Round.empty()) {
+    resolver->firstFunction(Round.front());
+  }
+  size_t NumRounds = 0;
+  while (!Round.empty()) {
+    ++NumRounds;
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
+                  << "Call-graph construction round " << NumRounds << " with "
+                  << Round.size() << " function(s)");
+    vector<vector<pair<const llvm::Instruction *,
+                       set<const llvm::Function *>>>>
+        CallSites(Round.size());
+    WorkStealingScheduler<size_t> Collect(NumThreads, [&](size_t Idx) {
+      for (llvm::const_inst_iterator I = llvm::inst_begin(Round[Idx]),
+                                     E = llvm::inst_end(Round[Idx]);
+           I != E; ++I) {
+        if (llvm::isa<llvm::CallInst>(*I) || llvm::isa<llvm::InvokeInst>(*I)) {
+          CallSites[Idx].emplace_back(&*I, set<const llvm::Function *>{});
+        } else {
+          resolver->OtherInst(&*I);
+        }
+      }
+    });
+    WorkStealingScheduler<size_t> Resolve(NumThreads, [&](size_t Idx) {
+      for (auto &CallSite : CallSites[Idx]) {
+        CallSite.second =
+            resolveCallSite(llvm::ImmutableCallSite(CallSite.first), resolver);
+      }
+    });
+    for (size_t Idx = 0; Idx < Round.size(); ++Idx) {
+      Collect.push(Idx);
+      Resolve.push(Idx);
+    }
+    Collect.run();
+    Resolve.run();
+    vector<const llvm::Function *> NextRound;
+    for (size_t Idx = 0; Idx < Round.size(); ++Idx) {
+      FunctionHashes.emplace(Round[Idx]->getName().str(), nullopt);
+      for (auto &CallSite : CallSites[Idx]) {
+        resolver->TreatPossibleTarget(llvm::ImmutableCallSite(CallSite.first),
+                                      CallSite.second);
+        addCallEdges(Round[Idx], CallSite.first, CallSite.second);
+        for (auto Target : CallSite.second) {
+          if (!Target->isDeclaration() &&
+              VisitedFunctions.insert(Target).second) {
+            NextRound.push_back(Target);
+          }
+        }
+      }
+    }
+    Round.swap(NextRound);
+  }
+  REG_COUNTER("CG Construction Rounds", NumRounds, PAMM_SEVERITY_LEVEL::Full);
+}
+
+/**
+ * Returns the functions that may be called at the given call site. Only
+ * queries the resolver and the IRDB and does not modify the call graph.
+ */
+set<const llvm::Function *>
+LLVMBasedICFG::resolveCallSite(llvm::ImmutableCallSite CS, Resolver *resolver) {
+  auto &lg = lg::get();
+  set<const llvm::Function *> possible_targets;
+  // check if function call can be resolved statically
+  if (CS.getCalledFunction() != nullptr) {
+    possible_targets.insert(CS.getCalledFunction());
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
+                  << "Found static call-site: "
+                  << llvmIRToString(CS.getInstruction()));
+  } else { // the function call must be resolved dynamically
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
+                  << "Found dynamic call-site: "
+                  << llvmIRToString(CS.getInstruction()));
+    // call the resolve routine
+    set<string> possible_target_names;
+    if (isVirtualFunctionCall(CS)) {
+      possible_target_names = resolver->resolveVirtualCall(CS);
+    } else {
+      possible_target_names = resolver->resolveFunctionPointer(CS);
+    }
+
+    for (auto &possible_target_name : possible_target_names) {
+      if (IRDB.getFunction(possible_target_name)) {
+        possible_targets.insert(IRDB.getFunction(possible_target_name));
+      }
+    }
+  }
+
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Found " << possible_targets.size()
+                                         << " possible target(s)");
+  return possible_targets;
+}
+
+/**
+ * Returns the call-graph vertex of the given function and adds it if it is not
+ * present already.
+ */
+LLVMBasedICFG::vertex_t
+LLVMBasedICFG::addFunctionVertex(const llvm::Function *F) {
+  string Name = F->getName().str();
+  auto Search = function_vertex_map.find(Name);
+  if (Search != function_vertex_map.end()) {
+    return Search->second;
+  }
+  vertex_t V = boost::add_vertex(cg);
+  cg[V] = VertexProperties(F, F->isDeclaration());
+  function_vertex_map[Name] = V;
+  return V;
+}
+
+/**
+ * Adds the edges from the given call site of function F to all of its callees
+ * to the call graph and the call-site index.
+ */
+void LLVMBasedICFG::addCallEdges(const llvm::Function *F,
+                                 const llvm::Instruction *CallSite,
+                                 const set<const llvm::Function *> &Callees) {
+  vertex_t Caller = addFunctionVertex(F);
+  for (auto Callee : Callees) {
+    boost::add_edge(Caller, addFunctionVertex(Callee),
+                    EdgeProperties(CallSite, IRDB.getInstructionID(CallSite)),
+                    cg);
+    CalleesOfCallAt[CallSite].insert(resolveFunction(Callee));
+    CallersOf[Callee->getName()].insert(CallSite);
+  }
+}
+
+/**
+ * Returns the definition of the given function if any of the IRDB's modules
+ * contains one, and the function itself otherwise, e.g. for glibc- or llvm
+ * intrinsic functions or functions that are defined in a third party library
+ * which we have no access to.
+ */
+const llvm::Function *
+LLVMBasedICFG::resolveFunction(const llvm::Function *F) {
+  if (const llvm::Function *Def = IRDB.getFunction(F->getName().str())) {
+    return Def;
+  }
+  return F;
+}
+
+/**
+ * (Re-)builds the call-site index from the call graph.
+ */
+void LLVMBasedICFG::indexCallGraph() {
+  CalleesOfCallAt.clear();
+  CallersOf.clear();
+  boost::graph_traits<bidigraph_t>::edge_iterator ei, ei_end;
+  for (boost::tie(ei, ei_end) = boost::edges(cg); ei != ei_end; ++ei) {
+    const llvm::Instruction *CallSite = cg[*ei].callsite;
+    const llvm::Function *Callee = cg[boost::target(*ei, cg)].function;
+    CalleesOfCallAt[CallSite].insert(resolveFunction(Callee));
+    CallersOf[Callee->getName()].insert(CallSite);
+  }
+}
+
 bool LLVMBasedICFG::isVirtualFunctionCall(llvm::ImmutableCallSite CS) {
   if (CS.getNumArgOperands() > 0) {
     const llvm::Value *V = CS.getArgOperand(0);
@@ -303,29 +464,7 @@ set<const llvm::Function *>
 LLVMBasedICFG::getCalleesOfCallAt(const llvm::Instruction *n) {
   auto &lg = lg::get();
   if (llvm::isa<llvm::CallInst>(n) || llvm::isa<llvm::InvokeInst>(n)) {
-    llvm::ImmutableCallSite CS(n);
-    set<const llvm::Function *> Callees;
-    string CallerName = CS->getFunction()->getName().str();
-    out_edge_iterator ei, ei_end;
-    for (boost::tie(ei, ei_end) =
-             boost::out_edges(function_vertex_map[CallerName], cg);
-         ei != ei_end; ++ei) {
-      auto source = boost::source(*ei, cg);
-      auto edge = cg[*ei];
-      auto target = boost::target(*ei, cg);
-      if (CS.getInstruction() == edge.callsite) {
-        // cout << "Name: " << cg[target].functionName << endl;
-        if (IRDB.getFunction(cg[target].functionName)) {
-          Callees.insert(IRDB.getFunction(cg[target].functionName));
-        } else {
-          // Either we have a special function called like glibc- or
-          // llvm intrinsic functions or a function that is defined in
-          // a thrid party library which we have no access to.
-          Callees.insert(cg[target].function);
-        }
-      }
-    }
-    return Callees;
+    return getCalleesOfCallAtRef(n);
   } else {
     LOG_IF_ENABLE(
         BOOST_LOG_SEV(lg, ERROR)
@@ -334,22 +473,26 @@ LLVMBasedICFG::getCalleesOfCallAt(const llvm::Instruction *n) {
   }
 }
 
+const set<const llvm::Function *> &
+LLVMBasedICFG::getCalleesOfCallAtRef(const llvm::Instruction *n) const {
+  static const set<const llvm::Function *> NoCallees;
+  auto Search = CalleesOfCallAt.find(n);
+  if (Search == CalleesOfCallAt.end()) {
+    return NoCallees;
+  }
+  return Search->second;
+}
+
 /**
  * Returns all caller statements/nodes of a given method.
  */
 set<const llvm::Instruction *>
 LLVMBasedICFG::getCallersOf(const llvm::Function *m) {
-  set<const llvm::Instruction *> CallersOf;
-  in_edge_iterator ei, ei_end;
-  for (boost::tie(ei, ei_end) =
-           boost::in_edges(function_vertex_map[m->getName().str()], cg);
-       ei != ei_end; ++ei) {
-    auto source = boost::source(*ei, cg);
-    auto edge = cg[*ei];
-    auto target = boost::target(*ei, cg);
-    CallersOf.insert(edge.callsite);
+  auto Search = CallersOf.find(m->getName());
+  if (Search == CallersOf.end()) {
+    return {};
   }
-  return CallersOf;
+  return Search->second;
 }
 
 /**
@@ -493,7 +636,7 @@ void LLVMBasedICFG::mergeWith(const LLVMBasedICFG &other) {
           auto source = boost::source(*ei, cg);
           auto edge = cg[*ei];
           // This becomes the new edge for this graph to the other graph
-          boost::add_edge(source, *vi_u, edge.callsite, cg);
+          boost::add_edge(source, *vi_u, edge, cg);
           Calls.push_back(make_pair(llvm::ImmutableCallSite(edge.callsite),
                                     cg[*vi_u].function));
           // Remove the old edge flowing into the virtual node
@@ -513,10 +656,221 @@ void LLVMBasedICFG::mergeWith(const LLVMBasedICFG &other) {
   // Merge the already visited functions
   VisitedFunctions.insert(other.VisitedFunctions.begin(),
                           other.VisitedFunctions.end());
+  FunctionHashes.insert(other.FunctionHashes.begin(),
+                        other.FunctionHashes.end());
+  // Call sites may now resolve to functions of the other graph
+  indexCallGraph();
+  ResolutionStateHash = computeResolutionStateHash();
   // Merge the points-to graphs
   WholeModulePTG.mergeWith(other.WholeModulePTG, Calls);
 }
 
+/**
+ * Returns a hash of everything besides a call site itself that its resolution
+ * depends on: function pointers may point to any function of a matching
+ * signature, virtual calls to the vtable entries of the receiver's sub types.
+ */
+size_t LLVMBasedICFG::computeResolutionStateHash() {
+  set<string> Signatures;
+  for (auto F : IRDB.getAllFunctions()) {
+    string Signature;
+    llvm::raw_string_ostream RSO(Signature);
+    RSO << F->getName() << ' ' << F->isDeclaration() << ' ';
+    F->getFunctionType()->print(RSO);
+    Signatures.insert(RSO.str());
+  }
+  string State = to_string(CH.computeHash());
+  for (auto &Signature : Signatures) {
+    State += '\n' + Signature;
+  }
+  return hash<string>{}(State);
+}
+
+static bool hasIndirectCallSite(const llvm::Function *F) {
+  for (llvm::const_inst_iterator I = llvm::inst_begin(F), E = llvm::inst_end(F);
+       I != E; ++I) {
+    if ((llvm::isa<llvm::CallInst>(*I) || llvm::isa<llvm::InvokeInst>(*I)) &&
+        !llvm::ImmutableCallSite(&*I).getCalledFunction()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Updates the call graph after the IRDB's code has changed, e.g. because a
+ * module has been reloaded, without constructing it from scratch.
+ *
+ * A visited function is considered changed if it has no definition anymore,
+ * if its definition has been replaced by another llvm::Function or if its
+ * content hash differs from the one recorded by the previous call. The hashes
+ * are computed here rather than during construction, so that constructing a
+ * call graph that is never updated does not pay for them; the first call only
+ * records them and cannot detect bodies changed in place before it. Only the
+ * call sites of the changed functions are resolved again.
+ * Indirect and virtual call sites depend on the functions of the IRDB and on
+ * the type hierarchy as well. If either has changed, every function that
+ * contains such a call site is resolved again, too.
+ * Using OTF, the call sites of their transitive callees are resolved again as
+ * well, since points-to information flows from callers to callees; the
+ * whole-module points-to graph is merged again along the remaining edges.
+ *
+ * The control-flow graphs of the changed functions are indexed again on their
+ * next query.
+ *
+ * Returns the names of the functions whose call sites have been resolved
+ * again.
+ */
+set<string> LLVMBasedICFG::updateChangedFunctions() {
+  auto &lg = lg::get();
+  set<string> Invalid;
+  // The functions whose bodies have changed in place, and whether a function
+  // has vanished or has been replaced by another llvm::Function
+  vector<const llvm::Function *> Changed;
+  bool FunctionSetChanged = false;
+  for (auto &Entry : FunctionHashes) {
+    const llvm::Function *Def = IRDB.getFunction(Entry.first);
+    if (!Def || Def->isDeclaration() || !VisitedFunctions.count(Def)) {
+      FunctionSetChanged = true;
+    } else {
+      size_t Hash = computeFunctionHash(Def);
+      if (!Entry.second || *Entry.second == Hash) {
+        Entry.second = Hash;
+        continue;
+      }
+      Changed.push_back(Def);
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
+                  << "Function has changed: " << Entry.first);
+    Invalid.insert(Entry.first);
+  }
+  size_t StateHash = computeResolutionStateHash();
+  if (StateHash != ResolutionStateHash) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
+                  << "Functions or type hierarchy have changed");
+    for (auto &Entry : FunctionHashes) {
+      const llvm::Function *Def = IRDB.getFunction(Entry.first);
+      if (!Invalid.count(Entry.first) && hasIndirectCallSite(Def)) {
+        Invalid.insert(Entry.first);
+      }
+    }
+    ResolutionStateHash = StateHash;
+  }
+  if (CGType == CallGraphAnalysisType::OTF) {
+    vector<string> WorkList(Invalid.begin(), Invalid.end());
+    while (!WorkList.empty()) {
+      vertex_t Caller = function_vertex_map.at(WorkList.back());
+      WorkList.pop_back();
+      out_edge_iterator ei, ei_end;
+      for (boost::tie(ei, ei_end) = boost::out_edges(Caller, cg); ei != ei_end;
+           ++ei) {
+        const string &Callee = cg[boost::target(*ei, cg)].functionName;
+        if (FunctionHashes.count(Callee) && Invalid.insert(Callee).second) {
+          WorkList.push_back(Callee);
+        }
+      }
+    }
+  }
+  // Drop the call sites of the invalidated functions
+  for (auto &Name : Invalid) {
+    boost::clear_out_edges(function_vertex_map.at(Name), cg);
+    FunctionHashes.erase(Name);
+  }
+  // Let the vertices refer to the current llvm::Functions and remove the ones
+  // of functions that do not exist anymore
+  set<llvm::Module *> Modules = IRDB.getAllModules();
+  vector<vertex_t> Removed;
+  vertex_iterator vi_v, vi_v_end;
+  for (boost::tie(vi_v, vi_v_end) = boost::vertices(cg); vi_v != vi_v_end;
+       ++vi_v) {
+    const llvm::Function *F = IRDB.getFunction(cg[*vi_v].functionName);
+    for (auto It = Modules.begin(); !F && It != Modules.end(); ++It) {
+      F = (*It)->getFunction(cg[*vi_v].functionName);
+    }
+    if (F != cg[*vi_v].function) {
+      FunctionSetChanged = true;
+    }
+    if (F) {
+      cg[*vi_v].function = F;
+      cg[*vi_v].isDeclaration = F->isDeclaration();
+    } else {
+      Removed.push_back(*vi_v);
+    }
+  }
+  // The CFG index is keyed by the instructions of the functions. Those of a
+  // vanished or replaced function may have been freed and their addresses
+  // reused, hence its entries cannot be told apart from valid ones anymore.
+  if (FunctionSetChanged) {
+    CFGIndex->clear();
+  } else {
+    for (auto F : Changed) {
+      CFGIndex->invalidate(F);
+    }
+  }
+  // vertices are stored in a vector, remove them back to front to keep the
+  // remaining descriptors valid
+  for (auto It = Removed.rbegin(); It != Removed.rend(); ++It) {
+    boost::clear_vertex(*It, cg);
+    boost::remove_vertex(*It, cg);
+  }
+  function_vertex_map.clear();
+  for (boost::tie(vi_v, vi_v_end) = boost::vertices(cg); vi_v != vi_v_end;
+       ++vi_v) {
+    function_vertex_map.insert(make_pair(cg[*vi_v].functionName, *vi_v));
+  }
+  VisitedFunctions.clear();
+  for (auto &Entry : FunctionHashes) {
+    VisitedFunctions.insert(IRDB.getFunction(Entry.first));
+  }
+  // Bring a fresh resolver into the state it would have after walking the
+  // remaining functions
+  unique_ptr<Resolver> resolver = makeResolver();
+  WholeModulePTG = PointsToGraph();
+  bool FirstFunction = true;
+  for (auto &EntryPoint : EntryPointNames) {
+    const llvm::Function *F = IRDB.getFunction(EntryPoint);
+    if (F && !F->isDeclaration()) {
+      WholeModulePTG.mergeWith(*IRDB.getPointsToGraph(EntryPoint), F);
+      if (FirstFunction) {
+        FirstFunction = false;
+        resolver->firstFunction(F);
+      }
+    }
+  }
+  for (auto F : VisitedFunctions) {
+    for (llvm::const_inst_iterator I = llvm::inst_begin(F),
+                                   E = llvm::inst_end(F);
+         I != E; ++I) {
+      if (!llvm::isa<llvm::CallInst>(*I) && !llvm::isa<llvm::InvokeInst>(*I)) {
+        resolver->OtherInst(&*I);
+      }
+    }
+    out_edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) =
+             boost::out_edges(function_vertex_map.at(F->getName().str()), cg);
+         ei != ei_end; ++ei) {
+      set<const llvm::Function *> Target = {
+          cg[boost::target(*ei, cg)].function};
+      resolver->TreatPossibleTarget(llvm::ImmutableCallSite(cg[*ei].callsite),
+                                    Target);
+    }
+  }
+  // Resolve the call sites of the invalidated functions again
+  for (auto &Name : Invalid) {
+    if (const llvm::Function *F = IRDB.getFunction(Name)) {
+      constructionWalker(F, resolver.get());
+    }
+  }
+  // Changes to the functions resolved again must be detected by the next call
+  for (auto &Entry : FunctionHashes) {
+    if (!Entry.second) {
+      Entry.second = computeFunctionHash(IRDB.getFunction(Entry.first));
+    }
+  }
+  indexCallGraph();
+  return Invalid;
+}
+
 bool LLVMBasedICFG::isPrimitiveFunction(const string &name) {
   for (auto &BB : *IRDB.getFunction(name)) {
     for (auto &I : BB) {
@@ -572,6 +926,60 @@ json LLVMBasedICFG::getAsJson() {
   return J;
 }
 
+void LLVMBasedICFG::exportAsBinary(const string &filename) {
+  // functions are sorted by name, such that they can be found by binary search
+  vector<string> Names;
+  for (auto &Entry : function_vertex_map) {
+    Names.push_back(Entry.first);
+  }
+  sort(Names.begin(), Names.end());
+  unordered_map<string, uint32_t> FunctionIdx;
+  vector<uint64_t> NameOffsets(1, 0);
+  string StringTable;
+  for (uint32_t Idx = 0; Idx < Names.size(); ++Idx) {
+    FunctionIdx[Names[Idx]] = Idx;
+    StringTable.append(Names[Idx]);
+    NameOffsets.push_back(StringTable.size());
+  }
+  // call sites are sorted by id for the same reason
+  map<uint64_t, set<uint32_t>> CallSites;
+  boost::graph_traits<bidigraph_t>::edge_iterator ei, ei_end;
+  for (boost::tie(ei, ei_end) = boost::edges(cg); ei != ei_end; ++ei) {
+    CallSites[IRDB.getInstructionID(cg[*ei].callsite)].insert(
+        FunctionIdx[cg[boost::target(*ei, cg)].functionName]);
+  }
+  vector<uint64_t> CallSiteIDs;
+  vector<uint64_t> CalleeOffsets(1, 0);
+  vector<uint32_t> Callees;
+  vector<vector<uint32_t>> CallersOfFunction(Names.size());
+  for (auto &CallSite : CallSites) {
+    for (auto Callee : CallSite.second) {
+      Callees.push_back(Callee);
+      CallersOfFunction[Callee].push_back(CallSiteIDs.size());
+    }
+    CallSiteIDs.push_back(CallSite.first);
+    CalleeOffsets.push_back(Callees.size());
+  }
+  vector<uint64_t> CallerOffsets(1, 0);
+  vector<uint32_t> Callers;
+  for (auto &CallersOf : CallersOfFunction) {
+    Callers.insert(Callers.end(), CallersOf.begin(), CallersOf.end());
+    CallerOffsets.push_back(Callers.size());
+  }
+  uint64_t Sizes[3] = {Names.size(), CallSiteIDs.size(), StringTable.size()};
+  string Buffer;
+  appendAligned(Buffer, MappedICFG::Magic, sizeof(MappedICFG::Magic));
+  appendAligned(Buffer, Sizes, 3);
+  appendAligned(Buffer, NameOffsets.data(), NameOffsets.size());
+  appendAligned(Buffer, StringTable.data(), StringTable.size());
+  appendAligned(Buffer, CallSiteIDs.data(), CallSiteIDs.size());
+  appendAligned(Buffer, CalleeOffsets.data(), CalleeOffsets.size());
+  appendAligned(Buffer, Callees.data(), Callees.size());
+  appendAligned(Buffer, CallerOffsets.data(), CallerOffsets.size());
+  appendAligned(Buffer, Callers.data(), Callers.size());
+  writeFile(filename, Buffer);
+}
+
 PointsToGraph &LLVMBasedICFG::getWholeModulePTG() { return WholeModulePTG; }
 
 vector<string> LLVMBasedICFG::getDependencyOrderedFunctions() {
@@ -0,0 +1,247 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <ios>
+#include <stdexcept>
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <phasar/Config/Configuration.h>
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/ControlFlow/MappedICFG.h>
+#include <phasar/Utils/IO.h>
+
+using namespace psr;
+using namespace std;
+
+namespace psr {
+
+const char MappedICFG::Magic[8] = {'P', 'S', 'R', 'I', 'C', 'F', 'G', '1'};
+
+MappedICFG::MappedICFG(ProjectIRDB &IRDB, const string &filename)
+    : IRDB(IRDB) {
+  auto File = llvm::MemoryBuffer::getFile(filename, -1, false);
+  if (!File) {
+    throw ios_base::failure("could not read file: " + filename);
+  }
+  Buffer = std::move(*File);
+  const char *Data = Buffer->getBufferStart();
+  size_t Size = Buffer->getBufferSize();
+  size_t Offset = 0;
+  const char *FileMagic = getAligned<char>(Data, Size, Offset, sizeof(Magic));
+  if (!FileMagic || memcmp(FileMagic, Magic, sizeof(Magic)) != 0 ||
+      !(Sizes = getAligned<uint64_t>(Data, Size, Offset, 3))) {
+    throw runtime_error("not a call-graph file: " + filename);
+  }
+  uint64_t NumFunctions = Sizes[0];
+  uint64_t NumCallSites = Sizes[1];
+  NameOffsets = getAligned<uint64_t>(Data, Size, Offset, NumFunctions + 1);
+  StringTable = getAligned<char>(Data, Size, Offset, Sizes[2]);
+  CallSiteIDs = getAligned<uint64_t>(Data, Size, Offset, NumCallSites);
+  CalleeOffsets = getAligned<uint64_t>(Data, Size, Offset, NumCallSites + 1);
+  if (CalleeOffsets) {
+    Callees = getAligned<uint32_t>(Data, Size, Offset,
+                                   CalleeOffsets[NumCallSites]);
+  }
+  CallerOffsets = getAligned<uint64_t>(Data, Size, Offset, NumFunctions + 1);
+  if (CallerOffsets) {
+    Callers = getAligned<uint32_t>(Data, Size, Offset,
+                                   CallerOffsets[NumFunctions]);
+  }
+  bool Valid = NameOffsets && StringTable && CallSiteIDs && Callees &&
+               Callers && NameOffsets[0] == 0 &&
+               NameOffsets[NumFunctions] == Sizes[2] &&
+               isValidCSR(CalleeOffsets, NumCallSites, Callees,
+                          CalleeOffsets[NumCallSites], NumFunctions) &&
+               isValidCSR(CallerOffsets, NumFunctions, Callers,
+                          CallerOffsets[NumFunctions], NumCallSites);
+  for (uint64_t Idx = 0; Valid && Idx < NumFunctions; ++Idx) {
+    Valid = NameOffsets[Idx] <= NameOffsets[Idx + 1];
+  }
+  if (!Valid) {
+    throw runtime_error("malformed call-graph file: " + filename);
+  }
+}
+
+MappedICFG::~MappedICFG() = default;
+
+llvm::StringRef MappedICFG::getFunctionName(uint64_t Idx) const {
+  return llvm::StringRef(StringTable + NameOffsets[Idx],
+                         NameOffsets[Idx + 1] - NameOffsets[Idx]);
+}
+
+uint64_t MappedICFG::findFunction(llvm::StringRef Name) const {
+  uint64_t Lo = 0, Hi = Sizes[0];
+  while (Lo < Hi) {
+    uint64_t Mid = Lo + (Hi - Lo) / 2;
+    if (getFunctionName(Mid) < Name) {
+      Lo = Mid + 1;
+    } else {
+      Hi = Mid;
+    }
+  }
+  return (Lo < Sizes[0] && getFunctionName(Lo) == Name) ? Lo : Sizes[0];
+}
+
+uint64_t MappedICFG::findCallSite(const llvm::Instruction *I) const {
+  uint64_t ID = IRDB.getInstructionID(I);
+  const uint64_t *End = CallSiteIDs + Sizes[1];
+  const uint64_t *Search = std::lower_bound(CallSiteIDs, End, ID);
+  return (Search != End && *Search == ID) ? Search - CallSiteIDs : Sizes[1];
+}
+
+set<const llvm::Function *> MappedICFG::getAllMethods() {
+  return IRDB.getAllFunctions();
+}
+
+const llvm::Function *MappedICFG::getMethod(const string &fun) {
+  return IRDB.getFunction(fun);
+}
+
+/**
+ * Returns all callee methods for a given call that might be called.
+ */
+set<const llvm::Function *>
+MappedICFG::getCalleesOfCallAt(const llvm::Instruction *n) {
+  set<const llvm::Function *> CalleesOfCall;
+  uint64_t CallSite = findCallSite(n);
+  if (CallSite == Sizes[1]) {
+    return CalleesOfCall;
+  }
+  for (uint64_t Idx = CalleeOffsets[CallSite];
+       Idx < CalleeOffsets[CallSite + 1]; ++Idx) {
+    string Name = getFunctionName(Callees[Idx]).str();
+    // callees that are only declared are not known to the IRDB
+    const llvm::Function *Callee = IRDB.getFunction(Name);
+    if (!Callee) {
+      Callee = n->getModule()->getFunction(Name);
+    }
+    if (Callee) {
+      CalleesOfCall.insert(Callee);
+    }
+  }
+  return CalleesOfCall;
+}
+
+/**
+ * Returns all caller statements/nodes of a given method.
+ */
+set<const llvm::Instruction *>
+MappedICFG::getCallersOf(const llvm::Function *m) {
+  set<const llvm::Instruction *> CallersOfFunction;
+  uint64_t Function = findFunction(m->getName());
+  if (Function == Sizes[0]) {
+    return CallersOfFunction;
+  }
+  for (uint64_t Idx = CallerOffsets[Function];
+       Idx < CallerOffsets[Function + 1]; ++Idx) {
+    if (auto CallSite = IRDB.getInstruction(CallSiteIDs[Callers[Idx]])) {
+      CallersOfFunction.insert(CallSite);
+    }
+  }
+  return CallersOfFunction;
+}
+
+/**
+ * Returns all call sites within a given method.
+ */
+set<const llvm::Instruction *>
+MappedICFG::getCallsFromWithin(const llvm::Function *f) {
+  set<const llvm::Instruction *> CallSites;
+  for (llvm::const_inst_iterator I = llvm::inst_begin(f), E = llvm::inst_end(f);
+       I != E; ++I) {
+    if (llvm::isa<llvm::CallInst>(*I) || llvm::isa<llvm::InvokeInst>(*I)) {
+      CallSites.insert(&(*I));
+    }
+  }
+  return CallSites;
+}
+
+set<const llvm::Instruction *>
+MappedICFG::getStartPointsOf(const llvm::Function *m) {
+  if (!m || m->isDeclaration()) {
+    return {};
+  }
+  return {&m->front().front()};
+}
+
+set<const llvm::Instruction *>
+MappedICFG::getExitPointsOf(const llvm::Function *fun) {
+  if (fun->isDeclaration()) {
+    return {};
+  }
+  return {&fun->back().back()};
+}
+
+set<const llvm::Instruction *>
+MappedICFG::getReturnSitesOfCallAt(const llvm::Instruction *n) {
+  set<const llvm::Instruction *> ReturnSites;
+  if (auto Call = llvm::dyn_cast<llvm::CallInst>(n)) {
+    ReturnSites.insert(Call->getNextNode());
+  }
+  if (auto Invoke = llvm::dyn_cast<llvm::InvokeInst>(n)) {
+    ReturnSites.insert(&Invoke->getNormalDest()->front());
+    ReturnSites.insert(&Invoke->getUnwindDest()->front());
+  }
+  return ReturnSites;
+}
+
+bool MappedICFG::isCallStmt(const llvm::Instruction *stmt) {
+  return llvm::isa<llvm::CallInst>(stmt) || llvm::isa<llvm::InvokeInst>(stmt);
+}
+
+/**
+ * Returns the set of all nodes that are neither call nor start nodes.
+ */
+set<const llvm::Instruction *> MappedICFG::allNonCallStartNodes() {
+  set<const llvm::Instruction *> NonCallStartNodes;
+  for (auto M : IRDB.getAllModules()) {
+    for (auto &F : *M) {
+      for (auto &BB : F) {
+        for (auto &I : BB) {
+          if (!isCallStmt(&I) && !isStartPoint(&I)) {
+            NonCallStartNodes.insert(&I);
+          }
+        }
+      }
+    }
+  }
+  return NonCallStartNodes;
+}
+
+json MappedICFG::getAsJson() {
+  json J;
+  for (uint64_t Function = 0; Function < Sizes[0]; ++Function) {
+    J[JsonCallGraphID][getFunctionName(Function).str()];
+  }
+  for (uint64_t CallSite = 0; CallSite < Sizes[1]; ++CallSite) {
+    auto I = IRDB.getInstruction(CallSiteIDs[CallSite]);
+    if (!I) {
+      continue;
+    }
+    string Caller = I->getFunction()->getName().str();
+    for (uint64_t Idx = CalleeOffsets[CallSite];
+         Idx < CalleeOffsets[CallSite + 1]; ++Idx) {
+      J[JsonCallGraphID][Caller] += getFunctionName(Callees[Idx]).str();
+    }
+  }
+  return J;
+}
+
+unsigned MappedICFG::getNumOfVertices() { return Sizes[0]; }
+
+unsigned MappedICFG::getNumOfEdges() { return CalleeOffsets[Sizes[1]]; }
+
+} // namespace psr
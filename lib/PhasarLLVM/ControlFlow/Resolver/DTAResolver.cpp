@@ -152,9 +152,13 @@ void DTAResolver::OtherInst(const llvm::Instruction *Inst) {
     auto dest_struct_type =
         llvm::dyn_cast<llvm::StructType>(stripPointer(dest));
 
-    if (src_struct_type && dest_struct_type &&
-        heuristic_anti_contructor_vtable_pos(BitCast))
-      typegraph.addLink(dest_struct_type, src_struct_type);
+    if (src_struct_type && dest_struct_type) {
+      // The heuristic materializes constant expressions as instructions, which
+      // modifies the use lists of the constants, so it is guarded as well.
+      lock_guard<mutex> lock(typegraph_mtx);
+      if (heuristic_anti_contructor_vtable_pos(BitCast))
+        typegraph.addLink(dest_struct_type, src_struct_type);
+    }
   }
 }
 
@@ -185,7 +189,11 @@ set<string> DTAResolver::resolveVirtualCall(const llvm::ImmutableCallSite &CS) {
     return CHAResolver::resolveVirtualCall(CS);
   }
 
-  auto possible_types = typegraph.getTypes(receiver_type);
+  set<const llvm::StructType *> possible_types;
+  {
+    lock_guard<mutex> lock(typegraph_mtx);
+    possible_types = typegraph.getTypes(receiver_type);
+  }
 
   // WARNING We deactivated the check on allocated because it is
   // unabled to get the types allocated in the used libraries
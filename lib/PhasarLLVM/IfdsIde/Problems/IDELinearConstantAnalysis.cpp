@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 // #include <functional>
+#include <atomic>
 #include <limits>
 #include <utility>
 
@@ -40,9 +41,9 @@ using namespace psr;
 
 namespace psr {
 // Initialize debug counter for edge functions
-unsigned IDELinearConstantAnalysis::CurrGenConstant_Id = 0;
-unsigned IDELinearConstantAnalysis::CurrLCAID_Id = 0;
-unsigned IDELinearConstantAnalysis::CurrBinary_Id = 0;
+atomic<unsigned> IDELinearConstantAnalysis::CurrGenConstant_Id(0);
+atomic<unsigned> IDELinearConstantAnalysis::CurrLCAID_Id(0);
+atomic<unsigned> IDELinearConstantAnalysis::CurrBinary_Id(0);
 
 const IDELinearConstantAnalysis::v_t IDELinearConstantAnalysis::TOP =
     numeric_limits<IDELinearConstantAnalysis::v_t>::min();
@@ -291,6 +292,8 @@ bool IDELinearConstantAnalysis::isZeroValue(
   return isLLVMZeroValue(d);
 }
 
+bool IDELinearConstantAnalysis::isThreadSafe() const { return true; }
+
 // In addition provide specifications for the IDE parts
 
 shared_ptr<EdgeFunction<IDELinearConstantAnalysis::v_t>>
@@ -318,8 +321,8 @@ IDELinearConstantAnalysis::getNormalEdgeFunction(
   if (isZeroValue(currNode) && isZeroValue(succNode)) {
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Case: Zero value.");
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
-    return make_shared<AllBottom<IDELinearConstantAnalysis::v_t>>(
-        bottomElement());
+    return makeInternedEdgeFunction<
+        AllBottom<IDELinearConstantAnalysis::v_t>>(bottomElement());
   }
   // Check store instruction
   if (auto Store = llvm::dyn_cast<llvm::StoreInst>(curr)) {
@@ -333,14 +336,16 @@ IDELinearConstantAnalysis::getNormalEdgeFunction(
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
         auto CI = llvm::dyn_cast<llvm::ConstantInt>(valueOperand);
         auto IntConst = CI->getSExtValue();
-        return make_shared<IDELinearConstantAnalysis::GenConstant>(IntConst);
+        return makeInternedEdgeFunction<
+            IDELinearConstantAnalysis::GenConstant>(IntConst);
       }
       // Case II: Storing an integer typed value.
       if (currNode != succNode && valueOperand->getType()->isIntegerTy()) {
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
                       << "Case: Storing an integer typed value.");
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
-        return make_shared<IDELinearConstantAnalysis::LCAIdentity>();
+        return makeInternedEdgeFunction<
+            IDELinearConstantAnalysis::LCAIdentity>();
       }
     }
   }
@@ -351,7 +356,7 @@ IDELinearConstantAnalysis::getNormalEdgeFunction(
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
                     << "Case: Loading an integer typed value.");
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
-      return make_shared<IDELinearConstantAnalysis::LCAIdentity>();
+      return makeInternedEdgeFunction<IDELinearConstantAnalysis::LCAIdentity>();
     }
   }
   // Check for binary operations add, sub, mul, udiv/sdiv and urem/srem
@@ -412,7 +417,8 @@ IDELinearConstantAnalysis::getNormalEdgeFunction(
         if (auto *LSVI = dynamic_cast<LCAIdentity *>(secondFunction.get())) {
           return this->shared_from_this();
         }
-        return make_shared<IDELinearConstantAnalysis::LCAEdgeFunctionComposer>(
+        return makeInternedEdgeFunction<
+            IDELinearConstantAnalysis::LCAEdgeFunctionComposer>(
             this->shared_from_this(), secondFunction);
       }
 
@@ -427,7 +433,8 @@ IDELinearConstantAnalysis::getNormalEdgeFunction(
                 otherFunction.get())) {
           return this->shared_from_this();
         }
-        return make_shared<AllBottom<IDELinearConstantAnalysis::v_t>>(
+        return makeInternedEdgeFunction<
+            AllBottom<IDELinearConstantAnalysis::v_t>>(
             IDELinearConstantAnalysis::BOTTOM);
       }
 
@@ -441,7 +448,7 @@ IDELinearConstantAnalysis::getNormalEdgeFunction(
         OS << "Binary_" << EdgeFunctionID;
       }
     };
-    return make_shared<LCAEF>(OP, lop, rop, currNode);
+    return makeInternedEdgeFunction<LCAEF>(OP, lop, rop, currNode);
   }
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Case: Edge identity.");
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
@@ -476,7 +483,8 @@ IDELinearConstantAnalysis::getCallEdgeFunction(
       auto actual = CS.getArgOperand(getFunctionArgumentNr(A));
       if (auto CI = llvm::dyn_cast<llvm::ConstantInt>(actual)) {
         auto IntConst = CI->getSExtValue();
-        return make_shared<IDELinearConstantAnalysis::GenConstant>(IntConst);
+        return makeInternedEdgeFunction<
+            IDELinearConstantAnalysis::GenConstant>(IntConst);
       }
     }
   }
@@ -518,7 +526,8 @@ IDELinearConstantAnalysis::getReturnEdgeFunction(
     auto ReturnValue = Return->getReturnValue();
     if (auto CI = llvm::dyn_cast<llvm::ConstantInt>(ReturnValue)) {
       auto IntConst = CI->getSExtValue();
-      return make_shared<IDELinearConstantAnalysis::GenConstant>(IntConst);
+      return makeInternedEdgeFunction<
+          IDELinearConstantAnalysis::GenConstant>(IntConst);
     }
   }
   return EdgeIdentity<IDELinearConstantAnalysis::v_t>::getInstance();
@@ -573,7 +582,7 @@ IDELinearConstantAnalysis::join(IDELinearConstantAnalysis::v_t lhs,
 
 shared_ptr<EdgeFunction<IDELinearConstantAnalysis::v_t>>
 IDELinearConstantAnalysis::allTopFunction() {
-  return make_shared<AllTop<IDELinearConstantAnalysis::v_t>>(TOP);
+  return makeInternedEdgeFunction<AllTop<IDELinearConstantAnalysis::v_t>>(TOP);
 }
 
 shared_ptr<EdgeFunction<IDELinearConstantAnalysis::v_t>>
@@ -600,7 +609,8 @@ IDELinearConstantAnalysis::LCAEdgeFunctionComposer::joinWith(
           otherFunction.get())) {
     return this->shared_from_this();
   }
-  return make_shared<AllBottom<IDELinearConstantAnalysis::v_t>>(
+  return makeInternedEdgeFunction<
+      AllBottom<IDELinearConstantAnalysis::v_t>>(
       IDELinearConstantAnalysis::BOTTOM);
 }
 
@@ -625,7 +635,8 @@ IDELinearConstantAnalysis::GenConstant::composeWith(
   if (auto *LSVI = dynamic_cast<LCAIdentity *>(secondFunction.get())) {
     return this->shared_from_this();
   }
-  return make_shared<IDELinearConstantAnalysis::LCAEdgeFunctionComposer>(
+  return makeInternedEdgeFunction<
+      IDELinearConstantAnalysis::LCAEdgeFunctionComposer>(
       this->shared_from_this(), secondFunction);
 }
 
@@ -636,7 +647,8 @@ IDELinearConstantAnalysis::GenConstant::joinWith(
       otherFunction->equal_to(this->shared_from_this())) {
     return this->shared_from_this();
   }
-  return make_shared<AllBottom<IDELinearConstantAnalysis::v_t>>(
+  return makeInternedEdgeFunction<
+      AllBottom<IDELinearConstantAnalysis::v_t>>(
       IDELinearConstantAnalysis::BOTTOM);
 }
 
@@ -680,7 +692,8 @@ IDELinearConstantAnalysis::LCAIdentity::joinWith(
           otherFunction.get())) {
     return this->shared_from_this();
   }
-  return make_shared<AllBottom<IDELinearConstantAnalysis::v_t>>(
+  return makeInternedEdgeFunction<
+      AllBottom<IDELinearConstantAnalysis::v_t>>(
       IDELinearConstantAnalysis::BOTTOM);
 }
 
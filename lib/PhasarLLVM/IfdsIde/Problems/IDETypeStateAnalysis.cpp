@@ -257,7 +257,7 @@ IDETypeStateAnalysis::getNormalEdgeFunction(
                 return State::UNINIT;
               }
             };
-            return make_shared<TSEdgeFunctionImpl>();
+            return makeInternedEdgeFunction<TSEdgeFunctionImpl>();
           }
         }
       }
@@ -299,7 +299,7 @@ IDETypeStateAnalysis::getCallToRetEdgeFunction(
           return State::OPENED;
         }
       };
-      return make_shared<TSEdgeFunctionImpl>();
+      return makeInternedEdgeFunction<TSEdgeFunctionImpl>();
     }
   }
   // For all other STDIO functions, that do not generate file handles but only
@@ -326,7 +326,7 @@ IDETypeStateAnalysis::getCallToRetEdgeFunction(
           return State::CLOSED;
         }
       };
-      return make_shared<TSEdgeFunctionImpl>();
+      return makeInternedEdgeFunction<TSEdgeFunctionImpl>();
     }
   }
   // Otherwise
@@ -368,7 +368,7 @@ IDETypeStateAnalysis::join(IDETypeStateAnalysis::v_t lhs,
 
 shared_ptr<EdgeFunction<IDETypeStateAnalysis::v_t>>
 IDETypeStateAnalysis::allTopFunction() {
-  return make_shared<AllTop<IDETypeStateAnalysis::v_t>>(TOP);
+  return makeInternedEdgeFunction<AllTop<IDETypeStateAnalysis::v_t>>(TOP);
 }
 
 void IDETypeStateAnalysis::printNode(std::ostream &os, n_t n) const {
@@ -434,8 +434,8 @@ IDETypeStateAnalysis::TSEdgeFunctionComposer::joinWith(
 std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::v_t>>
 IDETypeStateAnalysis::TSEdgeFunction::composeWith(
     std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::v_t>> secondFunction) {
-  return make_shared<TSEdgeFunctionComposer>(this->shared_from_this(),
-                                             secondFunction);
+  return makeInternedEdgeFunction<TSEdgeFunctionComposer>(
+      this->shared_from_this(), secondFunction);
 }
 
 // this implementation must of course be consistent with the implementation
@@ -152,8 +152,8 @@ IFDSTaintAnalysis::getCallToRetFlowFunction(
         // Insert the value V that gets tainted
         ToGenerate.insert(V);
         // We also have to collect all aliases of V and generate them
-        auto PTS = icfg.getWholeModulePTG().getPointsToSet(V);
-        for (auto Alias : PTS) {
+        auto PTS = icfg.getWholeModulePTG().getSharedPointsToSet(V);
+        for (auto Alias : *PTS) {
           ToGenerate.insert(Alias);
         }
       }
@@ -171,13 +171,14 @@ IFDSTaintAnalysis::getCallToRetFlowFunction(
         IFDSTaintAnalysis::m_t calledMthd;
         TaintSensitiveFunctions::SinkFunction Sink;
         map<IFDSTaintAnalysis::n_t, set<IFDSTaintAnalysis::d_t>> &Leaks;
+        mutex &LeaksMtx;
         const IFDSTaintAnalysis *taintanalysis;
         TAFF(llvm::ImmutableCallSite cs, IFDSTaintAnalysis::m_t calledMthd,
              TaintSensitiveFunctions::SinkFunction s,
              map<IFDSTaintAnalysis::n_t, set<IFDSTaintAnalysis::d_t>> &leaks,
-             const IFDSTaintAnalysis *ta)
+             mutex &leaksmtx, const IFDSTaintAnalysis *ta)
             : callSite(cs), calledMthd(calledMthd), Sink(s), Leaks(leaks),
-              taintanalysis(ta) {}
+              LeaksMtx(leaksmtx), taintanalysis(ta) {}
         set<IFDSTaintAnalysis::d_t>
         computeTargets(IFDSTaintAnalysis::d_t source) override {
           // check if a tainted value flows into a sink
@@ -187,6 +188,7 @@ IFDSTaintAnalysis::getCallToRetFlowFunction(
               if (source == callSite.getArgOperand(Idx) &&
                   Sink.isLeakedArg(Idx)) {
                 cout << "FOUND LEAK" << endl;
+                lock_guard<mutex> Lock(LeaksMtx);
                 Leaks[callSite.getInstruction()].insert(source);
               }
             }
@@ -196,7 +198,7 @@ IFDSTaintAnalysis::getCallToRetFlowFunction(
       };
       return make_shared<TAFF>(llvm::ImmutableCallSite(callSite), Callee,
                                SourceSinkFunctions.getSink(FunctionName), Leaks,
-                               this);
+                               LeaksMtx, this);
     }
   }
   // Otherwise pass everything as it is
@@ -259,6 +261,8 @@ bool IFDSTaintAnalysis::isZeroValue(IFDSTaintAnalysis::d_t d) const {
   return isLLVMZeroValue(d);
 }
 
+bool IFDSTaintAnalysis::isThreadSafe() const { return true; }
+
 void IFDSTaintAnalysis::printNode(ostream &os, IFDSTaintAnalysis::n_t n) const {
   os << llvmIRToString(n);
 }
@@ -99,10 +99,12 @@ IFDSUnitializedVariables::getNormalFlowFunction(
       const llvm::StoreInst *store;
       map<IFDSUnitializedVariables::n_t, set<IFDSUnitializedVariables::d_t>>
           &UndefValueUses;
+      mutex &UndefValueUsesMtx;
       UVFF(const llvm::StoreInst *s,
            map<IFDSUnitializedVariables::n_t,
-               set<IFDSUnitializedVariables::d_t>> &UVU)
-          : store(s), UndefValueUses(UVU) {}
+               set<IFDSUnitializedVariables::d_t>> &UVU,
+           mutex &UVUMtx)
+          : store(s), UndefValueUses(UVU), UndefValueUsesMtx(UVUMtx) {}
       set<IFDSUnitializedVariables::d_t>
       computeTargets(IFDSUnitializedVariables::d_t source) override {
         // check if an uninitialized value is loaded and stored in a variable
@@ -112,6 +114,7 @@ IFDSUnitializedVariables::getNormalFlowFunction(
                   llvm::dyn_cast<llvm::LoadInst>(use)) {
             // if the following is uninit, then this store must be uninit
             if (source == load->getPointerOperand() || source == load) {
+              lock_guard<mutex> Lock(UndefValueUsesMtx);
               UndefValueUses[load].insert(load->getPointerOperand());
               return {source, load, store->getValueOperand(),
                       store->getPointerOperand()};
@@ -141,7 +144,7 @@ IFDSUnitializedVariables::getNormalFlowFunction(
         return {source};
       }
     };
-    return make_shared<UVFF>(store, UndefValueUses);
+    return make_shared<UVFF>(store, UndefValueUses, UndefValueUsesMtx);
   }
 
   // check if some instruction is using an undefined value (in)directly
@@ -149,16 +152,19 @@ IFDSUnitializedVariables::getNormalFlowFunction(
     const llvm::Instruction *inst;
     map<IFDSUnitializedVariables::n_t, set<IFDSUnitializedVariables::d_t>>
         &UndefValueUses;
+    mutex &UndefValueUsesMtx;
     UVFF(const llvm::Instruction *inst,
          map<IFDSUnitializedVariables::n_t, set<IFDSUnitializedVariables::d_t>>
-             &UVU)
-        : inst(inst), UndefValueUses(UVU) {}
+             &UVU,
+         mutex &UVUMtx)
+        : inst(inst), UndefValueUses(UVU), UndefValueUsesMtx(UVUMtx) {}
     set<IFDSUnitializedVariables::d_t>
     computeTargets(IFDSUnitializedVariables::d_t source) override {
       for (auto &operand : inst->operands()) {
         const llvm::UndefValue *undef =
             llvm::dyn_cast<llvm::UndefValue>(operand);
         if (operand == source || operand == undef) {
+          lock_guard<mutex> Lock(UndefValueUsesMtx);
           UndefValueUses[inst].insert(operand);
           return {source, inst};
         }
@@ -166,7 +172,7 @@ IFDSUnitializedVariables::getNormalFlowFunction(
       return {source};
     }
   };
-  return make_shared<UVFF>(curr, UndefValueUses);
+  return make_shared<UVFF>(curr, UndefValueUses, UndefValueUsesMtx);
 
   // otherwise we do not care and nothing changes
   return Identity<IFDSUnitializedVariables::d_t>::getInstance();
@@ -330,6 +336,8 @@ bool IFDSUnitializedVariables::isZeroValue(
   return isLLVMZeroValue(d);
 }
 
+bool IFDSUnitializedVariables::isThreadSafe() const { return true; }
+
 void IFDSUnitializedVariables::printNode(
     ostream &os, IFDSUnitializedVariables::n_t n) const {
   os << llvmIRToString(n);
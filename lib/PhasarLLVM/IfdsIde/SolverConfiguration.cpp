@@ -16,13 +16,31 @@ using namespace psr;
 
 namespace psr {
 
+const map<WorklistOrder, string> WorklistOrderToString = {
+    {WorklistOrder::fifo, "fifo"},
+    {WorklistOrder::lifo, "lifo"},
+    {WorklistOrder::priority, "priority"}};
+
+const map<string, WorklistOrder> StringToWorklistOrder = {
+    {"fifo", WorklistOrder::fifo},
+    {"lifo", WorklistOrder::lifo},
+    {"priority", WorklistOrder::priority}};
+
+ostream &operator<<(ostream &os, const WorklistOrder &w) {
+  return os << WorklistOrderToString.at(w);
+}
+
 ostream &operator<<(ostream &os, const SolverConfiguration &sc) {
   return os << "SolverConfiguration:\n"
             << "\tfollowReturnsPastSeeds: " << sc.followReturnsPastSeeds << "\n"
             << "\tautoAddZero: " << sc.autoAddZero << "\n"
             << "\tcomputeValues: " << sc.computeValues << "\n"
             << "\trecordEdges: " << sc.recordEdges << "\n"
-            << "\tcomputePersistedSummaries: " << sc.computePersistedSummaries;
+            << "\tcomputePersistedSummaries: " << sc.computePersistedSummaries
+            << "\n"
+            << "\tworklistOrder: " << sc.worklistOrder << "\n"
+            << "\tnumThreads: " << sc.numThreads << "\n"
+            << "\tcacheCapacity: " << sc.cacheCapacity;
 }
 
 } // namespace psr
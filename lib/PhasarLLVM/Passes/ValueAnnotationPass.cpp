@@ -35,31 +35,33 @@ using namespace psr;
 
 namespace psr {
 
-size_t ValueAnnotationPass::unique_value_id = 0;
+std::atomic<size_t> ValueAnnotationPass::unique_value_id(0);
 
 bool ValueAnnotationPass::runOnModule(llvm::Module &M) {
   auto &lg = lg::get();
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Running ValueAnnotationPass");
+  size_t value_id = first_value_id == ReserveOnRun
+                        ? reserveValueIDs(countAnnotatedValues(M))
+                        : first_value_id;
   for (auto &global : M.globals()) {
     llvm::MDNode *node = llvm::MDNode::get(
-        context, llvm::MDString::get(context, std::to_string(unique_value_id)));
+        context, llvm::MDString::get(context, std::to_string(value_id)));
     global.setMetadata(MetaDataKind, node);
     //		std::cout <<
     // llvm::cast<llvm::MDString>(global.getMetadata(MetaDataKind)->getOperand(0))->getString().str()
     //<< std::endl;
-    ++unique_value_id;
+    ++value_id;
   }
   for (auto &F : M) {
     for (auto &BB : F) {
       for (auto &I : BB) {
         llvm::MDNode *node = llvm::MDNode::get(
-            context,
-            llvm::MDString::get(context, std::to_string(unique_value_id)));
+            context, llvm::MDString::get(context, std::to_string(value_id)));
         I.setMetadata(MetaDataKind, node);
         //		    	std::cout <<
         // llvm::cast<llvm::MDString>(I.getMetadata(MetaDataKind)->getOperand(0))->getString().str()
         //<< std::endl;
-        ++unique_value_id;
+        ++value_id;
       }
     }
   }
@@ -76,6 +78,20 @@ void ValueAnnotationPass::getAnalysisUsage(llvm::AnalysisUsage &AU) const {
 
 void ValueAnnotationPass::releaseMemory() {}
 
+size_t ValueAnnotationPass::countAnnotatedValues(const llvm::Module &M) {
+  size_t Count = M.global_size();
+  for (auto &F : M) {
+    for (auto &BB : F) {
+      Count += BB.size();
+    }
+  }
+  return Count;
+}
+
+size_t ValueAnnotationPass::reserveValueIDs(size_t Count) {
+  return unique_value_id.fetch_add(Count);
+}
+
 void ValueAnnotationPass::resetValueID() {
   cout << "Reset ID" << endl;
   unique_value_id = 0;
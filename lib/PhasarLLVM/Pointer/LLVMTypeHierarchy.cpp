@@ -16,7 +16,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
 
 #include <boost/log/sources/record_ostream.hpp>
@@ -319,7 +321,11 @@ void LLVMTypeHierarchy::pruneTypeHierarchyWithVtable(
 
 set<string> LLVMTypeHierarchy::getTransitivelyReachableTypes(string TypeName) {
   TypeName = debasify(TypeName);
-  return g[type_vertex_map[TypeName]].reachableTypes;
+  auto Search = type_vertex_map.find(TypeName);
+  if (Search == type_vertex_map.end()) {
+    return {};
+  }
+  return g[Search->second].reachableTypes;
 }
 
 string LLVMTypeHierarchy::getVTableEntry(string TypeName, unsigned idx) const {
@@ -441,6 +447,38 @@ LLVMTypeHierarchy::loadGraphFormDot(istream &in) {
   return G;
 }
 
+size_t LLVMTypeHierarchy::computeHash() const {
+  // the graph's vertices and the vtables are not ordered, hence sort them by
+  // the type names
+  map<string, string> Types;
+  vertex_iterator_t vi_v, vi_v_end;
+  out_edge_iterator_t ei, ei_end;
+  for (boost::tie(vi_v, vi_v_end) = boost::vertices(g); vi_v != vi_v_end;
+       ++vi_v) {
+    set<string> SubTypes;
+    for (boost::tie(ei, ei_end) = boost::out_edges(*vi_v, g); ei != ei_end;
+         ++ei) {
+      SubTypes.insert(g[boost::target(*ei, g)].name);
+    }
+    string &Entry = Types[g[*vi_v].name];
+    for (auto &SubType : SubTypes) {
+      Entry += SubType + ' ';
+    }
+  }
+  for (auto &Entry : type_vtbl_map) {
+    string &Type = Types[Entry.first];
+    Type += '|';
+    for (auto &Function : Entry.second) {
+      Type += Function + ' ';
+    }
+  }
+  string State;
+  for (auto &Entry : Types) {
+    State += Entry.first + ": " + Entry.second + '\n';
+  }
+  return hash<string>{}(State);
+}
+
 void LLVMTypeHierarchy::printTransitiveClosure() {
   bidigraph_t tc;
   boost::transitive_closure(g, tc);
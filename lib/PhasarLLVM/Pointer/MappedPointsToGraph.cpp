@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <cstring>
+#include <ios>
+#include <stdexcept>
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/Instruction.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/Pointer/MappedPointsToGraph.h>
+#include <phasar/Utils/IO.h>
+#include <phasar/Utils/LLVMShorthands.h>
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+const char MappedPointsToGraph::Magic[8] = {'P', 'S', 'R', 'P',
+                                            'T', 'G', 'M', '1'};
+
+MappedPointsToGraph::MappedPointsToGraph(ProjectIRDB &IRDB,
+                                         const string &filename) {
+  auto File = llvm::MemoryBuffer::getFile(filename, -1, false);
+  if (!File) {
+    throw ios_base::failure("could not read file: " + filename);
+  }
+  Buffer = std::move(*File);
+  const char *Data = Buffer->getBufferStart();
+  size_t Size = Buffer->getBufferSize();
+  size_t Offset = 0;
+  const char *FileMagic = getAligned<char>(Data, Size, Offset, sizeof(Magic));
+  if (!FileMagic || memcmp(FileMagic, Magic, sizeof(Magic)) != 0 ||
+      !(Sizes = getAligned<uint64_t>(Data, Size, Offset, 5))) {
+    throw runtime_error("not a points-to graph file: " + filename);
+  }
+  uint64_t NumVertices = Sizes[0];
+  uint64_t NumComponents = Sizes[2];
+  uint64_t NumAdjacencies = Sizes[4];
+  Vertices = getAligned<MappedPTGVertex>(Data, Size, Offset, NumVertices);
+  StringTable = getAligned<char>(Data, Size, Offset, Sizes[3]);
+  AdjacencyOffsets = getAligned<uint64_t>(Data, Size, Offset, NumVertices + 1);
+  Adjacencies = getAligned<uint32_t>(Data, Size, Offset, NumAdjacencies);
+  ComponentOf = getAligned<uint32_t>(Data, Size, Offset, NumVertices);
+  ComponentOffsets =
+      getAligned<uint64_t>(Data, Size, Offset, NumComponents + 1);
+  ComponentMembers = getAligned<uint32_t>(Data, Size, Offset, NumVertices);
+  if (!Vertices || !StringTable || !AdjacencyOffsets || !Adjacencies ||
+      !ComponentOf || !ComponentOffsets || !ComponentMembers ||
+      !isValidCSR(AdjacencyOffsets, NumVertices, Adjacencies, NumAdjacencies,
+                  NumVertices) ||
+      !isValidCSR(ComponentOffsets, NumComponents, ComponentMembers,
+                  NumVertices, NumVertices)) {
+    throw runtime_error("malformed points-to graph file: " + filename);
+  }
+  // Names are null-terminated strings within the string table
+  auto getName = [&](uint64_t NameOffset) -> string {
+    if (NameOffset >= Sizes[3] ||
+        !memchr(StringTable + NameOffset, '\0', Sizes[3] - NameOffset)) {
+      return "";
+    }
+    return StringTable + NameOffset;
+  };
+  Values.reserve(NumVertices);
+  for (uint32_t V = 0; V < NumVertices; ++V) {
+    const MappedPTGVertex &Vertex = Vertices[V];
+    const llvm::Value *Value = nullptr;
+    if (ComponentOf[V] >= NumComponents) {
+      throw runtime_error("malformed points-to graph file: " + filename);
+    }
+    switch (static_cast<MappedValueKind>(Vertex.Kind)) {
+    case MappedValueKind::Instruction:
+      Value = IRDB.getInstruction(Vertex.ID);
+      break;
+    case MappedValueKind::Argument:
+      if (const llvm::Function *F = IRDB.getFunction(getName(Vertex.ID))) {
+        Value = getNthFunctionArgument(F, Vertex.Index);
+      }
+      break;
+    case MappedValueKind::Global:
+      Value = IRDB.getGlobalVariable(getName(Vertex.ID));
+      if (!Value) {
+        Value = IRDB.getFunction(getName(Vertex.ID));
+      }
+      break;
+    case MappedValueKind::Operand:
+      if (const llvm::Instruction *I = IRDB.getInstruction(Vertex.ID)) {
+        if (Vertex.Index < I->getNumOperands()) {
+          Value = I->getOperand(Vertex.Index);
+        }
+      }
+      break;
+    }
+    if (!Value) {
+      throw runtime_error("points-to graph file refers to an unknown value: " +
+                          filename);
+    }
+    Values.push_back(Value);
+    ValueVertexMap.insert(make_pair(Value, V));
+  }
+}
+
+MappedPointsToGraph::~MappedPointsToGraph() = default;
+
+bool MappedPointsToGraph::containsValue(const llvm::Value *V) const {
+  return ValueVertexMap.count(V);
+}
+
+vector<const llvm::Value *>
+MappedPointsToGraph::getAdjacentValues(const llvm::Value *V) const {
+  vector<const llvm::Value *> Adjacent;
+  auto Search = ValueVertexMap.find(V);
+  if (Search != ValueVertexMap.end()) {
+    for (uint64_t Idx = AdjacencyOffsets[Search->second];
+         Idx < AdjacencyOffsets[Search->second + 1]; ++Idx) {
+      Adjacent.push_back(Values[Adjacencies[Idx]]);
+    }
+  }
+  return Adjacent;
+}
+
+set<const llvm::Value *>
+MappedPointsToGraph::getPointsToSet(const llvm::Value *V) const {
+  set<const llvm::Value *> PointsToSet;
+  auto Search = ValueVertexMap.find(V);
+  if (Search != ValueVertexMap.end()) {
+    uint32_t Component = ComponentOf[Search->second];
+    for (uint64_t Idx = ComponentOffsets[Component];
+         Idx < ComponentOffsets[Component + 1]; ++Idx) {
+      PointsToSet.insert(Values[ComponentMembers[Idx]]);
+    }
+  }
+  return PointsToSet;
+}
+
+unsigned MappedPointsToGraph::getNumOfVertices() const { return Sizes[0]; }
+
+unsigned MappedPointsToGraph::getNumOfEdges() const { return Sizes[1]; }
+
+} // namespace psr
@@ -13,8 +13,13 @@
  *  Created on: 08.02.2017
  *      Author: pdschbrt
  */
+#include <stdexcept>
+#include <unordered_map>
+
 #include <llvm/ADT/SetVector.h>
+#include <llvm/Analysis/AliasAnalysis.h>
 #include <llvm/Analysis/CFLSteensAliasAnalysis.h>
+#include <llvm/Analysis/ValueTracking.h>
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/InstIterator.h>
 #include <llvm/IR/Instructions.h>
@@ -27,9 +32,11 @@
 #include <boost/graph/graphviz.hpp>
 #include <boost/log/sources/record_ostream.hpp>
 
+#include <phasar/PhasarLLVM/Pointer/MappedPointsToGraph.h>
 #include <phasar/PhasarLLVM/Pointer/PointsToGraph.h>
 
 #include <phasar/Utils/GraphExtensions.h>
+#include <phasar/Utils/IO.h>
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/Macros.h>
@@ -208,7 +215,8 @@ const map<PointerAnalysisType, string> PointerAnalysisTypeToString = {
     {PointerAnalysisType::CFLAnders, "CFLAnders"}};
 
 PointsToGraph::PointsToGraph(llvm::AAResults &AA, llvm::Function *F,
-                             bool onlyConsiderMustAlias) {
+                             bool onlyConsiderMustAlias,
+                             bool partitionPointers) {
   PAMM_GET_INSTANCE;
   auto &lg = lg::get();
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
@@ -266,57 +274,75 @@ PointsToGraph::PointsToGraph(llvm::AAResults &AA, llvm::Function *F,
     value_vertex_map[pointer] = boost::add_vertex(ptg);
     ptg[value_vertex_map[pointer]] = VertexProperties(pointer);
   }
-  // iterate over the worklist, and run the full (n^2)/2 disambiguations
-  for (llvm::SetVector<llvm::Value *>::iterator I1 = Pointers.begin(),
-                                                E = Pointers.end();
-       I1 != E; ++I1) {
-    uint64_t I1Size = llvm::MemoryLocation::UnknownSize;
-    llvm::Type *I1ElTy =
-        llvm::cast<llvm::PointerType>((*I1)->getType())->getElementType();
-    if (I1ElTy->isSized())
-      I1Size = DL.getTypeStoreSize(I1ElTy);
-    for (llvm::SetVector<llvm::Value *>::iterator I2 = Pointers.begin();
-         I2 != I1; ++I2) {
-      uint64_t I2Size = llvm::MemoryLocation::UnknownSize;
-      llvm::Type *I2ElTy =
-          llvm::cast<llvm::PointerType>((*I2)->getType())->getElementType();
-      if (I2ElTy->isSized())
-        I2Size = DL.getTypeStoreSize(I2ElTy);
-      if (!onlyConsiderMustAlias) {
-        switch (AA.alias(llvm::MemoryLocation(*I1, I1Size),
-                         llvm::MemoryLocation(*I2, I2Size))) {
-        case llvm::NoAlias:
-          // PrintResults("NoAlias", PrintNoAlias, *I1, *I2, F->getParent());
-          break;
-        case llvm::MayAlias:
-          // PrintResults("MayAlias", PrintMayAlias, *I1, *I2,
-          // F->getParent());
-          boost::add_edge(value_vertex_map[*I1], value_vertex_map[*I2], ptg);
-          break;
-        case llvm::PartialAlias:
-          // PrintResults("PartialAlias", PrintPartialAlias, *I1, *I2,
-          // 						 F->getParent());
-          boost::add_edge(value_vertex_map[*I1], value_vertex_map[*I2], ptg);
-          break;
-        case llvm::MustAlias:
-          // PrintResults("MustAlias", PrintMustAlias, *I1, *I2,
-          //              F->getParent());
-          boost::add_edge(value_vertex_map[*I1], value_vertex_map[*I2], ptg);
-          break;
-        default:
-          // Do nothing
-          break;
-        }
+  // compute the store sizes only once rather than once per pair
+  std::vector<uint64_t> Sizes;
+  Sizes.reserve(Pointers.size());
+  for (auto pointer : Pointers) {
+    uint64_t Size = llvm::MemoryLocation::UnknownSize;
+    llvm::Type *ElTy =
+        llvm::cast<llvm::PointerType>(pointer->getType())->getElementType();
+    if (ElTy->isSized())
+      Size = DL.getTypeStoreSize(ElTy);
+    Sizes.push_back(Size);
+  }
+  unsigned AliasQueries = 0;
+  // I2 always precedes I1 in Pointers
+  auto disambiguate = [&](size_t I1, size_t I2) {
+    ++AliasQueries;
+    llvm::AliasResult Result =
+        AA.alias(llvm::MemoryLocation(Pointers[I1], Sizes[I1]),
+                 llvm::MemoryLocation(Pointers[I2], Sizes[I2]));
+    if ((!onlyConsiderMustAlias && Result != llvm::NoAlias) ||
+        Result == llvm::MustAlias) {
+      boost::add_edge(value_vertex_map[Pointers[I1]],
+                      value_vertex_map[Pointers[I2]], ptg);
+    }
+  };
+  if (!partitionPointers) {
+    // iterate over the worklist, and run the full (n^2)/2 disambiguations
+    for (size_t I1 = 0; I1 < Pointers.size(); ++I1) {
+      for (size_t I2 = 0; I2 < I1; ++I2) {
+        disambiguate(I1, I2);
+      }
+    }
+  } else {
+    // Partition the pointers by their underlying object. Two pointers based
+    // on distinct identified objects (allocas, globals, noalias calls, ...)
+    // never alias, which is exactly what BasicAA answers for such pairs, so
+    // only pairs within a partition and pairs involving a pointer whose
+    // underlying object is unknown have to be disambiguated.
+    std::map<const llvm::Value *, std::vector<size_t>> Partitions;
+    std::vector<size_t> Unknown;
+    std::vector<bool> IsUnknown(Pointers.size(), false);
+    for (size_t I = 0; I < Pointers.size(); ++I) {
+      const llvm::Value *Object = llvm::GetUnderlyingObject(Pointers[I], DL);
+      if (llvm::isIdentifiedObject(Object)) {
+        Partitions[Object].push_back(I);
       } else {
-        if (AA.alias(llvm::MemoryLocation(*I1, I1Size),
-                     llvm::MemoryLocation(*I2, I2Size)) == llvm::MustAlias) {
-          // PrintResults("MustAlias", PrintMustAlias, *I1, *I2,
-          //              F->getParent());
-          boost::add_edge(value_vertex_map[*I1], value_vertex_map[*I2], ptg);
+        Unknown.push_back(I);
+        IsUnknown[I] = true;
+      }
+    }
+    for (auto &Partition : Partitions) {
+      for (size_t I1 = 0; I1 < Partition.second.size(); ++I1) {
+        for (size_t I2 = 0; I2 < I1; ++I2) {
+          disambiguate(Partition.second[I1], Partition.second[I2]);
+        }
+      }
+    }
+    // pairs of two unknown pointers are only visited from the later one
+    for (size_t U : Unknown) {
+      for (size_t I = 0; I < Pointers.size(); ++I) {
+        if (I < U) {
+          disambiguate(U, I);
+        } else if (I > U && !IsUnknown[I]) {
+          disambiguate(I, U);
         }
       }
     }
   }
+  INC_COUNTER("PTG Alias Queries", AliasQueries, PAMM_SEVERITY_LEVEL::Full);
+  rebuildComponents();
 }
 
 PointsToGraph::PointsToGraph(vector<string> fnames) {
@@ -374,10 +400,14 @@ PointsToGraph::getPointersEscapingThroughReturnsForFunction(
 set<const llvm::Value *> PointsToGraph::getReachableAllocationSites(
     const llvm::Value *V, vector<const llvm::Instruction *> CallStack) {
   set<const llvm::Value *> alloc_sites;
+  auto Search = value_vertex_map.find(V);
+  if (Search == value_vertex_map.end()) {
+    return alloc_sites;
+  }
   allocation_site_dfs_visitor alloc_vis(alloc_sites, CallStack);
   vector<boost::default_color_type> color_map(boost::num_vertices(ptg));
   boost::depth_first_visit(
-      ptg, value_vertex_map[V], alloc_vis,
+      ptg, Search->second, alloc_vis,
       boost::make_iterator_property_map(color_map.begin(),
                                         boost::get(boost::vertex_index, ptg),
                                         color_map[0]));
@@ -417,24 +447,135 @@ PointsToGraph::computeTypesFromAllocationSites(set<const llvm::Value *> AS) {
 }
 
 set<const llvm::Value *> PointsToGraph::getPointsToSet(const llvm::Value *V) {
+  return *getSharedPointsToSet(V);
+}
+
+shared_ptr<const set<const llvm::Value *>>
+PointsToGraph::getSharedPointsToSet(const llvm::Value *V) {
   PAMM_GET_INSTANCE;
+  // there is no timer, since a query is answered in about the time a timer
+  // takes
   INC_COUNTER("[Calls] getPointsToSet", 1, PAMM_SEVERITY_LEVEL::Full);
-  START_TIMER("PointsTo-Set Computation", PAMM_SEVERITY_LEVEL::Full);
-  set<vertex_t> reachable_vertices;
-  reachability_dfs_visitor vis(reachable_vertices);
-  vector<boost::default_color_type> color_map(boost::num_vertices(ptg));
-  boost::depth_first_visit(
-      ptg, value_vertex_map[V], vis,
-      boost::make_iterator_property_map(color_map.begin(),
-                                        boost::get(boost::vertex_index, ptg),
-                                        color_map[0]));
-  set<const llvm::Value *> result;
-  for (auto vertex : reachable_vertices) {
-    result.insert(ptg[vertex].value);
+  auto Search = value_vertex_map.find(V);
+  if (Search == value_vertex_map.end()) {
+    return make_shared<const set<const llvm::Value *>>();
+  }
+  shared_ptr<const set<const llvm::Value *>> Result;
+  {
+    // the graph is not changed while it is queried, only the cache is
+    shared_lock<shared_mutex> lock(PTSCache.mtx);
+    auto Hit = PTSCache.Sets.find(findComponent(Search->second));
+    if (Hit != PTSCache.Sets.end()) {
+      Result = Hit->second;
+    }
+  }
+  if (!Result) {
+    unique_lock<shared_mutex> lock(PTSCache.mtx);
+    // group all vertices by their components once per change of the graph
+    // and let each of them refer to its representative directly, such that
+    // the following queries find their components in a single step
+    if (PTSCache.Members.empty()) {
+      vertex_iterator_t vi, vi_end;
+      for (boost::tie(vi, vi_end) = boost::vertices(ptg); vi != vi_end; ++vi) {
+        vertex_t Component = findComponent(*vi);
+        ComponentParents[*vi] = Component;
+        PTSCache.Members[Component].push_back(*vi);
+      }
+    }
+    vertex_t Component = findComponent(Search->second);
+    auto &Cached = PTSCache.Sets[Component];
+    // another query may have computed the set in the meantime
+    if (!Cached) {
+      auto PTS = make_shared<set<const llvm::Value *>>();
+      for (auto vertex : PTSCache.Members[Component]) {
+        PTS->insert(ptg[vertex].value);
+      }
+      Cached = PTS;
+    }
+    Result = Cached;
+  }
+  ADD_TO_HISTOGRAM("Points-to", Result->size(), 1, PAMM_SEVERITY_LEVEL::Full);
+  return Result;
+}
+
+PointsToGraph::PointsToSetCache &PointsToGraph::PointsToSetCache::
+operator=(const PointsToSetCache &) {
+  clear();
+  return *this;
+}
+
+void PointsToGraph::PointsToSetCache::clear() {
+  unique_lock<shared_mutex> lock(mtx);
+  Members.clear();
+  Sets.clear();
+}
+
+/**
+ * Returns the representative of the component of vertex V. Does not compress
+ * paths, such that it may be called concurrently by queries.
+ */
+PointsToGraph::vertex_t PointsToGraph::findComponent(vertex_t V) const {
+  while (ComponentParents[V] != V) {
+    V = ComponentParents[V];
+  }
+  return V;
+}
+
+/**
+ * Returns the representative of the component of vertex V and halves the
+ * path from V to it while the graph is changed.
+ */
+PointsToGraph::vertex_t PointsToGraph::compressComponent(vertex_t V) {
+  while (ComponentParents[V] != V) {
+    ComponentParents[V] = ComponentParents[ComponentParents[V]];
+    V = ComponentParents[V];
   }
-  PAUSE_TIMER("PointsTo-Set Computation", PAMM_SEVERITY_LEVEL::Full);
-  ADD_TO_HISTOGRAM("Points-to", result.size(), 1, PAMM_SEVERITY_LEVEL::Full);
-  return result;
+  return V;
+}
+
+/**
+ * Joins the components of V and U, which have been connected by an edge.
+ */
+void PointsToGraph::uniteComponents(vertex_t V, vertex_t U) {
+  V = compressComponent(V);
+  U = compressComponent(U);
+  if (V == U) {
+    return;
+  }
+  if (ComponentSizes[V] < ComponentSizes[U]) {
+    swap(V, U);
+  }
+  ComponentParents[U] = V;
+  ComponentSizes[V] += ComponentSizes[U];
+}
+
+/**
+ * Computes the components of ptg from scratch.
+ */
+void PointsToGraph::rebuildComponents() {
+  ComponentParents.resize(boost::num_vertices(ptg));
+  for (vertex_t V = 0; V < ComponentParents.size(); ++V) {
+    ComponentParents[V] = V;
+  }
+  ComponentSizes.assign(boost::num_vertices(ptg), 1);
+  boost::graph_traits<graph_t>::edge_iterator ei, ei_end;
+  for (boost::tie(ei, ei_end) = boost::edges(ptg); ei != ei_end; ++ei) {
+    uniteComponents(boost::source(*ei, ptg), boost::target(*ei, ptg));
+  }
+  PTSCache.clear();
+}
+
+/**
+ * Adds the components of Other, whose vertices have been copied to the end of
+ * ptg starting at the given offset.
+ */
+void PointsToGraph::appendComponents(const PointsToGraph &Other,
+                                     size_t Offset) {
+  for (vertex_t V = 0; V < Other.ComponentParents.size(); ++V) {
+    ComponentParents.push_back(Other.findComponent(V) + Offset);
+    ComponentSizes.push_back(Other.ComponentSizes[V]);
+  }
+  PTSCache.clear();
 }
 
 bool PointsToGraph::representsSingleFunction() {
@@ -498,12 +639,10 @@ void PointsToGraph::mergeWith(const PointsToGraph &Other,
                               const llvm::Function *F) {
   if (!ContainedFunctions.count(F->getName().str())) {
     ContainedFunctions.insert(F->getName().str());
+    size_t Offset = boost::num_vertices(ptg);
     copy_graph<PointsToGraph::graph_t, PointsToGraph::vertex_t>(ptg, Other.ptg);
-    value_vertex_map.clear();
-    vertex_iterator_t vi, vi_end;
-    for (boost::tie(vi, vi_end) = boost::vertices(ptg); vi != vi_end; ++vi) {
-      value_vertex_map.insert(make_pair(ptg[*vi].value, *vi));
-    }
+    appendComponents(Other, Offset);
+    indexVertices(Offset);
   }
 }
 
@@ -533,8 +672,7 @@ void PointsToGraph::mergeWith(
       }
     }
 
-    for (auto Formal :
-         Other.getPointersEscapingThroughReturnsForFunction(Call.second)) {
+    for (auto Formal : getReturnedValues(Call.second)) {
       if (value_vertex_map.count(Call.first.getInstruction()) &&
           Other.value_vertex_map.count(Formal)) {
         v_in_g1_u_in_g2.push_back(
@@ -547,14 +685,16 @@ void PointsToGraph::mergeWith(
     }
     ContainedFunctions.insert(Call.second->getName().str());
   }
+  size_t Offset = boost::num_vertices(ptg);
   merge_graphs<PointsToGraph::graph_t, PointsToGraph::vertex_t,
                PointsToGraph::EdgeProperties, const llvm::Instruction *>(
       ptg, Other.ptg, v_in_g1_u_in_g2);
-  value_vertex_map.clear();
-  vertex_iterator_t vi, vi_end;
-  for (boost::tie(vi, vi_end) = boost::vertices(ptg); vi != vi_end; ++vi) {
-    value_vertex_map.insert(make_pair(ptg[*vi].value, *vi));
+  // the vertices of Other are appended to ptg in order
+  appendComponents(Other, Offset);
+  for (auto &entry : v_in_g1_u_in_g2) {
+    uniteComponents(get<0>(entry), get<1>(entry) + Offset);
   }
+  indexVertices(Offset);
 }
 
 void PointsToGraph::mergeWith(PointsToGraph &Other, llvm::ImmutableCallSite CS,
@@ -562,6 +702,8 @@ void PointsToGraph::mergeWith(PointsToGraph &Other, llvm::ImmutableCallSite CS,
   // Check if points-to graph of F is already within 'this' whole module
   // points-to graph
   if (ContainedFunctions.count(F->getName().str())) {
+    // F's graph has already been copied by an earlier call site, so only the
+    // parameter and return bindings of this call site have to be recorded.
     for (unsigned i = 0; i < CS.getNumArgOperands(); ++i) {
       auto Formal = getNthFunctionArgument(F, i);
       // Only draw the edges, when these values are of type pointer and
@@ -570,16 +712,21 @@ void PointsToGraph::mergeWith(PointsToGraph &Other, llvm::ImmutableCallSite CS,
           value_vertex_map.count(Formal)) {
         boost::add_edge(value_vertex_map[CS.getArgOperand(i)],
                         value_vertex_map[Formal], CS.getInstruction(), ptg);
+        uniteComponents(value_vertex_map[CS.getArgOperand(i)],
+                        value_vertex_map[Formal]);
       }
     }
 
-    for (auto Formal : getPointersEscapingThroughReturnsForFunction(F)) {
+    for (auto Formal : getReturnedValues(F)) {
       if (value_vertex_map.count(CS.getInstruction()) &&
           value_vertex_map.count(Formal)) {
         boost::add_edge(value_vertex_map[CS.getInstruction()],
                         value_vertex_map[Formal], CS.getInstruction(), ptg);
+        uniteComponents(value_vertex_map[CS.getInstruction()],
+                        value_vertex_map[Formal]);
       }
     }
+    PTSCache.clear();
   } else {
     ContainedFunctions.insert(F->getName().str());
     // TODO this function has to check if F's points-to graph is already merged
@@ -598,7 +745,7 @@ void PointsToGraph::mergeWith(PointsToGraph &Other, llvm::ImmutableCallSite CS,
       }
     }
 
-    for (auto Formal : Other.getPointersEscapingThroughReturnsForFunction(F)) {
+    for (auto Formal : getReturnedValues(F)) {
       if (value_vertex_map.count(CS.getInstruction()) &&
           Other.value_vertex_map.count(Formal)) {
         v_in_g1_u_in_g2.push_back(
@@ -621,18 +768,154 @@ void PointsToGraph::mergeWith(PointsToGraph &Other, llvm::ImmutableCallSite CS,
         boost::num_vertices(Other.ptg));
     IsoMap mapV = boost::make_iterator_property_map(
         orig2copy_data.begin(), get(boost::vertex_index, Other.ptg));
+    size_t Offset = boost::num_vertices(ptg);
     boost::copy_graph(Other.ptg, ptg,
                       boost::orig_to_copy(mapV)); // means g1 += g2
+    appendComponents(Other, Offset);
     for (auto &entry : v_in_g1_u_in_g2) {
       PointsToGraph::vertex_t u_in_g1 = mapV[entry.second];
       boost::add_edge(entry.first, u_in_g1, CS.getInstruction(), ptg);
+      uniteComponents(entry.first, u_in_g1);
+    }
+    indexVertices(Offset);
+  }
+}
+
+/**
+ * Adds the vertices starting at From to value_vertex_map. Values that are
+ * already mapped keep their earlier vertex.
+ */
+void PointsToGraph::indexVertices(vertex_t From) {
+  for (vertex_t V = From; V < boost::num_vertices(ptg); ++V) {
+    value_vertex_map.insert(make_pair(ptg[V].value, V));
+  }
+}
+
+/**
+ * Returns the values returned by F, which is what
+ * getPointersEscapingThroughReturnsForFunction() finds, without scanning the
+ * whole graph.
+ */
+vector<const llvm::Value *>
+PointsToGraph::getReturnedValues(const llvm::Function *F) {
+  vector<const llvm::Value *> Returned;
+  for (auto &BB : *F) {
+    if (auto R = llvm::dyn_cast<llvm::ReturnInst>(BB.getTerminator())) {
+      if (R->getReturnValue()) {
+        Returned.push_back(R->getReturnValue());
+      }
+    }
+  }
+  return Returned;
+}
+
+void PointsToGraph::exportAsBinary(const string &filename) const {
+  uint64_t NumVertices = boost::num_vertices(ptg);
+  string StringTable;
+  unordered_map<string, uint64_t> NameOffsets;
+  auto getNameOffset = [&](const string &Name) {
+    auto Search = NameOffsets.find(Name);
+    if (Search != NameOffsets.end()) {
+      return Search->second;
+    }
+    uint64_t Offset = StringTable.size();
+    StringTable.append(Name);
+    StringTable.push_back('\0');
+    NameOffsets[Name] = Offset;
+    return Offset;
+  };
+  auto getID = [](const llvm::Instruction *I) {
+    string ID = getMetaDataID(I);
+    if (ID == "-1") {
+      throw runtime_error("cannot export points-to graph, instruction has no "
+                          "id: " +
+                          llvmIRToString(I));
+    }
+    return stoull(ID);
+  };
+  vector<MappedPTGVertex> Vertices;
+  Vertices.reserve(NumVertices);
+  for (vertex_t V = 0; V < NumVertices; ++V) {
+    const llvm::Value *Value = ptg[V].value;
+    MappedPTGVertex Vertex = {0, 0, 0};
+    if (auto I = llvm::dyn_cast<llvm::Instruction>(Value)) {
+      Vertex.Kind = static_cast<uint32_t>(MappedValueKind::Instruction);
+      Vertex.ID = getID(I);
+    } else if (auto A = llvm::dyn_cast<llvm::Argument>(Value)) {
+      Vertex.Kind = static_cast<uint32_t>(MappedValueKind::Argument);
+      Vertex.ID = getNameOffset(A->getParent()->getName().str());
+      Vertex.Index = A->getArgNo();
+    } else if ((llvm::isa<llvm::GlobalVariable>(Value) ||
+                llvm::isa<llvm::Function>(Value)) &&
+               Value->hasName()) {
+      Vertex.Kind = static_cast<uint32_t>(MappedValueKind::Global);
+      Vertex.ID = getNameOffset(Value->getName().str());
+    } else {
+      // constants are uniqued, hence any instruction using the value will do
+      const llvm::Instruction *User = nullptr;
+      for (auto U : Value->users()) {
+        if ((User = llvm::dyn_cast<llvm::Instruction>(U))) {
+          break;
+        }
+      }
+      if (!User) {
+        throw runtime_error("cannot export points-to graph, value is not "
+                            "used by an instruction: " +
+                            llvmIRToString(Value));
+      }
+      Vertex.Kind = static_cast<uint32_t>(MappedValueKind::Operand);
+      Vertex.ID = getID(User);
+      while (User->getOperand(Vertex.Index) != Value) {
+        ++Vertex.Index;
+      }
     }
+    Vertices.push_back(Vertex);
+  }
+  vector<uint64_t> AdjacencyOffsets(1, 0);
+  vector<uint32_t> Adjacencies;
+  for (vertex_t V = 0; V < NumVertices; ++V) {
+    out_edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = boost::out_edges(V, ptg); ei != ei_end;
+         ++ei) {
+      Adjacencies.push_back(boost::target(*ei, ptg));
+    }
+    AdjacencyOffsets.push_back(Adjacencies.size());
+  }
+  // number the components in the order of their first vertex
+  unordered_map<vertex_t, uint32_t> ComponentIdx;
+  vector<uint32_t> ComponentOf;
+  ComponentOf.reserve(NumVertices);
+  for (vertex_t V = 0; V < NumVertices; ++V) {
+    ComponentOf.push_back(
+        ComponentIdx.insert(make_pair(findComponent(V), ComponentIdx.size()))
+            .first->second);
+  }
+  vector<uint64_t> ComponentOffsets(ComponentIdx.size() + 1, 0);
+  for (auto C : ComponentOf) {
+    ++ComponentOffsets[C + 1];
+  }
+  for (size_t C = 0; C < ComponentIdx.size(); ++C) {
+    ComponentOffsets[C + 1] += ComponentOffsets[C];
   }
-  value_vertex_map.clear();
-  vertex_iterator_t vi, vi_end;
-  for (boost::tie(vi, vi_end) = boost::vertices(ptg); vi != vi_end; ++vi) {
-    value_vertex_map.insert(make_pair(ptg[*vi].value, *vi));
+  vector<uint32_t> ComponentMembers(NumVertices);
+  vector<uint64_t> Next(ComponentOffsets.begin(), ComponentOffsets.end() - 1);
+  for (vertex_t V = 0; V < NumVertices; ++V) {
+    ComponentMembers[Next[ComponentOf[V]]++] = V;
   }
+  uint64_t Sizes[5] = {NumVertices, boost::num_edges(ptg), ComponentIdx.size(),
+                       StringTable.size(), Adjacencies.size()};
+  string Buffer;
+  appendAligned(Buffer, MappedPointsToGraph::Magic,
+                sizeof(MappedPointsToGraph::Magic));
+  appendAligned(Buffer, Sizes, 5);
+  appendAligned(Buffer, Vertices.data(), Vertices.size());
+  appendAligned(Buffer, StringTable.data(), StringTable.size());
+  appendAligned(Buffer, AdjacencyOffsets.data(), AdjacencyOffsets.size());
+  appendAligned(Buffer, Adjacencies.data(), Adjacencies.size());
+  appendAligned(Buffer, ComponentOf.data(), ComponentOf.size());
+  appendAligned(Buffer, ComponentOffsets.data(), ComponentOffsets.size());
+  appendAligned(Buffer, ComponentMembers.data(), ComponentMembers.size());
+  writeFile(filename, Buffer);
 }
 
 unsigned PointsToGraph::getNumOfVertices() { return boost::num_vertices(ptg); }
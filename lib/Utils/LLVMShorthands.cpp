@@ -14,14 +14,23 @@
  *      Author: philipp
  */
 
+#include <string>
+#include <unordered_map>
+
+#include <llvm/ADT/Hashing.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/Attributes.h>
 #include <llvm/IR/CallSite.h>
+#include <llvm/IR/Constants.h>
 #include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/Function.h>
+#include <llvm/IR/InlineAsm.h>
 #include <llvm/IR/Instructions.h>
+#include <llvm/IR/Metadata.h>
 #include <llvm/IR/Module.h>
+#include <llvm/IR/Operator.h>
 #include <llvm/IR/Value.h>
 #include <llvm/Support/raw_ostream.h>
 
@@ -292,6 +301,228 @@ std::size_t computeModuleHash(const llvm::Module *M) {
   return std::hash<std::string>{}(SourceCode);
 }
 
+namespace {
+
+/// Computes the content hash of a function from the structure of its code.
+/// Types, constants and instructions are hashed field by field, local values
+/// by their position within the function and globals by their names.
+class FunctionHasher {
+public:
+  explicit FunctionHasher(const llvm::Function *F) : F(F) {
+    for (auto &Arg : F->args()) {
+      LocalIds.insert(std::make_pair(&Arg, LocalIds.size()));
+    }
+    for (auto &BB : *F) {
+      LocalIds.insert(std::make_pair(&BB, LocalIds.size()));
+      for (auto &I : BB) {
+        LocalIds.insert(std::make_pair(&I, LocalIds.size()));
+      }
+    }
+  }
+
+  llvm::hash_code hashFunction() {
+    llvm::hash_code Hash = llvm::hash_combine(
+        F->getName(), hashType(F->getFunctionType()), F->getCallingConv(),
+        hashAttributes(F->getAttributes(), F->arg_size()));
+    for (auto &BB : *F) {
+      Hash = llvm::hash_combine(Hash, BB.size());
+      for (auto &I : BB) {
+        Hash = llvm::hash_combine(Hash, hashInstruction(I));
+      }
+    }
+    return Hash;
+  }
+
+private:
+  llvm::hash_code hashType(const llvm::Type *T) {
+    auto Search = TypeHashes.find(T);
+    if (Search != TypeHashes.end()) {
+      return Search->second;
+    }
+    llvm::hash_code Hash = llvm::hash_combine(T->getTypeID());
+    if (auto IT = llvm::dyn_cast<llvm::IntegerType>(T)) {
+      Hash = llvm::hash_combine(Hash, IT->getBitWidth());
+    } else if (auto ST = llvm::dyn_cast<llvm::StructType>(T)) {
+      // named struct types may be recursive, they are identified by name
+      Hash = llvm::hash_combine(Hash, ST->isPacked(), ST->getName());
+    } else if (auto PT = llvm::dyn_cast<llvm::PointerType>(T)) {
+      Hash = llvm::hash_combine(Hash, PT->getAddressSpace());
+    } else if (auto AT = llvm::dyn_cast<llvm::ArrayType>(T)) {
+      Hash = llvm::hash_combine(Hash, AT->getNumElements());
+    } else if (auto VT = llvm::dyn_cast<llvm::VectorType>(T)) {
+      Hash = llvm::hash_combine(Hash, VT->getNumElements());
+    } else if (auto FT = llvm::dyn_cast<llvm::FunctionType>(T)) {
+      Hash = llvm::hash_combine(Hash, FT->isVarArg());
+    }
+    auto ST = llvm::dyn_cast<llvm::StructType>(T);
+    if (!ST || ST->isLiteral()) {
+      for (auto Sub : T->subtypes()) {
+        Hash = llvm::hash_combine(Hash, hashType(Sub));
+      }
+    }
+    TypeHashes.insert(std::make_pair(T, Hash));
+    return Hash;
+  }
+
+  static llvm::hash_code hashAttributes(const llvm::AttributeList &Attrs,
+                                        unsigned NumArgs) {
+    llvm::hash_code Hash = llvm::hash_combine(NumArgs);
+    auto HashIndex = [&](unsigned Index) {
+      if (Attrs.hasAttributes(Index)) {
+        Hash = llvm::hash_combine(Hash, Index, Attrs.getAsString(Index));
+      }
+    };
+    HashIndex(llvm::AttributeList::FunctionIndex);
+    HashIndex(llvm::AttributeList::ReturnIndex);
+    for (unsigned Arg = 0; Arg < NumArgs; ++Arg) {
+      HashIndex(llvm::AttributeList::FirstArgIndex + Arg);
+    }
+    return Hash;
+  }
+
+  /// Hashes the flags and predicates that instructions and constant
+  /// expressions have in common.
+  llvm::hash_code hashOperator(const llvm::User *U) {
+    llvm::hash_code Hash = llvm::hash_combine(hashType(U->getType()));
+    if (auto OBO = llvm::dyn_cast<llvm::OverflowingBinaryOperator>(U)) {
+      Hash = llvm::hash_combine(Hash, OBO->hasNoSignedWrap(),
+                                OBO->hasNoUnsignedWrap());
+    } else if (auto PEO = llvm::dyn_cast<llvm::PossiblyExactOperator>(U)) {
+      Hash = llvm::hash_combine(Hash, PEO->isExact());
+    } else if (auto GEP = llvm::dyn_cast<llvm::GEPOperator>(U)) {
+      Hash = llvm::hash_combine(Hash, GEP->isInBounds(),
+                                hashType(GEP->getSourceElementType()));
+    }
+    if (auto Cmp = llvm::dyn_cast<llvm::CmpInst>(U)) {
+      Hash = llvm::hash_combine(Hash, Cmp->getPredicate());
+    } else if (auto CE = llvm::dyn_cast<llvm::ConstantExpr>(U)) {
+      if (CE->isCompare()) {
+        Hash = llvm::hash_combine(Hash, CE->getPredicate());
+      }
+    }
+    return Hash;
+  }
+
+  llvm::hash_code hashConstant(const llvm::Constant *C) {
+    auto Search = ConstantHashes.find(C);
+    if (Search != ConstantHashes.end()) {
+      return Search->second;
+    }
+    llvm::hash_code Hash =
+        llvm::hash_combine(C->getValueID(), hashType(C->getType()));
+    if (auto GV = llvm::dyn_cast<llvm::GlobalValue>(C)) {
+      // the operands of a global are its initializer or its aliasee, which
+      // belong to the global rather than to the function
+      Hash = llvm::hash_combine(Hash, GV->getName());
+    } else if (auto CI = llvm::dyn_cast<llvm::ConstantInt>(C)) {
+      Hash = llvm::hash_combine(Hash, CI->getValue());
+    } else if (auto CFP = llvm::dyn_cast<llvm::ConstantFP>(C)) {
+      Hash = llvm::hash_combine(Hash, CFP->getValueAPF());
+    } else if (auto CDS = llvm::dyn_cast<llvm::ConstantDataSequential>(C)) {
+      Hash = llvm::hash_combine(Hash, CDS->getRawDataValues());
+    } else {
+      if (auto CE = llvm::dyn_cast<llvm::ConstantExpr>(C)) {
+        Hash = llvm::hash_combine(Hash, CE->getOpcode(), hashOperator(CE));
+      }
+      for (auto &Op : C->operands()) {
+        Hash = llvm::hash_combine(Hash, hashValue(Op));
+      }
+    }
+    ConstantHashes.insert(std::make_pair(C, Hash));
+    return Hash;
+  }
+
+  llvm::hash_code hashValue(const llvm::Value *V) {
+    auto Search = LocalIds.find(V);
+    if (Search != LocalIds.end()) {
+      return llvm::hash_combine('%', Search->second);
+    }
+    if (auto C = llvm::dyn_cast<llvm::Constant>(V)) {
+      return hashConstant(C);
+    }
+    if (llvm::isa<llvm::MetadataAsValue>(V)) {
+      // metadata is numbered module-wide
+      return llvm::hash_combine('!');
+    }
+    if (auto IA = llvm::dyn_cast<llvm::InlineAsm>(V)) {
+      return llvm::hash_combine(hashType(IA->getType()), IA->getAsmString(),
+                                IA->getConstraintString(),
+                                IA->hasSideEffects(), IA->isAlignStack(),
+                                IA->getDialect());
+    }
+    return llvm::hash_combine(V->getValueID(), hashType(V->getType()));
+  }
+
+  llvm::hash_code hashInstruction(const llvm::Instruction &I) {
+    llvm::hash_code Hash = llvm::hash_combine(I.getOpcode(), hashOperator(&I));
+    if (llvm::isa<llvm::FPMathOperator>(&I)) {
+      llvm::FastMathFlags FMF = I.getFastMathFlags();
+      Hash = llvm::hash_combine(Hash, FMF.unsafeAlgebra(), FMF.noNaNs(),
+                                FMF.noInfs(), FMF.noSignedZeros(),
+                                FMF.allowReciprocal(), FMF.allowContract());
+    }
+    if (auto Alloca = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+      Hash = llvm::hash_combine(Hash, hashType(Alloca->getAllocatedType()),
+                                Alloca->getAlignment());
+    } else if (auto Load = llvm::dyn_cast<llvm::LoadInst>(&I)) {
+      Hash = llvm::hash_combine(Hash, Load->isVolatile(), Load->getAlignment(),
+                                static_cast<unsigned>(Load->getOrdering()));
+    } else if (auto Store = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+      Hash =
+          llvm::hash_combine(Hash, Store->isVolatile(), Store->getAlignment(),
+                             static_cast<unsigned>(Store->getOrdering()));
+    } else if (auto RMW = llvm::dyn_cast<llvm::AtomicRMWInst>(&I)) {
+      Hash = llvm::hash_combine(Hash, RMW->getOperation(), RMW->isVolatile(),
+                                static_cast<unsigned>(RMW->getOrdering()));
+    } else if (auto CmpXchg = llvm::dyn_cast<llvm::AtomicCmpXchgInst>(&I)) {
+      Hash = llvm::hash_combine(
+          Hash, CmpXchg->isVolatile(), CmpXchg->isWeak(),
+          static_cast<unsigned>(CmpXchg->getSuccessOrdering()),
+          static_cast<unsigned>(CmpXchg->getFailureOrdering()));
+    } else if (auto Fence = llvm::dyn_cast<llvm::FenceInst>(&I)) {
+      Hash = llvm::hash_combine(Hash,
+                                static_cast<unsigned>(Fence->getOrdering()));
+    } else if (llvm::isa<llvm::CallInst>(&I) ||
+               llvm::isa<llvm::InvokeInst>(&I)) {
+      llvm::ImmutableCallSite CS(&I);
+      Hash = llvm::hash_combine(Hash, CS.getCallingConv(),
+                                hashAttributes(CS.getAttributes(),
+                                               CS.arg_size()));
+      if (auto Call = llvm::dyn_cast<llvm::CallInst>(&I)) {
+        Hash = llvm::hash_combine(Hash, Call->getTailCallKind());
+      }
+    } else if (auto EV = llvm::dyn_cast<llvm::ExtractValueInst>(&I)) {
+      Hash = llvm::hash_combine(Hash, llvm::hash_combine_range(
+                                          EV->idx_begin(), EV->idx_end()));
+    } else if (auto IV = llvm::dyn_cast<llvm::InsertValueInst>(&I)) {
+      Hash = llvm::hash_combine(Hash, llvm::hash_combine_range(
+                                          IV->idx_begin(), IV->idx_end()));
+    } else if (auto Phi = llvm::dyn_cast<llvm::PHINode>(&I)) {
+      // the incoming blocks of a phi node are not among its operands
+      for (unsigned Idx = 0; Idx < Phi->getNumIncomingValues(); ++Idx) {
+        Hash = llvm::hash_combine(Hash, hashValue(Phi->getIncomingBlock(Idx)));
+      }
+    } else if (auto LP = llvm::dyn_cast<llvm::LandingPadInst>(&I)) {
+      Hash = llvm::hash_combine(Hash, LP->isCleanup());
+    }
+    for (auto &Op : I.operands()) {
+      Hash = llvm::hash_combine(Hash, hashValue(Op));
+    }
+    return Hash;
+  }
+
+  const llvm::Function *F;
+  std::unordered_map<const llvm::Value *, std::size_t> LocalIds;
+  std::unordered_map<const llvm::Type *, llvm::hash_code> TypeHashes;
+  std::unordered_map<const llvm::Constant *, llvm::hash_code> ConstantHashes;
+};
+
+} // namespace
+
+std::size_t computeFunctionHash(const llvm::Function *F) {
+  return FunctionHasher(F).hashFunction();
+}
+
 const llvm::TerminatorInst *getNthTermInstruction(const llvm::Function *F,
                                                   unsigned termInstNo) {
   unsigned current = 1;
@@ -0,0 +1,16 @@
+int increment(int i) { return ++i; }
+
+int add(int a, int b) { return a + b; }
+
+int main() {
+  int i = 40;
+  int j = increment(i);
+  int k = add(i, j);
+  for (int l = 0; l < 3; ++l) {
+    k = increment(k);
+  }
+  if (j > 0) {
+    i = add(j, 1);
+  }
+  return 0;
+}
\ No newline at end of file
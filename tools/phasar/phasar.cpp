@@ -24,6 +24,7 @@
 #include <phasar/DB/ProjectIRDB.h>
 #include <phasar/PhasarClang/ClangController.h>
 #include <phasar/PhasarLLVM/ControlFlow/ICFG.h>
+#include <phasar/PhasarLLVM/IfdsIde/SolverConfiguration.h>
 #include <phasar/PhasarLLVM/Passes/GeneralStatisticsPass.h>
 #include <phasar/PhasarLLVM/Plugins/Interfaces/IfdsIde/IDETabulationProblemPlugin.h>
 #include <phasar/PhasarLLVM/Plugins/Interfaces/IfdsIde/IFDSTabulationProblemPlugin.h>
@@ -95,6 +96,19 @@ void validateParamCallGraphAnalysis(const std::string &cga) {
   }
 }
 
+void validateParamThreads(unsigned threads) {
+  if (threads == 0) {
+    throw bpo::error_with_option_name("at least one thread is required");
+  }
+}
+
+void validateParamWorklistOrder(const std::string &order) {
+  if (StringToWorklistOrder.count(order) == 0) {
+    throw bpo::error_with_option_name("'" + order +
+                                      "' is not a valid worklist order");
+  }
+}
+
 void validateParamExport(const std::string &exp) {
   if (StringToExportType.count(exp) == 0) {
     throw bpo::error_with_option_name("'" + exp +
@@ -243,6 +257,11 @@ int main(int argc, const char **argv) {
 			//("export,E", bpo::value<std::string>()->notifier(validateParamExport), "Export mode (TODO: yet to implement!)")
 			("wpa,W", bpo::value<bool>()->default_value(1), "Whole-program analysis mode (1 or 0)")
 			("mem2reg,M", bpo::value<bool>()->default_value(1), "Promote memory to register pass (1 or 0)")
+			("partition-ptg", bpo::value<bool>()->default_value(0), "Partition pointers by underlying object during points-to graph construction (1 or 0)")
+			("lazy-ptg", bpo::value<bool>()->default_value(0), "Construct points-to graphs on demand (1 or 0)")
+			("analysis-cache", bpo::value<std::string>(), "Directory of the on-disk cache for points-to graphs of unchanged modules")
+			("threads", bpo::value<unsigned>()->notifier(validateParamThreads)->default_value(1), "Number of threads used to load and preprocess the IR, construct the call graph and solve the data-flow analyses")
+			("worklist-order", bpo::value<std::string>()->notifier(validateParamWorklistOrder)->default_value("lifo"), "Order in which the IFDS/IDE solver processes path edges (fifo, lifo, priority), priority requires a single thread")
 			("printedgerec,R", bpo::value<bool>()->default_value(0), "Print exploded-super-graph edge recorder (1 or 0)")
       #ifdef PHASAR_PLUGINS_ENABLED
 			("analysis-plugin", bpo::value<std::vector<std::string>>()->notifier(validateParamAnalysisPlugin), "Analysis plugin(s) (absolute path to the shared object file(s))")
@@ -371,6 +390,28 @@ int main(int argc, const char **argv) {
           std::cout << "Mem2reg: " << VariablesMap["mem2reg"].as<bool>()
                     << '\n';
         }
+        if (VariablesMap.count("partition-ptg")) {
+          std::cout << "Partition PTG: "
+                    << VariablesMap["partition-ptg"].as<bool>() << '\n';
+        }
+        if (VariablesMap.count("lazy-ptg")) {
+          std::cout << "Lazy PTG: " << VariablesMap["lazy-ptg"].as<bool>()
+                    << '\n';
+        }
+        if (VariablesMap.count("analysis-cache")) {
+          std::cout << "Analysis cache: "
+                    << VariablesMap["analysis-cache"].as<std::string>()
+                    << '\n';
+        }
+        if (VariablesMap.count("threads")) {
+          std::cout << "Threads: " << VariablesMap["threads"].as<unsigned>()
+                    << '\n';
+        }
+        if (VariablesMap.count("worklist-order")) {
+          std::cout << "Worklist order: "
+                    << VariablesMap["worklist-order"].as<std::string>()
+                    << '\n';
+        }
         if (VariablesMap.count("printedgerec")) {
           std::cout << "Print edge recorder: "
                     << VariablesMap["printedgerec"].as<bool>() << '\n';
@@ -403,6 +444,15 @@ int main(int argc, const char **argv) {
                      "analysis.\n";
         return 1;
       }
+      // the parallel solver processes path edges in work-stealing order
+      if (VariablesMap["threads"].as<unsigned>() > 1 &&
+          StringToWorklistOrder.at(
+              VariablesMap["worklist-order"].as<std::string>()) ==
+              WorklistOrder::priority) {
+        std::cerr << "The priority worklist order can only be used with a "
+                     "single thread.\n";
+        return 1;
+      }
 
       // Plugin Validation
       if (VariablesMap.count("data-flow-analysis")) {
@@ -468,9 +518,20 @@ int main(int argc, const char **argv) {
           if (VariablesMap["mem2reg"].as<bool>()) {
             Opt |= IRDBOptions::MEM2REG;
           }
+          if (VariablesMap["partition-ptg"].as<bool>()) {
+            Opt |= IRDBOptions::PARTITION_PTG;
+          }
+          if (VariablesMap["lazy-ptg"].as<bool>()) {
+            Opt |= IRDBOptions::LAZY_PTG;
+          }
           if (usingModules) {
             ProjectIRDB IRDB(
-                VariablesMap["module"].as<std::vector<std::string>>(), Opt);
+                VariablesMap["module"].as<std::vector<std::string>>(), Opt,
+                VariablesMap["threads"].as<unsigned>());
+            if (VariablesMap.count("analysis-cache")) {
+              IRDB.useAnalysisCache(
+                  VariablesMap["analysis-cache"].as<std::string>());
+            }
             STOP_TIMER("IRDB Construction", PAMM_SEVERITY_LEVEL::Full);
             return IRDB;
           } else {
@@ -487,6 +548,10 @@ int main(int argc, const char **argv) {
             clang::tooling::CompilationDatabase &CompileDB =
                 OptionsParser.getCompilations();
             ProjectIRDB IRDB(CompileDB, Opt);
+            if (VariablesMap.count("analysis-cache")) {
+              IRDB.useAnalysisCache(
+                  VariablesMap["analysis-cache"].as<std::string>());
+            }
             STOP_TIMER("IRDB Construction", PAMM_SEVERITY_LEVEL::Full);
             return IRDB;
           }
@@ -1,6 +1,11 @@
+#include <cstdio>
+#include <functional>
+#include <memory>
+
 #include <gtest/gtest.h>
 #include <phasar/DB/DBConn.h>
 #include <phasar/DB/ProjectIRDB.h>
+#include <phasar/DB/SQLiteBackend.h>
 
 using namespace std;
 using namespace psr;
@@ -66,6 +71,49 @@ TEST_F(DBConnTest, StoreProjectIRDBTest) {
   db.storeProjectIRDB("phasardbtest", IRDB);
 }
 
+TEST_F(DBConnTest, StoreAndLoadWithSQLiteBackend) {
+  const string Filename = "DBConnTest.sqlite";
+  auto removeDatabase = [&Filename]() {
+    for (const char *Suffix : {"", "-wal", "-shm"}) {
+      remove((Filename + Suffix).c_str());
+    }
+  };
+  // Restores the previous backend and removes the database, even if an
+  // assertion fails
+  struct SQLiteDatabase {
+    function<void()> Remove;
+    unique_ptr<DBBackend> Previous;
+    ~SQLiteDatabase() {
+      // closes the database before its files are removed
+      DBConn::getInstance().setBackend(std::move(Previous));
+      Remove();
+    }
+  };
+  removeDatabase();
+  DBConn &db = DBConn::getInstance();
+  SQLiteDatabase Database{removeDatabase,
+                          db.setBackend(make_unique<SQLiteBackend>(Filename))};
+  ProjectIRDB IRDB({pathToLLFiles + "module_wise/module_wise_9/src1_cpp.ll",
+                    pathToLLFiles + "module_wise/module_wise_9/src2_cpp.ll",
+                    pathToLLFiles + "module_wise/module_wise_9/src3_cpp.ll"});
+  db.storeProjectIRDB("phasardbtest", IRDB);
+  ProjectIRDB Loaded = db.loadProjectIRDB("phasardbtest");
+  set<string> Stored, Restored;
+  for (auto M : IRDB.getAllModules()) {
+    Stored.insert(M->getModuleIdentifier());
+  }
+  for (auto M : Loaded.getAllModules()) {
+    Restored.insert(M->getModuleIdentifier());
+  }
+  ASSERT_EQ(Stored, Restored);
+  for (auto F : IRDB.getAllFunctions()) {
+    if (!F->isDeclaration()) {
+      ASSERT_TRUE(Loaded.getFunction(F->getName().str()));
+    }
+  }
+  ASSERT_EQ(db.getDBName(), Filename);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -96,6 +96,29 @@ TEST(HexastoreTest, AllQueryTypes) {
   ASSERT_EQ(Result, GroundTruth);
 }
 
+TEST(HexastoreTest, PutAll) {
+  Hexastore H("PutAll.sqlite");
+  // names are bound as parameters, hence they may contain quotes
+  std::vector<std::array<std::string, 3>> Edges = {
+      {{"\"mary\"", "likes", "hexastores"}},
+      {{"mary", "likes", "'apples'"}},
+      {{"mary", "likes", "'apples'"}},
+      {{"peter", "name", "name"}}};
+  H.putAll(Edges);
+
+  auto Result = H.get({{"?", "?", "?"}});
+  ASSERT_EQ(Result.size(), 3);
+  ASSERT_EQ(Result[0], hs_result("\"mary\"", "likes", "hexastores"));
+  ASSERT_EQ(Result[1], hs_result("mary", "likes", "'apples'"));
+  ASSERT_EQ(Result[2], hs_result("peter", "name", "name"));
+
+  Result = H.get({{"?", "likes", "?"}});
+  ASSERT_EQ(Result.size(), 2);
+  Result = H.get({{"?", "?", "name"}});
+  ASSERT_EQ(Result.size(), 1);
+  ASSERT_EQ(Result[0], hs_result("peter", "name", "name"));
+}
+
 TEST(HexastoreTest, StoreGraphNoEdgeLabels) {
   struct Vertex {
     string name;
@@ -0,0 +1,172 @@
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+
+#include <llvm/IR/InstIterator.h>
+
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/Utils/LLVMShorthands.h>
+
+using namespace std;
+using namespace psr;
+
+class ProjectIRDBTest : public ::testing::Test {
+protected:
+  const string pathToLLFiles = PhasarDirectory + "build/test/llvm_test_code/";
+
+  // Identifies a value by its position within F, or by its name if it is a
+  // global, such that it is found in another IRDB of the same module
+  static string valueToPosition(const llvm::Function *F, const llvm::Value *V) {
+    if (auto Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+      if (Arg->getParent() == F) {
+        return "arg " + to_string(Arg->getArgNo());
+      }
+    }
+    size_t Position = 0;
+    for (auto I = llvm::inst_begin(F), E = llvm::inst_end(F); I != E;
+         ++I, ++Position) {
+      if (&*I == V) {
+        return "inst " + to_string(Position);
+      }
+    }
+    if (auto GV = llvm::dyn_cast<llvm::GlobalValue>(V)) {
+      return "@" + GV->getName().str();
+    }
+    return llvmIRToString(V);
+  }
+};
+
+// The id side tables agree with the annotated metadata
+TEST_F(ProjectIRDBTest, InstructionIDs) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/static_callsite_1_c.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  for (auto M : IRDB.getAllModules()) {
+    for (auto &F : *M) {
+      for (auto I = llvm::inst_begin(F), E = llvm::inst_end(F); I != E; ++I) {
+        size_t ID = IRDB.getInstructionID(&*I);
+        ASSERT_EQ(to_string(ID), getMetaDataID(&*I));
+        ASSERT_EQ(&*I, IRDB.getInstruction(ID));
+        ASSERT_EQ(&*I, IRDB.persistedStringToValue(
+                           IRDB.valueToPersistedString(&*I)));
+      }
+    }
+  }
+  ASSERT_EQ(nullptr, IRDB.getInstruction(numeric_limits<size_t>::max()));
+}
+
+// A later IRDB of the same process gets higher ids, which its side table is
+// offset by
+TEST_F(ProjectIRDBTest, InstructionIDsOfLaterIRDB) {
+  const string File = pathToLLFiles + "call_graphs/static_callsite_1_c.ll";
+  ProjectIRDB IRDB({File}, IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  ProjectIRDB LaterIRDB({File}, IRDBOptions::WPA);
+  LaterIRDB.preprocessIR();
+  const llvm::Instruction *First =
+      &*llvm::inst_begin(IRDB.getFunction("main"));
+  for (auto I = llvm::inst_begin(LaterIRDB.getFunction("main")),
+            E = llvm::inst_end(LaterIRDB.getFunction("main"));
+       I != E; ++I) {
+    size_t ID = LaterIRDB.getInstructionID(&*I);
+    ASSERT_GT(ID, IRDB.getInstructionID(First));
+    ASSERT_EQ(&*I, LaterIRDB.getInstruction(ID));
+  }
+  ASSERT_EQ(nullptr, LaterIRDB.getInstruction(IRDB.getInstructionID(First)));
+}
+
+// Modules that are loaded and preprocessed concurrently get distinct ids
+TEST_F(ProjectIRDBTest, ParallelPreprocessing) {
+  ProjectIRDB IRDB({pathToLLFiles + "module_wise/module_wise_13/src1_cpp.ll",
+                    pathToLLFiles + "module_wise/module_wise_13/src2_cpp.ll",
+                    pathToLLFiles + "module_wise/module_wise_13/main_cpp.ll"},
+                   IRDBOptions::MEM2REG, 3);
+  ASSERT_EQ(3, IRDB.getNumberOfModules());
+  IRDB.preprocessIR(3);
+  set<size_t> IDs;
+  for (auto M : IRDB.getAllModules()) {
+    for (auto &F : *M) {
+      if (!F.isDeclaration()) {
+        ASSERT_TRUE(IRDB.getPointsToGraph(F.getName().str()));
+      }
+      for (auto I = llvm::inst_begin(F), E = llvm::inst_end(F); I != E; ++I) {
+        size_t ID = IRDB.getInstructionID(&*I);
+        ASSERT_TRUE(IDs.insert(ID).second);
+        ASSERT_EQ(&*I, IRDB.getInstruction(ID));
+      }
+    }
+  }
+}
+
+// Modules that share a context are linked without a bitcode round trip
+TEST_F(ProjectIRDBTest, LinkForWPA) {
+  ProjectIRDB IRDB({pathToLLFiles + "module_wise/module_wise_13/src1_cpp.ll",
+                    pathToLLFiles + "module_wise/module_wise_13/src2_cpp.ll",
+                    pathToLLFiles + "module_wise/module_wise_13/main_cpp.ll"},
+                   IRDBOptions::WPA);
+  ASSERT_EQ(3, IRDB.getNumberOfModules());
+  llvm::Module *WPAMod = IRDB.getWPAModule();
+  ASSERT_TRUE(WPAMod);
+  ASSERT_EQ(1, IRDB.getNumberOfModules());
+  ASSERT_EQ(WPAMod, IRDB.getModuleDefiningFunction("_ZN1B3fooERi"));
+  ASSERT_FALSE(WPAMod->getFunction("main")->isDeclaration());
+  ASSERT_FALSE(WPAMod->getFunction("_ZN1B3fooERi")->isDeclaration());
+}
+
+// Points-to graphs of an unchanged module are restored from the cache
+TEST_F(ProjectIRDBTest, AnalysisCache) {
+  auto CacheDir = boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path("phasar-cache-%%%%-%%%%");
+  const string File = pathToLLFiles + "call_graphs/virtual_call_2_cpp.ll";
+  ProjectIRDB IRDB({File}, IRDBOptions::WPA);
+  IRDB.useAnalysisCache(CacheDir.string());
+  IRDB.preprocessIR();
+  ASSERT_EQ(1, distance(boost::filesystem::directory_iterator(CacheDir),
+                        boost::filesystem::directory_iterator()));
+  ProjectIRDB CachedIRDB({File}, IRDBOptions::WPA);
+  CachedIRDB.useAnalysisCache(CacheDir.string());
+  CachedIRDB.preprocessIR();
+  for (auto &F : *IRDB.getWPAModule()) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    const string Name = F.getName().str();
+    ASSERT_FALSE(IRDB.isPointsToGraphRestored(Name));
+    ASSERT_TRUE(CachedIRDB.isPointsToGraphRestored(Name));
+    PointsToGraph &PTG = *IRDB.getPointsToGraph(Name);
+    PointsToGraph *CachedPTG = CachedIRDB.getPointsToGraph(Name);
+    ASSERT_TRUE(CachedPTG);
+    ASSERT_EQ(PTG.getNumOfVertices(), CachedPTG->getNumOfVertices());
+    ASSERT_EQ(PTG.getNumOfEdges(), CachedPTG->getNumOfEdges());
+    // the ids differ, as both databases are preprocessed by the same process,
+    // hence the sets are compared by the positions of their values
+    llvm::Function *CachedF = CachedIRDB.getFunction(Name);
+    auto CachedI = llvm::inst_begin(CachedF);
+    for (auto I = llvm::inst_begin(F), E = llvm::inst_end(F); I != E;
+         ++I, ++CachedI) {
+      set<string> PTS, CachedPTS;
+      for (auto V : PTG.getPointsToSet(&*I)) {
+        PTS.insert(valueToPosition(&F, V));
+      }
+      for (auto V : CachedPTG->getPointsToSet(&*CachedI)) {
+        CachedPTS.insert(valueToPosition(CachedF, V));
+      }
+      EXPECT_EQ(PTS, CachedPTS) << "for " << llvmIRToString(&*I);
+    }
+  }
+  // graphs of another configuration are stored under another entry
+  ProjectIRDB PartitionedIRDB({File},
+                              IRDBOptions::WPA | IRDBOptions::PARTITION_PTG);
+  PartitionedIRDB.useAnalysisCache(CacheDir.string());
+  PartitionedIRDB.preprocessIR();
+  ASSERT_EQ(2, distance(boost::filesystem::directory_iterator(CacheDir),
+                        boost::filesystem::directory_iterator()));
+  boost::filesystem::remove_all(CacheDir);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
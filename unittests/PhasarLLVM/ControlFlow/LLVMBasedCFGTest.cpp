@@ -228,6 +228,23 @@ TEST_F(LLVMBasedCFGTest, HandleFieldStoreField) {
   ASSERT_TRUE(cfg.isFieldStore(Inst));
 }
 
+TEST_F(LLVMBasedCFGTest, HandlesConsistentSuccsAndPreds) {
+  LLVMBasedCFG cfg;
+  ProjectIRDB IRDB({pathToLLFiles + "control_flow/switch_cpp.ll"});
+  auto F = IRDB.getFunction("main");
+  auto Insts = cfg.getAllInstructionsOf(F);
+  ASSERT_EQ(Insts.size(), F->getInstructionCount());
+  size_t NumPreds = 0;
+  for (auto I : Insts) {
+    for (auto Succ : cfg.getSuccsOf(I)) {
+      auto Preds = cfg.getPredsOf(Succ);
+      ASSERT_NE(find(Preds.begin(), Preds.end(), I), Preds.end());
+    }
+    NumPreds += cfg.getPredsOf(I).size();
+  }
+  ASSERT_EQ(cfg.getAllControlFlowEdges(F).size(), NumPreds);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,9 +1,17 @@
+#include <cstdio>
+
 #include <gtest/gtest.h>
 
 #include <string>
 
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+
 #include <phasar/DB/ProjectIRDB.h>
 #include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
+#include <phasar/PhasarLLVM/ControlFlow/MappedICFG.h>
 #include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
 
 using namespace std;
@@ -37,6 +45,179 @@ TEST_F(LLVMBasedICFGTest, StaticCallSite_1) {
   }
 }
 
+TEST_F(LLVMBasedICFGTest, StaticCallSite_2) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/static_callsite_1_c.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(TH, IRDB, CallGraphAnalysisType::CHA, {"main"});
+  llvm::Function *F = IRDB.getFunction("main");
+  llvm::Function *Foo = IRDB.getFunction("foo");
+  ASSERT_TRUE(F);
+  ASSERT_TRUE(Foo);
+  set<const llvm::Instruction *> CallSites = ICFG.getCallsFromWithin(F);
+  set<const llvm::Instruction *> FooCallers = ICFG.getCallersOf(Foo);
+  ASSERT_EQ(FooCallers.size(), 1u);
+  ASSERT_TRUE(CallSites.count(*FooCallers.begin()));
+  set<const llvm::Function *> Callees =
+      ICFG.getCalleesOfCallAt(*FooCallers.begin());
+  ASSERT_EQ(Callees, set<const llvm::Function *>{Foo});
+  ASSERT_TRUE(ICFG.getCallersOf(F).empty());
+}
+
+TEST_F(LLVMBasedICFGTest, ParallelConstruction) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/virtual_call_2_cpp.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG Sequential(TH, IRDB, CallGraphAnalysisType::CHA, {"main"});
+  LLVMBasedICFG Parallel(TH, IRDB, CallGraphAnalysisType::CHA, {"main"}, 4);
+  ASSERT_EQ(Sequential.getNumOfVertices(), Parallel.getNumOfVertices());
+  ASSERT_EQ(Sequential.getNumOfEdges(), Parallel.getNumOfEdges());
+  for (auto F : IRDB.getAllFunctions()) {
+    for (auto CallSite : Sequential.getCallsFromWithin(F)) {
+      ASSERT_EQ(Sequential.getCalleesOfCallAt(CallSite),
+                Parallel.getCalleesOfCallAt(CallSite));
+    }
+    ASSERT_EQ(Sequential.getCallersOf(F), Parallel.getCallersOf(F));
+  }
+}
+
+TEST_F(LLVMBasedICFGTest, UpdateChangedFunctions) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/static_callsite_1_c.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(TH, IRDB, CallGraphAnalysisType::CHA, {"main"});
+  llvm::Function *F = IRDB.getFunction("main");
+  llvm::Function *Foo = IRDB.getFunction("foo");
+  ASSERT_TRUE(F);
+  ASSERT_TRUE(Foo);
+  ASSERT_TRUE(ICFG.updateChangedFunctions().empty());
+  set<const llvm::Instruction *> FooCallers = ICFG.getCallersOf(Foo);
+  ASSERT_EQ(FooCallers.size(), 1u);
+  // remove the call to foo from main
+  const_cast<llvm::Instruction *>(*FooCallers.begin())->eraseFromParent();
+  ASSERT_EQ(ICFG.updateChangedFunctions(), set<string>{"main"});
+  ASSERT_TRUE(ICFG.getCallersOf(Foo).empty());
+}
+
+// The control-flow graph of a changed function must not be answered from its
+// index of the old body
+TEST_F(LLVMBasedICFGTest, UpdateChangedFunctionsCFG) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/static_callsite_1_c.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(TH, IRDB, CallGraphAnalysisType::CHA, {"main"});
+  llvm::Function *Foo = IRDB.getFunction("foo");
+  ASSERT_TRUE(Foo);
+  set<const llvm::Instruction *> FooCallers = ICFG.getCallersOf(Foo);
+  ASSERT_EQ(FooCallers.size(), 1u);
+  const llvm::Instruction *Call = *FooCallers.begin();
+  // record the hashes of the bodies before they are changed
+  ASSERT_TRUE(ICFG.updateChangedFunctions().empty());
+  const llvm::Instruction *Prev = Call->getPrevNode();
+  const llvm::Instruction *Next = Call->getNextNode();
+  ASSERT_TRUE(Prev);
+  ASSERT_TRUE(Next);
+  // index main's body before it is changed
+  ASSERT_EQ(ICFG.getSuccsOf(Prev), vector<const llvm::Instruction *>{Call});
+  ASSERT_EQ(ICFG.getPredsOf(Next), vector<const llvm::Instruction *>{Call});
+  // remove the call to foo from main
+  const_cast<llvm::Instruction *>(Call)->eraseFromParent();
+  ASSERT_EQ(ICFG.updateChangedFunctions(), set<string>{"main"});
+  ASSERT_EQ(ICFG.getSuccsOf(Prev), vector<const llvm::Instruction *>{Next});
+  ASSERT_EQ(ICFG.getPredsOf(Next), vector<const llvm::Instruction *>{Prev});
+}
+
+// A function pointer call in an unchanged function may point to a function
+// that has been added since the call graph has been constructed
+TEST_F(LLVMBasedICFGTest, UpdateFunctionPointerTargets) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/function_pointer_1_c.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(TH, IRDB, CallGraphAnalysisType::CHA, {"main"});
+  llvm::Function *F = IRDB.getFunction("main");
+  llvm::Function *Foo = IRDB.getFunction("foo");
+  ASSERT_TRUE(F);
+  ASSERT_TRUE(Foo);
+  const llvm::Instruction *CallSite = nullptr;
+  for (auto I : ICFG.getCallsFromWithin(F)) {
+    if (!llvm::ImmutableCallSite(I).getCalledFunction()) {
+      CallSite = I;
+    }
+  }
+  ASSERT_TRUE(CallSite);
+  ASSERT_TRUE(ICFG.getCalleesOfCallAt(CallSite).count(Foo));
+  // add a function of foo's type next to it
+  llvm::Function *Baz =
+      llvm::Function::Create(Foo->getFunctionType(),
+                             llvm::Function::ExternalLinkage, "baz",
+                             Foo->getParent());
+  llvm::ReturnInst::Create(
+      Baz->getContext(), llvm::ConstantInt::get(Baz->getReturnType(), 0),
+      llvm::BasicBlock::Create(Baz->getContext(), "entry", Baz));
+  IRDB.updateFunctionModuleMapping(Foo->getParent());
+  ASSERT_EQ(ICFG.updateChangedFunctions(), set<string>{"main"});
+  ASSERT_TRUE(ICFG.getCalleesOfCallAt(CallSite).count(Baz));
+  ASSERT_TRUE(ICFG.getCalleesOfCallAt(CallSite).count(Foo));
+}
+
+// Without WPA, a function that is not defined anywhere is declared in each
+// module that calls it, and every declaration must know all callers
+TEST_F(LLVMBasedICFGTest, CallersOfDeclarationInSeveralModules) {
+  const string Src1 = pathToLLFiles + "module_wise/module_wise_9/src1_cpp.ll";
+  const string Src3 = pathToLLFiles + "module_wise/module_wise_9/src3_cpp.ll";
+  ProjectIRDB IRDB({pathToLLFiles + "module_wise/module_wise_9/main_cpp.ll",
+                    Src1,
+                    pathToLLFiles + "module_wise/module_wise_9/src2_cpp.ll",
+                    Src3},
+                   IRDBOptions::NONE);
+  IRDB.preprocessIR();
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(TH, IRDB, CallGraphAnalysisType::CHA,
+                     {"_Z7give_mev", "_Z5otherv"});
+  // operator new
+  const llvm::Function *NewInSrc1 = IRDB.getModule(Src1)->getFunction("_Znwm");
+  const llvm::Function *NewInSrc3 = IRDB.getModule(Src3)->getFunction("_Znwm");
+  ASSERT_TRUE(NewInSrc1);
+  ASSERT_TRUE(NewInSrc3);
+  ASSERT_NE(NewInSrc1, NewInSrc3);
+  set<const llvm::Instruction *> Callers = ICFG.getCallersOf(NewInSrc1);
+  set<const llvm::Function *> CallingFunctions;
+  for (auto CallSite : Callers) {
+    CallingFunctions.insert(CallSite->getFunction());
+  }
+  ASSERT_EQ(CallingFunctions,
+            (set<const llvm::Function *>{IRDB.getFunction("_Z7give_mev"),
+                                         IRDB.getFunction("_Z5otherv")}));
+  ASSERT_EQ(ICFG.getCallersOf(NewInSrc3), Callers);
+}
+
+// A call graph mapped from its binary export answers the same queries
+TEST_F(LLVMBasedICFGTest, MappedICFG) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/virtual_call_2_cpp.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(TH, IRDB, CallGraphAnalysisType::CHA, {"main"});
+  const string Filename = "virtual_call_2_cpp.icfg";
+  ICFG.exportAsBinary(Filename);
+  MappedICFG Mapped(IRDB, Filename);
+  ASSERT_EQ(ICFG.getNumOfVertices(), Mapped.getNumOfVertices());
+  ASSERT_EQ(ICFG.getNumOfEdges(), Mapped.getNumOfEdges());
+  for (auto F : IRDB.getAllFunctions()) {
+    for (auto CallSite : ICFG.getCallsFromWithin(F)) {
+      ASSERT_EQ(ICFG.getCalleesOfCallAt(CallSite),
+                Mapped.getCalleesOfCallAt(CallSite));
+    }
+    ASSERT_EQ(ICFG.getCallersOf(F), Mapped.getCallersOf(F));
+  }
+  remove(Filename.c_str());
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <phasar/PhasarLLVM/IfdsIde/EdgeFunction.h>
+#include <phasar/PhasarLLVM/IfdsIde/EdgeFunctionComposer.h>
+#include <phasar/PhasarLLVM/IfdsIde/EdgeFunctions/AllBottom.h>
+
+using namespace psr;
+
+static unsigned NumAddEFs = 0;
+
+struct MyEFC : EdgeFunctionComposer<int> {
+  MyEFC(std::shared_ptr<EdgeFunction<int>> F,
+        std::shared_ptr<EdgeFunction<int>> G)
+      : EdgeFunctionComposer<int>(F, G){};
+  std::shared_ptr<EdgeFunction<int>>
+  joinWith(std::shared_ptr<EdgeFunction<int>> otherFunction) override {
+    return makeInternedEdgeFunction<AllBottom<int>>(-1);
+  };
+};
+
+struct AddEF : EdgeFunction<int>, std::enable_shared_from_this<AddEF> {
+  const int Summand;
+  AddEF(int Summand) : Summand(Summand) { ++NumAddEFs; }
+  int computeTarget(int source) override { return source + Summand; }
+  std::shared_ptr<EdgeFunction<int>>
+  composeWith(std::shared_ptr<EdgeFunction<int>> secondFunction) override {
+    if (auto *Add = dynamic_cast<AddEF *>(secondFunction.get())) {
+      return makeInternedEdgeFunction<AddEF>(Summand + Add->Summand);
+    }
+    return makeInternedEdgeFunction<MyEFC>(
+        this->shared_from_this(), secondFunction);
+  }
+  std::shared_ptr<EdgeFunction<int>>
+  joinWith(std::shared_ptr<EdgeFunction<int>> otherFunction) override {
+    if (otherFunction.get() == this) {
+      return this->shared_from_this();
+    }
+    return makeInternedEdgeFunction<AllBottom<int>>(-1);
+  }
+  bool equal_to(std::shared_ptr<EdgeFunction<int>> other) const override {
+    return this == other.get();
+  }
+};
+
+TEST(EdgeFunctionInterningTest, HandleInterning) {
+  NumAddEFs = 0;
+  auto EF1 = makeInternedEdgeFunction<AddEF>(1);
+  auto EF2 = makeInternedEdgeFunction<AddEF>(1);
+  auto EF3 = makeInternedEdgeFunction<AddEF>(2);
+  EXPECT_EQ(EF1, EF2);
+  EXPECT_NE(EF1, EF3);
+  EXPECT_EQ(NumAddEFs, 2u);
+  std::shared_ptr<EdgeFunction<int>> Composed = EF1->composeWith(EF1);
+  EXPECT_EQ(Composed, EF3);
+  EXPECT_TRUE(equalEdgeFunctions<int>(Composed, EF3));
+  // released instances are constructed again
+  EF1.reset();
+  EF2.reset();
+  makeInternedEdgeFunction<AddEF>(1);
+  EXPECT_EQ(NumAddEFs, 3u);
+}
+
+TEST(EdgeFunctionInterningTest, HandleConcurrentInterning) {
+  NumAddEFs = 0;
+  std::vector<std::shared_ptr<AddEF>> Interned(8 * 100);
+  std::vector<std::thread> Threads;
+  for (int T = 0; T < 8; ++T) {
+    Threads.emplace_back([&Interned, T]() {
+      for (int Summand = 0; Summand < 100; ++Summand) {
+        Interned[T * 100 + Summand] =
+            makeInternedEdgeFunction<AddEF>(1000 + Summand);
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  // all threads must agree on the instance of every edge function
+  for (int T = 1; T < 8; ++T) {
+    for (int Summand = 0; Summand < 100; ++Summand) {
+      EXPECT_EQ(Interned[T * 100 + Summand], Interned[Summand]);
+    }
+  }
+  EXPECT_EQ(NumAddEFs, 100u);
+}
+
+TEST(EdgeFunctionInterningTest, HandleMemoizedComposeAndJoin) {
+  EdgeFunctionMemo<int> Memo;
+  std::shared_ptr<EdgeFunction<int>> Add = makeInternedEdgeFunction<AddEF>(3);
+  std::shared_ptr<EdgeFunction<int>> Bot =
+      makeInternedEdgeFunction<AllBottom<int>>(-1);
+  auto C1 = Memo.compose(Add, Bot);
+  auto C2 = Memo.compose(Add, Bot);
+  EXPECT_EQ(C1, C2);
+  EXPECT_EQ(C1->computeTarget(1), -1);
+  EXPECT_EQ(Memo.join(Add, Add), Add);
+  EXPECT_EQ(Memo.join(Add, C1), Memo.join(Add, C1));
+}
+
+TEST(EdgeFunctionInterningTest, HandleMemoEviction) {
+  EdgeFunctionMemo<int> Memo(1, 1);
+  std::shared_ptr<EdgeFunction<int>> Add = makeInternedEdgeFunction<AddEF>(4);
+  std::shared_ptr<EdgeFunction<int>> Bot =
+      makeInternedEdgeFunction<AllBottom<int>>(-1);
+  std::weak_ptr<EdgeFunction<int>> Composed = Memo.compose(Add, Bot);
+  // the memo keeps the result alive as long as the pair is memoized
+  EXPECT_FALSE(Composed.expired());
+  // evicts the first pair, which releases its result
+  Memo.compose(Add, Add);
+  EXPECT_TRUE(Composed.expired());
+}
+
+// main function for the test case
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,4 +1,15 @@
+#include <pthread.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+
 #include <gtest/gtest.h>
+
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
 #include <phasar/DB/ProjectIRDB.h>
 #include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
 #include <phasar/PhasarLLVM/IfdsIde/Problems/IDELinearConstantAnalysis.h>
@@ -25,6 +36,16 @@ protected:
 
   void Initialize(const std::vector<std::string> &IRFiles) {
     IRDB = new ProjectIRDB(IRFiles);
+    InitializeProblem();
+  }
+
+  void Initialize(std::unique_ptr<llvm::Module> M) {
+    IRDB = new ProjectIRDB(IRDBOptions::NONE);
+    IRDB->insertModule(std::move(M));
+    InitializeProblem();
+  }
+
+  void InitializeProblem() {
     IRDB->preprocessIR();
     TH = new LLVMTypeHierarchy(*IRDB);
     ICFG =
@@ -66,6 +87,77 @@ protected:
     }
     EXPECT_EQ(results, groundTruth);
   }
+
+  /**
+   * Solves the problem in the given worklist order with the given number of
+   * threads and maps the id of every instruction to the values of the facts
+   * that hold there.
+   */
+  std::map<std::string, std::map<std::string, int64_t>>
+  solveWith(WorklistOrder Order, unsigned NumThreads = 1) {
+    LCAProblem->solver_config.worklistOrder = Order;
+    LCAProblem->solver_config.numThreads = NumThreads;
+    LLVMIDESolver<const llvm::Value *, int64_t, LLVMBasedICFG &> llvmlcasolver(
+        *LCAProblem, false, false);
+    llvmlcasolver.solve();
+    std::map<std::string, std::map<std::string, int64_t>> results;
+    for (auto M : IRDB->getAllModules()) {
+      for (auto &F : *M) {
+        for (auto &BB : F) {
+          for (auto &I : BB) {
+            for (auto res : llvmlcasolver.resultsAt(&I, true)) {
+              results[getMetaDataID(&I)][getMetaDataID(res.first)] =
+                  res.second;
+            }
+          }
+        }
+      }
+    }
+    return results;
+  }
+
+  /**
+   * Creates a module whose main function stores the constants 1 to Depth to
+   * the same local variable, one after another.
+   */
+  static std::unique_ptr<llvm::Module> makeStoreChain(unsigned Depth) {
+    // the context is owned by the ProjectIRDB the module is inserted into
+    auto *Ctx = new llvm::LLVMContext();
+    auto M = std::make_unique<llvm::Module>("store_chain.ll", *Ctx);
+    auto *Main = llvm::Function::Create(
+        llvm::FunctionType::get(llvm::Type::getInt32Ty(*Ctx), false),
+        llvm::Function::ExternalLinkage, "main", M.get());
+    llvm::IRBuilder<> Builder(llvm::BasicBlock::Create(*Ctx, "entry", Main));
+    auto *Var = Builder.CreateAlloca(Builder.getInt32Ty());
+    for (unsigned I = 1; I <= Depth; ++I) {
+      Builder.CreateStore(Builder.getInt32(I), Var);
+    }
+    Builder.CreateRet(Builder.getInt32(0));
+    return M;
+  }
+
+  /**
+   * Runs the task on a thread whose stack is limited to StackSize bytes.
+   */
+  static void runWithStackSize(std::size_t StackSize,
+                               std::function<void()> Task) {
+    pthread_attr_t Attr;
+    pthread_attr_init(&Attr);
+    pthread_attr_setstacksize(&Attr, StackSize);
+    pthread_t Thread;
+    int Err = pthread_create(
+        &Thread, &Attr,
+        [](void *Arg) -> void * {
+          (*static_cast<std::function<void()> *>(Arg))();
+          return nullptr;
+        },
+        &Task);
+    if (Err == 0) {
+      pthread_join(Thread, nullptr);
+    }
+    pthread_attr_destroy(&Attr);
+    ASSERT_EQ(Err, 0);
+  }
 }; // Test Fixture
 
 /* ============== BASIC TESTS ============== */
@@ -260,6 +352,57 @@ TEST_F(IDELinearConstantAnalysisTest, HandleCallTest_05) {
   compareResults(gt, llvmlcasolver);
 }
 
+/* ============== SOLVER TESTS ============== */
+TEST_F(IDELinearConstantAnalysisTest, HandleWorklistOrders) {
+  Initialize({pathToLLFiles + "call_06_cpp_dbg.ll"});
+  auto lifo = solveWith(WorklistOrder::lifo);
+  EXPECT_FALSE(lifo.empty());
+  EXPECT_EQ(solveWith(WorklistOrder::fifo), lifo);
+  EXPECT_EQ(solveWith(WorklistOrder::priority), lifo);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleParallelSolving) {
+  Initialize({pathToLLFiles + "call_06_cpp_dbg.ll"});
+  auto serial = solveWith(WorklistOrder::lifo);
+  EXPECT_FALSE(serial.empty());
+  for (unsigned NumThreads : {2, 4, 8}) {
+    EXPECT_EQ(solveWith(WorklistOrder::lifo, NumThreads), serial)
+        << NumThreads << " threads";
+  }
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleParallelValueComputation) {
+  // enough non-call start nodes to give every thread a share of phase II(ii)
+  const unsigned Depth = 1000;
+  Initialize(makeStoreChain(Depth));
+  auto serial = solveWith(WorklistOrder::lifo);
+  // every store and the return see the variable
+  EXPECT_GE(serial.size(), static_cast<std::size_t>(Depth));
+  for (unsigned NumThreads : {2, 4, 8, 16}) {
+    EXPECT_EQ(solveWith(WorklistOrder::lifo, NumThreads), serial)
+        << NumThreads << " threads";
+  }
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleDeepSuperGraph) {
+  // A solver that recurses once per path edge needs several megabytes of
+  // stack for this chain, the worklist keeps the depth independent of it.
+  const unsigned Depth = 20000;
+  Initialize(makeStoreChain(Depth));
+  const llvm::Function *Main = IRDB->getFunction("main");
+  const llvm::Instruction *Var = &Main->front().front();
+  const llvm::Instruction *Ret = &Main->back().back();
+  for (auto Order : {WorklistOrder::fifo, WorklistOrder::lifo,
+                     WorklistOrder::priority}) {
+    LCAProblem->solver_config.worklistOrder = Order;
+    LLVMIDESolver<const llvm::Value *, int64_t, LLVMBasedICFG &> llvmlcasolver(
+        *LCAProblem, false, false);
+    runWithStackSize(512 * 1024, [&]() { llvmlcasolver.solve(); });
+    EXPECT_EQ(llvmlcasolver.resultAt(Ret, Var), static_cast<int64_t>(Depth))
+        << Order;
+  }
+}
+
 // main function for the test case
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
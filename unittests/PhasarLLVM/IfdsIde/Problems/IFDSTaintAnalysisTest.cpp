@@ -2,6 +2,7 @@
 #include <phasar/DB/ProjectIRDB.h>
 #include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
 #include <phasar/PhasarLLVM/IfdsIde/Problems/IFDSTaintAnalysis.h>
+#include <phasar/PhasarLLVM/IfdsIde/Solver/BitVectorIFDSSolver.h>
 #include <phasar/PhasarLLVM/IfdsIde/Solver/LLVMIFDSSolver.h>
 #include <phasar/PhasarLLVM/Passes/ValueAnnotationPass.h>
 #include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
@@ -49,7 +50,7 @@ protected:
     delete TSF;
   }
 
-  void compareResults(map<int, set<string>> &GroundTruth) {
+  map<int, set<string>> collectLeaks() {
     // std::map<n_t, std::set<d_t>> Leaks;
     map<int, set<string>> FoundLeaks;
     for (auto Leak : TaintProblem->Leaks) {
@@ -60,7 +61,39 @@ protected:
       }
       FoundLeaks.insert(make_pair(SinkId, LeakedValueIds));
     }
-    EXPECT_EQ(FoundLeaks, GroundTruth);
+    return FoundLeaks;
+  }
+
+  void compareResults(map<int, set<string>> &GroundTruth) {
+    EXPECT_EQ(collectLeaks(), GroundTruth);
+  }
+
+  /**
+   * Solves the problem with the given number of threads and maps the id of
+   * every instruction to the ids of the facts that hold there. The leaks are
+   * collected from scratch.
+   */
+  map<string, set<string>> solveWith(unsigned NumThreads) {
+    TaintProblem->Leaks.clear();
+    TaintProblem->solver_config.numThreads = NumThreads;
+    LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> TaintSolver(
+        *TaintProblem, false, false);
+    TaintSolver.solve();
+    map<string, set<string>> Results;
+    for (auto M : IRDB->getAllModules()) {
+      for (auto &F : *M) {
+        for (auto &BB : F) {
+          for (auto &I : BB) {
+            for (auto Fact : TaintSolver.ifdsResultsAt(&I)) {
+              if (!TaintProblem->isZeroValue(Fact)) {
+                Results[getMetaDataID(&I)].insert(getMetaDataID(Fact));
+              }
+            }
+          }
+        }
+      }
+    }
+    return Results;
   }
 }; // Test Fixture
 
@@ -135,6 +168,54 @@ TEST_F(IFDSTaintAnalysisTest, TaintTest_06) {
   compareResults(GroundTruth);
 }
 
+TEST_F(IFDSTaintAnalysisTest, TaintTest_01_BitVector) {
+  Initialize({pathToLLFiles + "dummy_source_sink/taint_01_cpp_dbg.ll"});
+  BitVectorIFDSSolver<const llvm::Instruction *, const llvm::Value *,
+                      const llvm::Function *, LLVMBasedICFG &>
+      TaintSolver(*TaintProblem);
+  TaintSolver.solve();
+  map<int, set<string>> GroundTruth;
+  GroundTruth[13] = set<string>{"12"};
+  compareResults(GroundTruth);
+}
+
+TEST_F(IFDSTaintAnalysisTest, TaintTest_04_BitVector) {
+  Initialize({pathToLLFiles + "dummy_source_sink/taint_04_cpp_dbg.ll"});
+  BitVectorIFDSSolver<const llvm::Instruction *, const llvm::Value *,
+                      const llvm::Function *, LLVMBasedICFG &>
+      TaintSolver(*TaintProblem);
+  TaintSolver.solve();
+  map<int, set<string>> GroundTruth;
+  GroundTruth[19] = set<string>{"18"};
+  GroundTruth[24] = set<string>{"23"};
+  compareResults(GroundTruth);
+}
+
+TEST_F(IFDSTaintAnalysisTest, TaintTest_04_Parallel) {
+  Initialize({pathToLLFiles + "dummy_source_sink/taint_04_cpp_dbg.ll"});
+  auto Serial = solveWith(1);
+  EXPECT_FALSE(Serial.empty());
+  for (unsigned NumThreads : {2, 4, 8}) {
+    EXPECT_EQ(solveWith(NumThreads), Serial) << NumThreads << " threads";
+    map<int, set<string>> GroundTruth;
+    GroundTruth[19] = set<string>{"18"};
+    GroundTruth[24] = set<string>{"23"};
+    compareResults(GroundTruth);
+  }
+}
+
+TEST_F(IFDSTaintAnalysisTest, TaintTest_05_Parallel) {
+  Initialize({pathToLLFiles + "dummy_source_sink/taint_05_cpp_dbg.ll"});
+  auto Serial = solveWith(1);
+  EXPECT_FALSE(Serial.empty());
+  for (unsigned NumThreads : {2, 4, 8}) {
+    EXPECT_EQ(solveWith(NumThreads), Serial) << NumThreads << " threads";
+    map<int, set<string>> GroundTruth;
+    GroundTruth[22] = set<string>{"21"};
+    compareResults(GroundTruth);
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,240 @@
+#include <cstdio>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <llvm/IR/InstIterator.h>
+
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/Pointer/MappedPointsToGraph.h>
+#include <phasar/PhasarLLVM/Pointer/PointsToGraph.h>
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+class PointsToGraphTest : public ::testing::Test {
+protected:
+  const std::string pathToLLFiles =
+      PhasarDirectory + "build/test/llvm_test_code/";
+
+  // The graphs of F in different IRDBs are compared by the persisted names of
+  // the values in the points-to sets of every pointer of F
+  void expectSamePointsToSets(ProjectIRDB &IRDB, ProjectIRDB &OtherIRDB,
+                              const string &F) {
+    PointsToGraph *PTG = IRDB.getPointsToGraph(F);
+    PointsToGraph *OtherPTG = OtherIRDB.getPointsToGraph(F);
+    ASSERT_TRUE(PTG);
+    ASSERT_TRUE(OtherPTG);
+    ASSERT_EQ(PTG->getNumOfVertices(), OtherPTG->getNumOfVertices());
+    ASSERT_EQ(PTG->getNumOfEdges(), OtherPTG->getNumOfEdges());
+    vector<const llvm::Value *> Pointers, OtherPointers;
+    auto collectPointers = [](llvm::Function *Fun,
+                              vector<const llvm::Value *> &Values) {
+      for (auto &Arg : Fun->args()) {
+        if (Arg.getType()->isPointerTy()) {
+          Values.push_back(&Arg);
+        }
+      }
+      for (auto I = llvm::inst_begin(Fun), E = llvm::inst_end(Fun); I != E;
+           ++I) {
+        if (I->getType()->isPointerTy()) {
+          Values.push_back(&*I);
+        }
+      }
+    };
+    collectPointers(IRDB.getFunction(F), Pointers);
+    collectPointers(OtherIRDB.getFunction(F), OtherPointers);
+    ASSERT_EQ(Pointers.size(), OtherPointers.size());
+    for (size_t I = 0; I < Pointers.size(); ++I) {
+      set<string> PTS, OtherPTS;
+      for (auto V : PTG->getPointsToSet(Pointers[I])) {
+        PTS.insert(IRDB.valueToPersistedString(V));
+      }
+      for (auto V : OtherPTG->getPointsToSet(OtherPointers[I])) {
+        OtherPTS.insert(OtherIRDB.valueToPersistedString(V));
+      }
+      EXPECT_EQ(PTS, OtherPTS)
+          << "for " << IRDB.valueToPersistedString(Pointers[I]);
+    }
+  }
+};
+
+// Connected pointers share a single points-to set
+TEST_F(PointsToGraphTest, SharedPointsToSets) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/virtual_call_2_cpp.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  llvm::Function *F = IRDB.getFunction("main");
+  ASSERT_TRUE(F);
+  PointsToGraph &PTG = *IRDB.getPointsToGraph("main");
+  PointsToGraph WholeModulePTG;
+  WholeModulePTG.mergeWith(PTG, F);
+  for (auto I = llvm::inst_begin(F), E = llvm::inst_end(F); I != E; ++I) {
+    if (!I->getType()->isPointerTy()) {
+      continue;
+    }
+    auto PTS = PTG.getSharedPointsToSet(&*I);
+    ASSERT_TRUE(PTS->count(&*I));
+    for (auto Alias : *PTS) {
+      ASSERT_EQ(PTS, PTG.getSharedPointsToSet(Alias));
+    }
+    ASSERT_EQ(*PTS, WholeModulePTG.getPointsToSet(&*I));
+  }
+}
+
+// Concurrent queries of a graph that is not changed anymore must answer with
+// the sets of serial queries
+TEST_F(PointsToGraphTest, ConcurrentQueries) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/virtual_call_2_cpp.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  PointsToGraph WholeModulePTG;
+  vector<const llvm::Value *> Pointers;
+  for (auto &F : *IRDB.getWPAModule()) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    WholeModulePTG.mergeWith(*IRDB.getPointsToGraph(F.getName().str()), &F);
+    for (auto I = llvm::inst_begin(&F), E = llvm::inst_end(&F); I != E; ++I) {
+      if (I->getType()->isPointerTy()) {
+        Pointers.push_back(&*I);
+      }
+    }
+  }
+  ASSERT_FALSE(Pointers.empty());
+  // a copy starts with an empty cache
+  PointsToGraph SerialPTG = WholeModulePTG;
+  const size_t NumThreads = 8;
+  vector<vector<shared_ptr<const set<const llvm::Value *>>>> Results(
+      NumThreads);
+  vector<thread> Threads;
+  for (size_t T = 0; T < NumThreads; ++T) {
+    Threads.emplace_back([&, T] {
+      // every thread queries in a different order
+      for (size_t I = 0; I < Pointers.size(); ++I) {
+        Results[T].push_back(WholeModulePTG.getSharedPointsToSet(
+            Pointers[(I + T * Pointers.size() / NumThreads) %
+                     Pointers.size()]));
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  for (size_t T = 0; T < NumThreads; ++T) {
+    for (size_t I = 0; I < Pointers.size(); ++I) {
+      const llvm::Value *P =
+          Pointers[(I + T * Pointers.size() / NumThreads) % Pointers.size()];
+      ASSERT_EQ(*Results[T][I], SerialPTG.getPointsToSet(P));
+      // all threads share the cached set
+      ASSERT_EQ(Results[T][I], WholeModulePTG.getSharedPointsToSet(P));
+    }
+  }
+}
+
+// Partitioning the pointers must not change the resulting graphs
+TEST_F(PointsToGraphTest, PartitionedConstruction) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/virtual_call_2_cpp.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  ProjectIRDB PartitionedIRDB(
+      {pathToLLFiles + "call_graphs/virtual_call_2_cpp.ll"},
+      IRDBOptions::WPA | IRDBOptions::PARTITION_PTG);
+  PartitionedIRDB.preprocessIR();
+  for (auto &F : *IRDB.getWPAModule()) {
+    if (!F.isDeclaration()) {
+      expectSamePointsToSets(IRDB, PartitionedIRDB, F.getName().str());
+    }
+  }
+}
+
+// Constructing the graphs in parallel must not change the resulting graphs
+TEST_F(PointsToGraphTest, ParallelConstruction) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/virtual_call_2_cpp.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  ProjectIRDB ParallelIRDB(
+      {pathToLLFiles + "call_graphs/virtual_call_2_cpp.ll"}, IRDBOptions::WPA);
+  ParallelIRDB.preprocessIR(4);
+  for (auto &F : *IRDB.getWPAModule()) {
+    if (!F.isDeclaration()) {
+      expectSamePointsToSets(IRDB, ParallelIRDB, F.getName().str());
+    }
+  }
+}
+
+// Lazily constructed graphs are built on first access and cached afterwards
+TEST_F(PointsToGraphTest, LazyConstruction) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/virtual_call_2_cpp.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  ProjectIRDB LazyIRDB({pathToLLFiles + "call_graphs/virtual_call_2_cpp.ll"},
+                       IRDBOptions::WPA | IRDBOptions::LAZY_PTG);
+  LazyIRDB.preprocessIR();
+  PointsToGraph *LazyPTG = LazyIRDB.getPointsToGraph("main");
+  ASSERT_TRUE(LazyPTG);
+  ASSERT_EQ(LazyPTG, LazyIRDB.getPointsToGraph("main"));
+  for (auto &F : *IRDB.getWPAModule()) {
+    if (!F.isDeclaration()) {
+      expectSamePointsToSets(IRDB, LazyIRDB, F.getName().str());
+    }
+  }
+  ASSERT_FALSE(LazyIRDB.getPointsToGraph("not_a_function"));
+}
+
+// A callee's graph is copied only once, further call sites only add bindings
+TEST_F(PointsToGraphTest, MergeCalleeOnce) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/virtual_call_2_cpp.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  llvm::Function *F = IRDB.getFunction("main");
+  ASSERT_TRUE(F);
+  PointsToGraph WholeModulePTG;
+  WholeModulePTG.mergeWith(*IRDB.getPointsToGraph("main"), F);
+  for (auto I = llvm::inst_begin(F), E = llvm::inst_end(F); I != E; ++I) {
+    llvm::ImmutableCallSite CS(&*I);
+    if (!CS || !CS.getCalledFunction() ||
+        CS.getCalledFunction()->isDeclaration()) {
+      continue;
+    }
+    const llvm::Function *Callee = CS.getCalledFunction();
+    PointsToGraph &CalleePTG =
+        *IRDB.getPointsToGraph(Callee->getName().str());
+    WholeModulePTG.mergeWith(CalleePTG, CS, Callee);
+    unsigned Vertices = WholeModulePTG.getNumOfVertices();
+    WholeModulePTG.mergeWith(CalleePTG, CS, Callee);
+    ASSERT_EQ(Vertices, WholeModulePTG.getNumOfVertices());
+    for (auto &Arg : Callee->args()) {
+      if (Arg.getType()->isPointerTy()) {
+        ASSERT_TRUE(WholeModulePTG.getSharedPointsToSet(&Arg)->count(&Arg));
+      }
+    }
+  }
+}
+
+// A points-to graph mapped from its binary export has the same points-to sets
+TEST_F(PointsToGraphTest, MappedPointsToGraph) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/virtual_call_2_cpp.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  llvm::Function *F = IRDB.getFunction("main");
+  ASSERT_TRUE(F);
+  PointsToGraph &PTG = *IRDB.getPointsToGraph("main");
+  const string Filename = "virtual_call_2_cpp.ptg";
+  PTG.exportAsBinary(Filename);
+  MappedPointsToGraph Mapped(IRDB, Filename);
+  ASSERT_EQ(PTG.getNumOfVertices(), Mapped.getNumOfVertices());
+  ASSERT_EQ(PTG.getNumOfEdges(), Mapped.getNumOfEdges());
+  for (auto I = llvm::inst_begin(F), E = llvm::inst_end(F); I != E; ++I) {
+    ASSERT_EQ(PTG.containsValue(&*I), Mapped.containsValue(&*I));
+    ASSERT_EQ(PTG.getPointsToSet(&*I), Mapped.getPointsToSet(&*I));
+  }
+  remove(Filename.c_str());
+}
+} // namespace psr
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include <phasar/Utils/Interner.h>
+#include <string>
+
+using namespace psr;
+
+TEST(InternerTest, HandleDenseIds) {
+  Interner<std::string> I;
+  EXPECT_TRUE(I.empty());
+  EXPECT_EQ(I.intern("a"), 0u);
+  EXPECT_EQ(I.intern("b"), 1u);
+  EXPECT_EQ(I.intern("a"), 0u);
+  EXPECT_EQ(I.intern("c"), 2u);
+  EXPECT_EQ(I.size(), 3u);
+  EXPECT_EQ(I.get(1), "b");
+}
+
+TEST(InternerTest, HandleFind) {
+  Interner<int> I;
+  I.intern(42);
+  EXPECT_EQ(I.find(42), 0u);
+  EXPECT_EQ(I.find(13), Interner<int>::None);
+  // find must not assign ids
+  EXPECT_EQ(I.size(), 1u);
+  I.clear();
+  EXPECT_EQ(I.find(42), Interner<int>::None);
+  EXPECT_EQ(I.intern(13), 0u);
+}
+
+// main function for the test case
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <llvm/IR/Instructions.h>
 #include <phasar/DB/ProjectIRDB.h>
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Macros.h>
@@ -111,6 +112,22 @@ TEST_F(LLVMGetterTest, HandleFunctionsContainingCodesInName) {
             SpecialMemberFunctionTy::NONE);
 }
 
+// The hash of a function must not depend on the module it has been loaded
+// into, but on every flag of its instructions
+TEST_F(LLVMGetterTest, HandlesFunctionHash) {
+  ProjectIRDB IRDB1({pathToLLFiles + "control_flow/global_stmt_cpp.ll"});
+  ProjectIRDB IRDB2({pathToLLFiles + "control_flow/global_stmt_cpp.ll"});
+  auto F = IRDB1.getFunction("main");
+  size_t Hash = computeFunctionHash(F);
+  ASSERT_EQ(Hash, computeFunctionHash(IRDB2.getFunction("main")));
+  auto Store = const_cast<llvm::StoreInst *>(getNthStoreInstruction(F, 1));
+  Store->setVolatile(!Store->isVolatile());
+  size_t VolatileHash = computeFunctionHash(F);
+  ASSERT_NE(Hash, VolatileHash);
+  Store->setAlignment(Store->getAlignment() * 2);
+  ASSERT_NE(VolatileHash, computeFunctionHash(F));
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
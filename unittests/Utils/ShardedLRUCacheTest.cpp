@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <phasar/Utils/ShardedLRUCache.h>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace psr;
+
+TEST(ShardedLRUCacheTest, HandleLookupAndInsert) {
+  ShardedLRUCache<std::tuple<int, int>, int> C;
+  EXPECT_FALSE(C.lookup(std::make_tuple(1, 2)));
+  EXPECT_EQ(C.insert(std::make_tuple(1, 2), 3), 3);
+  EXPECT_EQ(*C.lookup(std::make_tuple(1, 2)), 3);
+  // an existing entry is not overwritten
+  EXPECT_EQ(C.insert(std::make_tuple(1, 2), 4), 3);
+  EXPECT_FALSE(C.lookup(std::make_tuple(2, 1)));
+  EXPECT_EQ(C.size(), 1u);
+  C.clear();
+  EXPECT_FALSE(C.contains(std::make_tuple(1, 2)));
+}
+
+TEST(ShardedLRUCacheTest, HandleInsertWith) {
+  ShardedLRUCache<int, int> C;
+  int Made = 0;
+  EXPECT_EQ(C.insertWith(1, [&Made]() { return ++Made; }), 1);
+  // the value of a key that is already cached is not constructed again
+  EXPECT_EQ(C.insertWith(1, [&Made]() { return ++Made; }), 1);
+  EXPECT_EQ(Made, 1);
+}
+
+TEST(ShardedLRUCacheTest, HandleSetKeys) {
+  ShardedLRUCache<std::tuple<int, std::set<int>>, int> C;
+  C.insert(std::make_tuple(1, std::set<int>{1, 2}), 1);
+  C.insert(std::make_tuple(1, std::set<int>{1}), 2);
+  EXPECT_EQ(*C.lookup(std::make_tuple(1, std::set<int>{2, 1})), 1);
+  EXPECT_EQ(*C.lookup(std::make_tuple(1, std::set<int>{1})), 2);
+  EXPECT_FALSE(C.lookup(std::make_tuple(1, std::set<int>{})));
+}
+
+TEST(ShardedLRUCacheTest, HandleEviction) {
+  ShardedLRUCache<int, int> C(1, 2);
+  C.insert(1, 1);
+  C.insert(2, 2);
+  // make 1 the most recently used entry, such that 2 is evicted
+  EXPECT_TRUE(C.lookup(1));
+  C.insert(3, 3);
+  EXPECT_EQ(C.size(), 2u);
+  EXPECT_TRUE(C.contains(1));
+  EXPECT_FALSE(C.contains(2));
+  EXPECT_TRUE(C.contains(3));
+}
+
+TEST(ShardedLRUCacheTest, HandleConcurrentAccess) {
+  ShardedLRUCache<int, int> C(8);
+  std::vector<std::thread> Threads;
+  for (int t = 0; t < 4; ++t) {
+    Threads.emplace_back([&C, t] {
+      for (int i = 0; i < 1000; ++i) {
+        if (!C.lookup(i)) {
+          // all threads must agree on the value that has been cached first
+          int v = C.insert(i, t);
+          EXPECT_EQ(*C.lookup(i), v);
+        }
+      }
+    });
+  }
+  for (auto &T : Threads) {
+    T.join();
+  }
+  EXPECT_EQ(C.size(), 1000u);
+  EXPECT_EQ(C.getNumShards(), 8u);
+}
+
+// main function for the test case
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
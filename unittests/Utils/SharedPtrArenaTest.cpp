@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <phasar/Utils/SharedPtrArena.h>
+#include <thread>
+#include <vector>
+
+using namespace psr;
+
+TEST(SharedPtrArenaTest, HandleAdopt) {
+  SharedPtrArena<int> A;
+  auto P = std::make_shared<int>(42);
+  auto H1 = A.adopt(P);
+  auto H2 = A.adopt(P);
+  EXPECT_EQ(*H1, 42);
+  // handles to the same object compare equal
+  EXPECT_EQ(H1, H2);
+  EXPECT_EQ(H1.shared(), P);
+  EXPECT_NE(H1, A.adopt(std::make_shared<int>(42)));
+  // an object that is adopted again is stored once
+  EXPECT_EQ(&H1.shared(), &H2.shared());
+  EXPECT_EQ(A.size(), 2u);
+  // null pointers are not stored
+  auto N = A.adopt(nullptr);
+  EXPECT_FALSE(N);
+  EXPECT_FALSE(ArenaHandle<int>());
+  EXPECT_EQ(A.size(), 2u);
+}
+
+TEST(SharedPtrArenaTest, HandleBulkRelease) {
+  SharedPtrArena<int> A;
+  std::weak_ptr<int> W;
+  {
+    auto P = std::make_shared<int>(1);
+    W = P;
+    A.adopt(P);
+  }
+  // more objects than fit into a single chunk
+  for (int i = 0; i < 10000; ++i) {
+    A.adopt(std::make_shared<int>(i));
+  }
+  EXPECT_FALSE(W.expired());
+  A.clear();
+  EXPECT_TRUE(W.expired());
+  EXPECT_EQ(A.size(), 0u);
+}
+
+TEST(SharedPtrArenaTest, HandleConcurrentAdopt) {
+  SharedPtrArena<int> A(true, 16);
+  std::vector<std::thread> Threads;
+  std::vector<std::vector<ArenaHandle<int>>> Handles(4);
+  for (int t = 0; t < 4; ++t) {
+    Threads.emplace_back([&, t]() {
+      for (int i = 0; i < 5000; ++i) {
+        Handles[t].push_back(A.adopt(std::make_shared<int>(i)));
+      }
+    });
+  }
+  for (auto &T : Threads) {
+    T.join();
+  }
+  EXPECT_EQ(A.size(), 20000u);
+  for (auto &HS : Handles) {
+    for (int i = 0; i < 5000; ++i) {
+      EXPECT_EQ(*HS[i], i);
+    }
+  }
+}
+
+TEST(SharedPtrArenaTest, HandleConcurrentReadopt) {
+  SharedPtrArena<int> A(true, 16);
+  std::vector<std::shared_ptr<int>> Objects;
+  for (int i = 0; i < 1000; ++i) {
+    Objects.push_back(std::make_shared<int>(i));
+  }
+  std::vector<std::thread> Threads;
+  std::vector<std::vector<ArenaHandle<int>>> Handles(4);
+  for (int t = 0; t < 4; ++t) {
+    Threads.emplace_back([&, t]() {
+      for (const auto &O : Objects) {
+        Handles[t].push_back(A.adopt(O));
+      }
+    });
+  }
+  for (auto &T : Threads) {
+    T.join();
+  }
+  // every object occupies a single slot, whichever thread adopted it first
+  EXPECT_EQ(A.size(), 1000u);
+  for (int t = 1; t < 4; ++t) {
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_EQ(&Handles[t][i].shared(), &Handles[0][i].shared());
+    }
+  }
+}
+
+// main function for the test case
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
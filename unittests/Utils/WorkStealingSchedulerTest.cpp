@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <phasar/Utils/WorkStealingScheduler.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+
+using namespace psr;
+
+TEST(WorkStealingSchedulerTest, HandleItemsPushedByTasks) {
+  // every item n > 0 spawns the items 2n and 2n+1 up to a bound, which
+  // results in a binary tree of work items
+  const unsigned Bound = 1 << 14;
+  std::atomic<unsigned> Processed(0);
+  std::mutex Mtx;
+  std::set<unsigned> Seen;
+  WorkStealingScheduler<unsigned> *SchedulerPtr = nullptr;
+  WorkStealingScheduler<unsigned> Scheduler(4, [&](unsigned N) {
+    ++Processed;
+    {
+      std::lock_guard<std::mutex> Lock(Mtx);
+      Seen.insert(N);
+    }
+    if (2 * N < Bound) {
+      SchedulerPtr->push(2 * N);
+      SchedulerPtr->push(2 * N + 1);
+    }
+  });
+  SchedulerPtr = &Scheduler;
+  Scheduler.push(1);
+  Scheduler.run();
+  EXPECT_EQ(Processed, Bound - 1);
+  EXPECT_EQ(Seen.size(), Bound - 1);
+  EXPECT_EQ(*Seen.begin(), 1);
+  EXPECT_EQ(*Seen.rbegin(), Bound - 1);
+}
+
+TEST(WorkStealingSchedulerTest, HandleSingleThread) {
+  unsigned Sum = 0;
+  WorkStealingScheduler<unsigned> Scheduler(1, [&](unsigned N) { Sum += N; });
+  for (unsigned I = 1; I <= 100; ++I) {
+    Scheduler.push(I);
+  }
+  Scheduler.run();
+  EXPECT_EQ(Sum, 5050);
+  // the scheduler can be reused after it has run out of work
+  Scheduler.push(1);
+  Scheduler.run();
+  EXPECT_EQ(Sum, 5051);
+}
+
+TEST(WorkStealingSchedulerTest, HandleThrowingTask) {
+  WorkStealingScheduler<unsigned> Scheduler(3, [](unsigned N) {
+    if (N == 42) {
+      throw std::runtime_error("task failed");
+    }
+  });
+  for (unsigned I = 0; I < 100; ++I) {
+    Scheduler.push(I);
+  }
+  EXPECT_THROW(Scheduler.run(), std::runtime_error);
+}
+
+// main function for the test case
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}